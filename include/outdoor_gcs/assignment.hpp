@@ -0,0 +1,43 @@
+/**
+ * @file /include/outdoor_gcs/assignment.hpp
+ *
+ * @brief Optimal assignment of interchangeable uavs to formation goals.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_ASSIGNMENT_HPP_
+#define outdoor_gcs_ASSIGNMENT_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Functions
+*****************************************************************************/
+
+	/**
+	 * Both take a row-major n x n cost matrix (cost[r*n+c]: uav r to goal c)
+	 * and return the goal of every uav.
+	 */
+
+	// Hungarian algorithm, minimum total cost, O(n^3)
+	std::vector<int> Assign_Min_Sum(const std::vector<double> &cost, int n);
+	// Minimum largest cost (bottleneck), ties broken by minimum total cost
+	std::vector<int> Assign_Min_Max(const std::vector<double> &cost, int n);
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_ASSIGNMENT_HPP_ */
@@ -0,0 +1,143 @@
+/**
+ * @file /include/outdoor_gcs/binlog.hpp
+ *
+ * @brief Binary diagnostics log: call sites copy their raw arguments into a
+ * lock-free queue of their thread, a writer thread drains every queue into
+ * the file, and log_decode formats the entries afterwards.
+ *
+ *   GCS_LOG(Log_Info, "plan tick: %d uavs, %.0f us", hosts, time_us);
+ *
+ * A call site registers its format once; an entry then costs a clock read
+ * and a copy of the arguments, and nothing when no log is open. When the
+ * queue of a thread is full, its entries are dropped (and counted) rather
+ * than waiting for the writer.
+ *
+ * File: "OGCSBLOG", uint32 version, then records, each starting with a
+ * uint8 type (little endian, packed):
+ *   Log_Format_Record: uint16 id, uint8 level, uint16 line, uint16 n, file, uint16 n, format
+ *   Log_Entry_Record:  uint16 id, uint16 thread, int64 time [ns since epoch], uint16 n, arguments
+ * and every argument is a uint8 Log_Arg tag followed by its value (int64,
+ * uint64, double, or uint16 n and the characters).
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_BINLOG_HPP_
+#define outdoor_gcs_BINLOG_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	enum Log_Level
+	{
+		Log_Debug,
+		Log_Info,
+		Log_Warn,
+		Log_Error,
+	};
+
+	enum Log_Arg
+	{
+		Log_Int = 1,
+		Log_Uint,
+		Log_Double,
+		Log_String,
+	};
+
+	const char Log_Magic[8] = {'O', 'G', 'C', 'S', 'B', 'L', 'O', 'G'};
+	const uint32_t Log_Version = 1;
+	const uint8_t Log_Format_Record = 1;
+	const uint8_t Log_Entry_Record = 2;
+
+class BinLog {
+public:
+	static const size_t Entry_Header = 15; // type, id, thread, time, n
+	static const size_t Max_Entry = 256;
+	static const size_t Max_Payload = Max_Entry - Entry_Header; // longer arguments are cut
+
+	static bool Open(const std::string &path, std::string &error);
+	static void Close(); // drains every queue first
+	static bool Enabled() { return enabled.load(std::memory_order_relaxed); }
+	static uint64_t Dropped(); // entries lost to full queues
+
+	static uint16_t Register(Log_Level level, const char *file, int line, const char *format);
+	static const char *Format_Of(const char *format) { return format; }
+	template <class... Args>
+	static const char *Format_Of(const char *format, const Args &...) { return format; }
+
+	template <class... Args>
+	static void Write(uint16_t id, const char *, const Args &... args){
+		char payload[Max_Payload];
+		size_t n = 0;
+		encode(payload, n, args...);
+		push(id, payload, n);
+	}
+
+private:
+	static void push(uint16_t id, const char *payload, size_t n);
+
+	static void encode(char *, size_t &) {}
+	template <class T, class... Rest>
+	static void encode(char *out, size_t &n, const T &value, const Rest &... rest){
+		put(out, n, value);
+		encode(out, n, rest...);
+	}
+
+	template <class T>
+	static void put_raw(char *out, size_t &n, uint8_t tag, const T &value){
+		if (n + 1 + sizeof(T) > Max_Payload){ return; }
+		out[n++] = tag;
+		std::memcpy(out + n, &value, sizeof(T));
+		n += sizeof(T);
+	}
+	template <class T>
+	static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+	put(char *out, size_t &n, const T &value){ put_raw(out, n, Log_Int, int64_t(value)); }
+	template <class T>
+	static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+	put(char *out, size_t &n, const T &value){ put_raw(out, n, Log_Uint, uint64_t(value)); }
+	template <class T>
+	static typename std::enable_if<std::is_enum<T>::value>::type
+	put(char *out, size_t &n, const T &value){ put_raw(out, n, Log_Int, int64_t(value)); }
+	template <class T>
+	static typename std::enable_if<std::is_floating_point<T>::value>::type
+	put(char *out, size_t &n, const T &value){ put_raw(out, n, Log_Double, double(value)); }
+	static void put(char *out, size_t &n, const char *value){ put_string(out, n, value, std::strlen(value)); }
+	static void put(char *out, size_t &n, const std::string &value){ put_string(out, n, value.data(), value.size()); }
+	static void put_string(char *out, size_t &n, const char *value, size_t length);
+
+	static std::atomic<bool> enabled;
+};
+
+}  // namespace outdoor_gcs
+
+#define GCS_LOG(level, ...) \
+	do { \
+		if (outdoor_gcs::BinLog::Enabled()){ \
+			static const uint16_t gcs_log_id = outdoor_gcs::BinLog::Register(outdoor_gcs::level, __FILE__, __LINE__, \
+					outdoor_gcs::BinLog::Format_Of(__VA_ARGS__)); \
+			outdoor_gcs::BinLog::Write(gcs_log_id, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#endif /* outdoor_gcs_BINLOG_HPP_ */
@@ -0,0 +1,70 @@
+/**
+ * @file /include/outdoor_gcs/cbs_planner.hpp
+ *
+ * @brief Conflict-based search over an occupancy grid: collision-free,
+ * mutually conflict-free paths for the whole fleet.
+ *
+ * Time is discrete, one step is one move to a face neighbour (or a wait).
+ * Two uavs conflict when they share a cell at a step (vertex) or swap
+ * cells between two steps (edge). Paths hold one cell per step; a uav
+ * stays on its goal after its path ends.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_CBS_PLANNER_HPP_
+#define outdoor_gcs_CBS_PLANNER_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+#include "occupancy_grid.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	typedef std::array<int,3> grid_cell;
+
+	struct cbs_stat
+	{
+		bool solved = false;
+		int agents = 0;
+		int nodes = 0; // constraint tree nodes expanded
+		int makespan = 0; // steps of the longest path
+		int cost = 0; // sum of path lengths
+		double time_ms = 0;
+		std::string error;
+		int agent = -1; // the start / goal the error is about
+	};
+
+class CbsPlanner {
+public:
+	// budget: wall time [s] before giving up, suboptimality: bound on the sum of path lengths (1 is optimal)
+	CbsPlanner(const OccupancyGrid &grid, double budget, double suboptimality = 1.0);
+
+	bool Plan(const std::vector<grid_cell> &start, const std::vector<grid_cell> &goal,
+			std::vector<std::vector<grid_cell> > &paths, cbs_stat &stat) const;
+
+private:
+	const OccupancyGrid &grid;
+	double budget;
+	double suboptimality;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_CBS_PLANNER_HPP_ */
@@ -0,0 +1,100 @@
+/**
+ * @file /include/outdoor_gcs/clock_sync.hpp
+ *
+ * @brief Offset and drift between the clock of each vehicle and the GCS,
+ * to bring vehicle header stamps into GCS time.
+ *
+ * Two kinds of samples, kept as the best one of every second over a window:
+ *  - exchange: NTP-style request / response timestamps (t0, t3 on the GCS,
+ *    t1, t2 on the vehicle); the sample with the shortest round trip of a
+ *    second is the most accurate, and the offset is exact for a symmetric
+ *    link;
+ *  - passive: a vehicle stamp and the GCS time it arrived; the lowest
+ *    arrival - stamp approaches the offset plus the smallest one-way
+ *    latency, which this estimate keeps as a bias.
+ * Exchange samples are used while there are any in the window. With ten
+ * seconds of samples, a line through the best ones also gives the drift.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_CLOCK_SYNC_HPP_
+#define outdoor_gcs_CLOCK_SYNC_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	enum Clock_Source
+	{
+		Clock_None, // no samples, stamps are taken as they are
+		Clock_Passive,
+		Clock_Exchange,
+	};
+
+	struct clock_estimate
+	{
+		Clock_Source source = Clock_None;
+		double offset = 0; // [s] GCS - vehicle at t_ref
+		double drift = 0; // [s/s] of the offset
+		double t_ref = 0; // [s] GCS time
+		double delay = -1; // [s] round trip (exchange) of the best sample, -1 for passive
+		int samples = 0; // seconds with a sample in the window
+	};
+
+class ClockSync {
+public:
+	explicit ClockSync(int uavs = 9);
+
+	void Configure(double window); // [s] of samples kept
+
+	// All times in [s]; t0, t3, received on the GCS clock
+	void Add_Exchange(int uav, double t0, double t1, double t2, double t3);
+	void Add_Passive(int uav, double stamp, double received);
+
+	double To_GCS(int uav, double stamp) const; // vehicle stamp to GCS time
+	clock_estimate Estimate(int uav) const;
+
+private:
+	struct clock_sample
+	{
+		double t; // [s] GCS time
+		double offset; // [s] GCS - vehicle, upper bound for passive ones
+		double delay; // [s] ranks the samples of one second, lowest wins
+	};
+
+	struct lane
+	{
+		mutable std::mutex mutex;
+		std::deque<clock_sample> exchange, passive; // best of each second
+		clock_estimate estimate;
+	};
+
+	void add(lane &l, std::deque<clock_sample> &bins, const clock_sample &s);
+	static clock_estimate fit(const std::deque<clock_sample> &bins, Clock_Source source);
+
+	double window = 60;
+	std::vector<std::unique_ptr<lane> > lanes;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_CLOCK_SYNC_HPP_ */
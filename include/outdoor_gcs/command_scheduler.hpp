@@ -0,0 +1,126 @@
+/**
+ * @file /include/outdoor_gcs/command_scheduler.hpp
+ *
+ * @brief Releases fleet commands at absolute times, from a hierarchical
+ * timer wheel with 1 ms ticks.
+ *
+ * The wheel has four levels (256 ms, 16 s, 17 min and 18 h of range), so
+ * scheduling and releasing cost O(1) whatever the number of pending
+ * commands. Every command belongs to a lane (one per uav): the wheel thread
+ * only hands it to the lane thread, which runs it, so a blocking service
+ * call of one uav never delays the release of another.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_COMMAND_SCHEDULER_HPP_
+#define outdoor_gcs_COMMAND_SCHEDULER_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "latency_histogram.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct sched_record
+	{
+		uint64_t id;
+		std::string label;
+		int lane;
+		double at; // [s] scheduled wall time
+		float skew_ms; // started - scheduled
+		float run_ms; // time the action took (service call)
+	};
+
+class CommandScheduler {
+public:
+	typedef std::function<void()> action;
+
+	explicit CommandScheduler(int lanes);
+	~CommandScheduler();
+
+	// Runs f on its lane at wall time at [s since epoch] (now if past); returns an id for Cancel
+	uint64_t Schedule(double at, int lane, const std::string &label, const action &f);
+	bool Cancel(uint64_t id);
+	int Cancel_All();
+	int Pending();
+
+	static double Wall_Now(); // [s] system clock, same as ros::WallTime
+	const LatencyHistogram &Skew() const { return skew; } // |started - scheduled|
+	std::vector<sched_record> Recent(); // last releases, oldest first
+
+private:
+	typedef std::chrono::steady_clock clock_type;
+
+	struct entry
+	{
+		uint64_t id;
+		int64_t tick;
+		int lane;
+		double at;
+		std::string label;
+		action f;
+	};
+
+	struct lane_worker
+	{
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::deque<entry> queue;
+		bool stop = false;
+	};
+
+	void wheel_loop();
+	void lane_loop(lane_worker &lane);
+	void run(entry &e); // hands e to its lane
+	void execute(entry &e);
+	void insert(entry &e);
+	void cascade(std::vector<entry> &slot);
+	void advance();
+	int64_t ticks_now() const;
+
+	static const int Levels = 4;
+	std::vector<std::vector<entry> > wheel[Levels]; // 256, 64, 64, 64 slots
+	std::vector<entry> overflow; // beyond the last level
+	int64_t now_tick = 0; // next tick to release
+	int pending = 0;
+	uint64_t next_id = 1;
+	bool stop = false;
+	clock_type::time_point epoch;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::thread wheel_thread;
+	std::vector<std::unique_ptr<lane_worker> > lanes;
+
+	LatencyHistogram skew;
+	std::mutex recent_mutex;
+	std::deque<sched_record> recent;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_COMMAND_SCHEDULER_HPP_ */
@@ -0,0 +1,93 @@
+/**
+ * @file /include/outdoor_gcs/command_tracer.hpp
+ *
+ * @brief Command to execution latency of every uav, from the Command_ID the
+ * vehicle echoes in its Topic_for_log.
+ *
+ * Sent() remembers the publish time of each command. The first echo of an
+ * id closes it: its latency goes to the histogram of the uav, and the
+ * older commands still open were superseded (the vehicle logs slower than
+ * commands may be streamed). A command left open for the timeout with no
+ * newer one echoed was dropped. Both times are GCS wall clock, so the
+ * latency is publish to echo received, free of the vehicle clock.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_COMMAND_TRACER_HPP_
+#define outdoor_gcs_COMMAND_TRACER_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "latency_histogram.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct trace_stat
+	{
+		uint64_t sent = 0;
+		uint64_t executed = 0; // echoed by the vehicle
+		uint64_t superseded = 0; // a newer command was echoed first
+		uint64_t dropped = 0; // not echoed within the timeout, or beyond the window
+		uint64_t out_of_order = 0; // echo older than one already seen
+		uint64_t unmatched = 0; // echo of an id not waiting: sent by someone else, or already dropped
+		float last_ms = -1; // latency of the last executed command
+	};
+
+class CommandTracer {
+public:
+	static const size_t Window = 512; // open commands kept per uav
+
+	explicit CommandTracer(int uavs = 9);
+
+	void Configure(double timeout); // [s] before an open command counts as dropped
+	void Sent(int uav, uint32_t id, double now); // [s] wall time, any thread
+	void Echoed(int uav, uint32_t id, double now);
+	int Check(double now); // commands dropped by now, across all uavs
+
+	trace_stat Stat(int uav);
+	const LatencyHistogram &Latency(int uav) const { return lanes[uav]->latency; }
+
+private:
+	struct sent_entry
+	{
+		uint32_t id;
+		double time;
+	};
+
+	struct lane
+	{
+		std::mutex mutex;
+		std::deque<sent_entry> open; // in id order
+		bool echoed = false;
+		uint32_t last_echo = 0;
+		uint32_t last_unmatched = 0; // counted once while it repeats
+		trace_stat stat;
+		LatencyHistogram latency;
+	};
+
+	double timeout = 1.0;
+	std::vector<std::unique_ptr<lane> > lanes;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_COMMAND_TRACER_HPP_ */
@@ -0,0 +1,96 @@
+/**
+ * @file /include/outdoor_gcs/control_server.hpp
+ *
+ * @brief Local control and telemetry socket of the GCS backend.
+ *
+ * A Unix stream socket taking one command per line from any number of
+ * clients. The server thread only accepts connections and splits lines; the
+ * owner takes the requests on its own thread (the ros loop), so commands
+ * never race the planner, and answers with Reply(). Clients that asked to
+ * watch get every frame passed to Publish(). Every reply and frame ends
+ * with a line holding a single '.'.
+ *
+ * Writes never block the loop: a client that does not read its socket is
+ * disconnected once the kernel buffer is full.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_CONTROL_SERVER_HPP_
+#define outdoor_gcs_CONTROL_SERVER_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct control_request
+	{
+		int client; // for Reply and Watch
+		std::string line;
+	};
+
+class ControlServer {
+public:
+	ControlServer() {}
+	~ControlServer(); // disconnects every client and removes the socket file
+
+	// Replaces a stale socket file at path; false if another process is listening there
+	bool Open(const std::string &path, std::string &error);
+	static bool Listening(const std::string &path); // a server accepts connections at path
+	bool Opened() const { return listen_fd >= 0; }
+
+	std::vector<control_request> Take(); // lines received since the last call
+	void Reply(int client, const std::string &text); // text without the final '.' line
+	void Watch(int client, bool on);
+	void Publish(const std::string &frame); // to the watching clients
+	int Clients();
+	int Watchers();
+
+private:
+	struct client
+	{
+		int fd;
+		std::string in; // partial line
+		bool watch = false;
+	};
+
+	void serve_loop();
+	void send_to(int id, client &c, const std::string &text);
+	void drop(int id);
+
+	std::string path;
+	int listen_fd = -1;
+	int wake_pipe[2] = {-1, -1}; // wakes poll() on shutdown
+	std::thread server;
+	std::atomic<bool> stop{false};
+
+	std::mutex mutex;
+	std::map<int, client> clients; // by id, not fd, so that a reply never reaches a later client on the same fd
+	int next_id = 1;
+	std::deque<control_request> requests;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_CONTROL_SERVER_HPP_ */
@@ -0,0 +1,88 @@
+/**
+ * @file /include/outdoor_gcs/distance_field.hpp
+ *
+ * @brief Signed Euclidean distance field of the occupancy grid, with
+ * gradients, for obstacle terms in the reactive planners.
+ *
+ * Built once from the map; a lookup is one cell read. Cells are stored in
+ * 8x8x8 blocks (4 KiB each) so neighbouring uavs and consecutive ticks hit
+ * the same cache lines and pages.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_DISTANCE_FIELD_HPP_
+#define outdoor_gcs_DISTANCE_FIELD_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "occupancy_grid.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+class DistanceField {
+public:
+	// Exact EDT of the occupied cells and of the free cells (Felzenszwalb), false without obstacles
+	bool Build(const OccupancyGrid &grid);
+	bool Built() const { return !cells.empty(); }
+	size_t Bytes() const { return cells.size()*sizeof(cell); }
+
+	/**
+	 * Distance [m] from pos to the nearest obstacle surface, negative inside
+	 * an obstacle, and the unit gradient (pointing away from the obstacle)
+	 * at the cell of pos. False outside the map.
+	 */
+	bool Sample(const float pos[3], float &dist, float grad[3]) const {
+		int c[3];
+		for (int i = 0; i < 3; i++) {
+			c[i] = int(std::floor((pos[i] - origin[i])/resolution));
+		}
+		if (c[0] < 0 || c[1] < 0 || c[2] < 0 || c[0] >= nx || c[1] >= ny || c[2] >= nz){ return false; }
+		const cell &s = cells[Offset(c[0], c[1], c[2])];
+		dist = s.dist;
+		for (int i = 0; i < 3; i++) {
+			grad[i] = s.grad[i]*(1.0f/127);
+		}
+		return true;
+	}
+
+private:
+	struct cell
+	{
+		float dist;
+		int8_t grad[3]; // unit gradient * 127
+		uint8_t pad;
+	};
+
+	size_t Offset(int x, int y, int z) const {
+		size_t block = (size_t(z >> 3)*by + (y >> 3))*bx + (x >> 3);
+		return (block << 9) | ((z & 7) << 6) | ((y & 7) << 3) | (x & 7);
+	}
+
+	std::vector<cell> cells;
+	int nx = 0, ny = 0, nz = 0;
+	int bx = 0, by = 0; // blocks along x and y
+	float resolution = 1.0;
+	float origin[3] = {0, 0, 0};
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_DISTANCE_FIELD_HPP_ */
@@ -0,0 +1,106 @@
+/**
+ * @file /include/outdoor_gcs/event_log.hpp
+ *
+ * @brief Operator event log: the latest events in a fixed-size ring, older
+ * ones streamed to an append-only file.
+ *
+ * Append() only copies the event into the ring; the event it evicts goes to
+ * a writer thread, so the caller never waits on the disk and the memory of
+ * the log stays the same however long the session.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_EVENT_LOG_HPP_
+#define outdoor_gcs_EVENT_LOG_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	enum Event_Severity
+	{
+		Event_Info,
+		Event_Command, // command sent to the fleet
+		Event_Warning,
+		Event_Error,
+	};
+
+	enum Event_Code
+	{
+		Event_General = 0,
+		Event_Separation = 10,
+		Event_Geofence = 11,
+		Event_Mission = 20,
+		Event_Preflight = 21,
+	};
+
+	struct event_entry
+	{
+		uint64_t seq; // from 0, over the whole session
+		double time; // [s] wall time
+		int uav; // -1 for the fleet or none
+		Event_Severity severity;
+		int code; // Event_Code
+		std::string text;
+	};
+
+class EventLog {
+public:
+	explicit EventLog(size_t capacity = 5000);
+	~EventLog(); // writes what is still in the ring to the file
+
+	// Append-only file for the events that leave the ring; without one they are dropped
+	bool Open_Spill(const std::string &path, std::string &error);
+
+	uint64_t Append(int uav, Event_Severity severity, int code, const std::string &text);
+	uint64_t First(); // seq of the oldest event held
+	uint64_t End(); // seq of the next event
+	bool Get(uint64_t seq, event_entry &entry); // false once evicted
+	uint64_t Spilled(); // events written to the file
+	uint64_t Dropped(); // events evicted without a file, or with the writer too far behind
+
+	static std::string Format(const event_entry &entry); // one line of the file
+
+private:
+	void writer_loop();
+
+	std::mutex mutex;
+	std::vector<event_entry> ring;
+	uint64_t end = 0;
+	uint64_t dropped = 0;
+
+	// Writer thread
+	std::FILE *file = nullptr;
+	std::thread writer;
+	std::condition_variable wake;
+	std::deque<event_entry> spill; // evicted, not written yet
+	uint64_t spilled = 0;
+	bool stop = false;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_EVENT_LOG_HPP_ */
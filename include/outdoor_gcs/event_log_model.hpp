@@ -0,0 +1,52 @@
+/**
+ * @file /include/outdoor_gcs/event_log_model.hpp
+ *
+ * @brief List model over the EventLog ring for the notice logger view.
+ *
+ * The view only asks for the rows it shows, so a long session costs no
+ * more than the ring itself.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_EVENT_LOG_MODEL_HPP_
+#define outdoor_gcs_EVENT_LOG_MODEL_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <QAbstractListModel>
+#include "event_log.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+class EventLogModel : public QAbstractListModel {
+public:
+	explicit EventLogModel(EventLog &log, QObject *parent = 0);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+	// Rows for the events appended since the last call, minus the evicted ones; GUI thread only
+	bool Sync();
+
+private:
+	EventLog &log;
+	uint64_t first = 0, end = 0; // seq of the first row, one past the last
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_EVENT_LOG_MODEL_HPP_ */
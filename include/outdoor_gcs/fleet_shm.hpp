@@ -0,0 +1,121 @@
+/**
+ * @file /include/outdoor_gcs/fleet_shm.hpp
+ *
+ * @brief Fleet state in POSIX shared memory, for processes on the GCS
+ * machine that would otherwise subscribe to every uav themselves.
+ *
+ * The GCS writes one frame per tick under a seqlock: the sequence is odd
+ * while the frame is written, so a reader copies the frame and keeps the
+ * copy only if the sequence was even and unchanged around it. Readers
+ * never block the writer and need no ROS. Fields are in SoA order (all x,
+ * then all y, ...) with room for Fleet_Shm_Capacity uavs; slot k holds the
+ * k-th available uav, id[k] tells which one.
+ *
+ * Any change of fleet_frame bumps Fleet_Shm_Version; readers check it and
+ * the size before trusting the layout.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_FLEET_SHM_HPP_
+#define outdoor_gcs_FLEET_SHM_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	const uint32_t Fleet_Shm_Magic = 0x4d53474f; // "OGSM"
+	const uint32_t Fleet_Shm_Version = 1;
+	const int Fleet_Shm_Capacity = 16;
+
+	enum Fleet_Health
+	{
+		Health_Connected = 1 << 0, // mavros state connected
+		Health_Armed = 1 << 1,
+		Health_Moving = 1 << 2, // planned and commanded by the GCS
+		Health_Arrived = 1 << 3,
+		Health_Ready = 1 << 4, // pre-flight checks pass
+		Health_Separation = 1 << 5, // in a separation alert
+		Health_Fresh = 1 << 6, // odometry within the pre-flight age limit
+	};
+
+	struct fleet_frame
+	{
+		uint64_t tick; // GCS loop count
+		int64_t stamp; // [ns] ros time of the frame
+		uint32_t count; // slots in use
+		uint32_t reserved;
+		int32_t id[Fleet_Shm_Capacity]; // uav index, from 0 (uavN is N-1)
+		uint32_t health[Fleet_Shm_Capacity]; // Fleet_Health bits
+		float age[Fleet_Shm_Capacity]; // [s] since the last odometry, -1 if none yet
+		float pos[3][Fleet_Shm_Capacity]; // [m] local ENU
+		float vel[3][Fleet_Shm_Capacity]; // [m/s]
+		float des[3][Fleet_Shm_Capacity]; // [m] desired position
+		float nxt[3][Fleet_Shm_Capacity]; // [m] next planned position
+		char mode[Fleet_Shm_Capacity][16]; // flight mode, null terminated
+	};
+
+	struct fleet_shm_layout
+	{
+		std::atomic<uint32_t> magic; // written last, once the header is valid
+		uint32_t version;
+		uint32_t size; // of the whole layout
+		uint32_t capacity;
+		std::atomic<uint32_t> seq; // odd while the frame is written
+		uint32_t reserved;
+		fleet_frame frame;
+	};
+
+class FleetShmWriter {
+public:
+	FleetShmWriter() {}
+	~FleetShmWriter(); // unlinks the segment, mapped readers keep their view
+
+	// name as for shm_open, "/outdoor_gcs_fleet". Fails if the segment exists, unless reuse replaces it
+	bool Open(const std::string &name, bool reuse, std::string &error);
+	bool Opened() const { return shm != nullptr; }
+
+	// Fill the frame between the two; readers retry meanwhile
+	fleet_frame &Begin();
+	void End();
+
+private:
+	std::string name;
+	fleet_shm_layout *shm = nullptr;
+};
+
+class FleetShmReader {
+public:
+	FleetShmReader() {}
+	~FleetShmReader();
+
+	bool Open(const std::string &name, std::string &error);
+
+	// A consistent copy of the latest frame; false if the writer kept it busy for all tries
+	bool Read(fleet_frame &out, int tries = 1000) const;
+	uint32_t Sequence() const; // changes with every frame, for polling without a copy
+
+private:
+	const fleet_shm_layout *shm = nullptr;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_FLEET_SHM_HPP_ */
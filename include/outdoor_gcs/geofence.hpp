@@ -0,0 +1,113 @@
+/**
+ * @file /include/outdoor_gcs/geofence.hpp
+ *
+ * @brief Geofence of inclusion / exclusion polygons with altitude bands,
+ * checked on every outgoing position command.
+ *
+ * A point is inside the fence when it is within the altitude band, inside
+ * one inclusion polygon (any point if there is none) and outside every
+ * exclusion polygon, each polygon counting only within its own band.
+ *
+ * The polygon edges are bucketed on a uniform grid, and every grid cell
+ * knows which polygons hold its center. A query walks from the center of
+ * its cell to the point and only tests the edges of that cell, so it costs
+ * the same whatever the size of the polygons.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_GEOFENCE_HPP_
+#define outdoor_gcs_GEOFENCE_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	enum Fence_Result
+	{
+		Fence_Inside,
+		Fence_Clamped,
+		Fence_Rejected,
+	};
+
+class Geofence {
+public:
+	static const int Max_Polygons = 64; // one bit each in a query's inside mask
+
+	/**
+	 * Text file, local ENU metres, '#' starts a comment:
+	 *
+	 *   altitude <min> <max>
+	 *   include [<min z> <max z>]
+	 *   <x> <y>
+	 *   ...
+	 *   end
+	 *   exclude [<min z> <max z>]
+	 *   ...
+	 *   end
+	 */
+	bool Load(const std::string &path, std::string &error); // at most Max_Polygons polygons
+	bool Loaded() const { return loaded; }
+	int Polygons() const { return polygons.size(); }
+
+	bool Contains(const float p[3]) const;
+	/**
+	 * Inside: target is left alone. Otherwise clamp pulls target back along
+	 * the segment from `from` to just before it first leaves the fence (not
+	 * past a no-fly zone on the way); without clamp, or when `from` is
+	 * outside too, the command is rejected.
+	 */
+	Fence_Result Check(const float from[3], float target[3], bool clamp) const;
+
+private:
+	struct polygon
+	{
+		bool include;
+		float z_min, z_max;
+		std::vector<float> x, y;
+	};
+
+	struct edge
+	{
+		int poly;
+		float x0, y0, x1, y1;
+	};
+
+	struct cell
+	{
+		std::vector<edge> edges;
+		uint64_t center_inside = 0; // bit per polygon
+	};
+
+	void build_grid();
+	bool inside_polygons(float x, float y, uint64_t &inside) const;
+
+	bool loaded = false;
+	float z_min = -1e9, z_max = 1e9;
+	std::vector<polygon> polygons;
+	bool any_include = false;
+	int gx = 0, gy = 0;
+	float x0 = 0, y0 = 0, cell_w = 1, cell_h = 1;
+	std::vector<cell> grid;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_GEOFENCE_HPP_ */
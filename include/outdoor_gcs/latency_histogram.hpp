@@ -0,0 +1,65 @@
+/**
+ * @file /include/outdoor_gcs/latency_histogram.hpp
+ *
+ * @brief Log-bucketed latency histogram.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_LATENCY_HISTOGRAM_HPP_
+#define outdoor_gcs_LATENCY_HISTOGRAM_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+/**
+ * @brief Counts latencies in buckets a quarter octave wide, from 1 us to
+ * about 70 s; the relative error of any percentile is below 19%.
+ *
+ * Add() may run in one thread while the getters run in another.
+ */
+class LatencyHistogram {
+public:
+	static const int Buckets = 105;
+
+	LatencyHistogram();
+
+	void Add(double seconds);
+	void Reset();
+
+	uint64_t Count() const;
+	uint64_t Count_Below(double seconds) const; // samples in the buckets that end at or below seconds
+	double Mean() const; // [s]
+	double Max() const; // [s]
+	double Percentile(double p) const; // [s] upper edge of the bucket holding the p-th percentile, p in [0, 1]
+	static double Upper_Edge(int bucket); // [s]
+
+private:
+	static int bucket_of(double seconds);
+
+	std::atomic<uint64_t> counts[Buckets];
+	std::atomic<uint64_t> total;
+	std::atomic<uint64_t> sum_us;
+	std::atomic<uint64_t> max_us;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_LATENCY_HISTOGRAM_HPP_ */
@@ -17,6 +17,7 @@
 #include <QKeyEvent>
 #include "ui_main_window.h"
 #include "qnode.hpp"
+#include "event_log_model.hpp"
 
 /*****************************************************************************
 ** Namespace
@@ -41,7 +42,7 @@ public:
 	void WriteSettings(); // Save qt program settings when closing
 
 	void closeEvent(QCloseEvent *event); // Overloaded function
-	void showNoMasterMessage();
+	void showInitError(); // no master, or another GCS already running
 
 	QStringList all_topics;
 
@@ -136,6 +137,7 @@ public Q_SLOTS:
 	// void updateTopics();
 	void updateuavs();
 	void updateInfoLogger();
+	void updateAvailUavs(QList<int> uavs);
 
 private:
 	Ui::MainWindowDesign ui;
@@ -166,6 +168,14 @@ private:
 	QStringList UAV_Detected;
 	QStringList UAV_Info_Logger;
 	outdoor_gcs::checkbox_status checkbox_stat;
+
+	void print_assignment(const outdoor_gcs::assign_stat &assign);
+	void print_fence_count(int ind, bool by_item);
+	// Notice logger: the events of qnode.GetEventLog(), newest last
+	outdoor_gcs::EventLogModel *notice_model;
+	bool no_uavs_noticed = false;
+	void notice(const QString &text, outdoor_gcs::Event_Severity severity, int uav = -1, int code = outdoor_gcs::Event_General);
+	bool schedule_all(const std::string &action, const QString &name); // false when fleet buttons act at once
 };
 
 }  // namespace outdoor_gcs
@@ -0,0 +1,136 @@
+/**
+ * @file /include/outdoor_gcs/metrics.hpp
+ *
+ * @brief Registry of counters, gauges and latency histograms, exported as
+ * Prometheus text on a local HTTP port and as binary snapshots in a file.
+ *
+ * Series are registered once during setup, then updated from any thread
+ * with relaxed atomics: no lock on the loop. The server thread reads them
+ * for every scrape ("GET /metrics" on 127.0.0.1) and, every period, appends
+ * a snapshot record to the file. The file starts with the series table, so
+ * a record is only the values (see metrics_dump).
+ *
+ * Snapshot file: magic, version, series count, then per series its type
+ * (uint8), name length (uint16) and name with labels; then records of the
+ * wall time (double) followed by the values of every series in table
+ * order: counter uint64, gauge double, histogram count (uint64), sum, p50,
+ * p99 and max (double, in s).
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_METRICS_HPP_
+#define outdoor_gcs_METRICS_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "latency_histogram.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	enum Metric_Type
+	{
+		Metric_Counter = 1,
+		Metric_Gauge,
+		Metric_Histogram,
+	};
+
+	const char Metrics_Magic[8] = {'O', 'G', 'C', 'S', 'M', 'E', 'T', 'R'};
+	const uint32_t Metrics_Version = 1;
+
+class MetricCounter {
+public:
+	void Add(uint64_t n = 1){ value.fetch_add(n, std::memory_order_relaxed); }
+	void Set(uint64_t v){ value.store(v, std::memory_order_relaxed); } // mirror of a count kept elsewhere
+	uint64_t Value() const { return value.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<uint64_t> value{0};
+};
+
+class MetricGauge {
+public:
+	void Set(double v){ value.store(v, std::memory_order_relaxed); }
+	double Value() const { return value.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<double> value{0};
+};
+
+class MetricsRegistry {
+public:
+	MetricsRegistry() {}
+	~MetricsRegistry(); // stops serving, closes the file
+
+	// Before Open() only. labels as in the text format without braces, e.g. uav="1",stream="odom";
+	// series of one name share the help and type of the first
+	MetricCounter *Counter(const std::string &name, const std::string &labels, const std::string &help);
+	MetricGauge *Gauge(const std::string &name, const std::string &labels, const std::string &help);
+	LatencyHistogram *Histogram(const std::string &name, const std::string &labels, const std::string &help);
+	void Histogram(const std::string &name, const std::string &labels, const std::string &help,
+			const LatencyHistogram *external); // kept and updated by its owner
+
+	// port 0 for no endpoint, empty file for no snapshots; starts the server thread if either is set
+	bool Open(int port, const std::string &snapshot_file, double period, std::string &error);
+	bool Opened() const { return server.joinable(); }
+	int Series() const { return series.size(); }
+
+	std::string Text() const; // Prometheus text exposition format 0.0.4
+
+private:
+	struct metric_series
+	{
+		std::string name, labels;
+		Metric_Type type;
+		std::unique_ptr<MetricCounter> counter;
+		std::unique_ptr<MetricGauge> gauge;
+		std::unique_ptr<LatencyHistogram> own;
+		const LatencyHistogram *histogram = nullptr;
+	};
+
+	struct metric_family
+	{
+		std::string name, help;
+		Metric_Type type;
+		std::vector<size_t> series;
+	};
+
+	metric_series &add(const std::string &name, const std::string &labels, const std::string &help, Metric_Type type);
+	void serve_loop();
+	void answer(int fd);
+	void write_snapshot(double now);
+
+	std::vector<std::unique_ptr<metric_series> > series;
+	std::vector<metric_family> families;
+
+	int listen_fd = -1;
+	int wake_pipe[2] = {-1, -1}; // wakes poll() on shutdown
+	std::FILE *file = nullptr;
+	double period = 1.0;
+	std::thread server;
+	std::atomic<bool> stop{false};
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_METRICS_HPP_ */
@@ -0,0 +1,106 @@
+/**
+ * @file /include/outdoor_gcs/mission.hpp
+ *
+ * @brief Fleet missions: a script of actions and conditions, compiled to a
+ * list of steps and advanced on every loop tick.
+ *
+ * Resume() runs the steps from the current one on until a wait or a sleep
+ * holds, then returns; the next tick picks the mission up at that step. A
+ * mission never blocks the loop, and the step after a wait runs in the tick
+ * where its condition first holds.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_MISSION_HPP_
+#define outdoor_gcs_MISSION_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	enum Mission_Op
+	{
+		Mission_Do, // action, done in the tick it is reached
+		Mission_Wait, // condition, holds the mission until it is true
+		Mission_Sleep,
+	};
+
+	struct mission_step
+	{
+		Mission_Op op;
+		std::string name; // action or condition
+		std::vector<std::string> args;
+		float seconds; // [s] sleep length, or wait timeout (0 for none)
+		std::string text; // as written
+		int line;
+	};
+
+	struct mission_status
+	{
+		bool running = false;
+		bool done = false;
+		bool failed = false;
+		int step = 0; // current one, from 0
+		int steps = 0;
+		std::string text; // of the current step
+		std::string error;
+		double elapsed = 0; // [s] since the start
+		double step_elapsed = 0; // [s] on the current step
+	};
+
+class Mission {
+public:
+	// Action: false fails the mission. Condition: true once it holds
+	typedef std::function<bool(const mission_step &)> hook;
+
+	/**
+	 * One step per line, '#' starts a comment:
+	 *
+	 *   arm | disarm | takeoff | land | rtl | loiter | posctl | offboard | move | stop [stagger <s>]
+	 *   mode <MODE>
+	 *   go init | go final (then waits for the global paths, if any)
+	 *   wait armed | disarmed | arrived | ready | mode <MODE> | altitude <m> [timeout <s>]
+	 *   sleep <s>
+	 */
+	bool Load(const std::string &path, std::string &error);
+	bool Compile(std::istream &in, const std::string &name, std::string &error);
+	bool Loaded();
+
+	void Start(double now);
+	void Abort(const std::string &reason);
+	// Runs steps from the current one until a wait or a sleep holds; false once the mission is not running
+	bool Resume(double now, const hook &act, const hook &test);
+	mission_status Status(double now);
+
+private:
+	void fail(const std::string &error);
+
+	std::mutex mutex;
+	std::vector<mission_step> steps;
+	mission_status status;
+	double start_time = 0, step_time = 0;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_MISSION_HPP_ */
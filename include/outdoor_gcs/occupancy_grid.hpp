@@ -0,0 +1,89 @@
+/**
+ * @file /include/outdoor_gcs/occupancy_grid.hpp
+ *
+ * @brief Static 3D occupancy grid, memory-mapped from a map file.
+ *
+ * File layout (little endian): an occupancy_header, then nx*ny*nz bytes,
+ * x fastest, then y, then z (index (z*ny + y)*nx + x). A non-zero byte is
+ * an occupied cell. Cell (0,0,0) spans origin to origin + resolution, in
+ * the local ENU frame of the uavs.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_OCCUPANCY_GRID_HPP_
+#define outdoor_gcs_OCCUPANCY_GRID_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct occupancy_header
+	{
+		char magic[8]; // "OGCSGRID"
+		uint32_t version; // 1
+		uint32_t nx, ny, nz;
+		float resolution; // [m] cell edge
+		float origin[3]; // [m] corner of cell (0,0,0)
+	};
+
+class OccupancyGrid {
+public:
+	OccupancyGrid() {}
+	~OccupancyGrid();
+
+	// Maps the file read-only; on failure returns false and fills error
+	bool Load(const std::string &path, std::string &error);
+	bool Loaded() const;
+	// Marks every cell within radius [m] of an occupied cell as blocked (for planning)
+	void Inflate(float radius);
+
+	int Nx() const { return nx; }
+	int Ny() const { return ny; }
+	int Nz() const { return nz; }
+	float Resolution() const { return resolution; }
+	const float *Origin() const { return origin; }
+	int Index(int x, int y, int z) const { return (z*ny + y)*nx + x; }
+	bool Inside(int x, int y, int z) const { return x >= 0 && y >= 0 && z >= 0 && x < nx && y < ny && z < nz; }
+	// Occupied in the map file
+	bool Occupied(int x, int y, int z) const { return cells[Index(x, y, z)] != 0; }
+	// Occupied or within the inflation radius, outside the grid counts as blocked
+	bool Blocked(int x, int y, int z) const;
+	bool World_To_Cell(const float pos[3], int cell[3]) const;
+	void Cell_To_World(const int cell[3], float pos[3]) const; // cell center
+
+private:
+	OccupancyGrid(const OccupancyGrid &);
+	OccupancyGrid &operator=(const OccupancyGrid &);
+	void unmap();
+
+	void *map = nullptr;
+	size_t map_size = 0;
+	const uint8_t *cells = nullptr;
+	std::vector<uint8_t> inflated; // empty without inflation
+	int nx = 0, ny = 0, nz = 0;
+	float resolution = 1.0;
+	float origin[3] = {0, 0, 0};
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_OCCUPANCY_GRID_HPP_ */
@@ -0,0 +1,138 @@
+/**
+ * @file /include/outdoor_gcs/planner_plugin.hpp
+ *
+ * @brief Interface of runtime-loadable planner libraries.
+ *
+ * A plugin is a shared library built against this header only:
+ *
+ *   class MyPlanner : public outdoor_gcs::PlannerPlugin { ... };
+ *   OUTDOOR_GCS_PLANNER_PLUGIN(MyPlanner)
+ *
+ * and listed in the ~planner_plugins parameter of the GCS.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_PLANNER_PLUGIN_HPP_
+#define outdoor_gcs_PLANNER_PLUGIN_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <map>
+#include <memory>
+#include <string>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Interface
+*****************************************************************************/
+
+#define OUTDOOR_GCS_PLANNER_API 1 // bumped whenever the structs below change
+
+	/**
+	 * @brief One planning tick: the fleet snapshot plus the hosts to plan.
+	 * All arrays are indexed by uav index (size entries) unless noted.
+	 */
+	struct planner_input
+	{
+		double stamp; // [s] time the snapshot is valid for
+		float dt; // [s] planner step
+		float budget; // [s] loop period
+		int size; // number of uav slots
+		const int *fleet; // available uavs, num_fleet entries
+		int num_fleet;
+		const int *hosts; // uavs to plan, num_hosts entries
+		int num_hosts;
+		const float (*pos)[3];
+		const float (*vel)[3];
+		const float (*goal)[3]; // pos_des
+	};
+
+	/**
+	 * @brief Result for one host, type 0 to send nothing, 1 for a position
+	 * (pos), 2 for a full reference (pos, vel, acc).
+	 */
+	struct planner_command
+	{
+		int type;
+		float pos[3];
+		float vel[3];
+		float acc[3];
+	};
+
+class PlannerPlugin {
+public:
+	virtual ~PlannerPlugin() {}
+
+	virtual const char *Name() const = 0;
+	// Gains by name: the GCS flock / ORCA gains and everything under ~planner_params
+	virtual void Configure(const std::map<std::string, float> &/*params*/) {}
+	// out[k] belongs to in.hosts[k]; may be called from a non-ROS thread
+	virtual void Plan(const planner_input &in, planner_command *out) = 0;
+};
+
+}  // namespace outdoor_gcs
+
+#define OUTDOOR_GCS_PLANNER_PLUGIN(Class) \
+	extern "C" int outdoor_gcs_planner_api() { return OUTDOOR_GCS_PLANNER_API; } \
+	extern "C" outdoor_gcs::PlannerPlugin *outdoor_gcs_create_planner() { return new Class; } \
+	extern "C" void outdoor_gcs_destroy_planner(outdoor_gcs::PlannerPlugin *p) { delete p; }
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct plugin_stat
+	{
+		std::string name;
+		int ticks = 0;
+		int over_budget = 0; // ticks slower than the loop period
+		float last_us = 0;
+		float mean_us = 0;
+		float max_us = 0;
+	};
+
+/**
+ * @brief One loaded planner library (GCS side).
+ */
+class PlannerLibrary {
+public:
+	~PlannerLibrary();
+
+	// Returns null and fills error when the library cannot be used. Maps a private copy of the file,
+	// so loading a rebuilt library at the path of a loaded one gives a second, independent image
+	static std::unique_ptr<PlannerLibrary> Load(const std::string &path, std::string &error);
+
+	const std::string &Name() const;
+	const std::string &Path() const;
+	void Configure(const std::map<std::string, float> &params);
+	// Plans and records the compute time against in.budget
+	void Plan(const planner_input &in, planner_command *out);
+	plugin_stat GetStat() const;
+
+private:
+	PlannerLibrary() {}
+
+	void *handle = nullptr;
+	PlannerPlugin *plugin = nullptr;
+	void (*destroy)(PlannerPlugin *) = nullptr;
+	std::string name;
+	std::string path;
+	plugin_stat stat;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_PLANNER_PLUGIN_HPP_ */
@@ -0,0 +1,314 @@
+/**
+ * @file /include/outdoor_gcs/planners.hpp
+ *
+ * @brief Dimension-specialized local planners (flock, downwash flock, ORCA).
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_PLANNERS_HPP_
+#define outdoor_gcs_PLANNERS_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "state_history.hpp"
+#include "distance_field.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+/**
+ * Every planner computes the next position of one host from an immutable
+ * fleet snapshot:
+ *
+ *   void Plan(const FleetSnapshot &snap, const std::vector<int> &fleet,
+ *             int host, const float goal[3], float pos_nxt[3]) const;
+ *
+ * Only the first Dim components of pos_nxt are written, a 2D planner leaves
+ * the height to the caller. Plan() is const and touches nothing but
+ * pos_nxt, so hosts can be planned concurrently.
+ *
+ * Set_Obstacles() adds static obstacles from a distance field: one lookup
+ * per host and tick, whatever the map holds.
+ */
+
+/**
+ * @brief Static obstacles within range of a host, from the distance field.
+ */
+	struct obstacle_term
+	{
+		const DistanceField *field = nullptr;
+		float gain = 0; // flock repulsion gain, like RepulsiveGradient
+		float range = 0; // [m] distance from the obstacle surface where it starts to count
+
+		// Distance to the nearest surface and the unit direction away from it, in the first Dim axes
+		template <int Dim>
+		bool Near(const std::array<float,3> &pos, float &dist, float away[Dim]) const {
+			float grad[3];
+			if (!field || !field->Sample(pos.data(), dist, grad) || dist >= range){ return false; }
+			float norm2 = 0;
+			for (int i = 0; i < Dim; i++) { norm2 += grad[i]*grad[i]; }
+			if (norm2 < 0.01f){ return false; } // straight above or below, nothing to do in 2D
+			float norm = std::sqrt(norm2);
+			for (int i = 0; i < Dim; i++) { away[i] = grad[i]/norm; }
+			return true;
+		}
+	};
+
+/**
+ * @brief Flocking: spring-damper towards the goal plus a quadratic repulsion
+ * inside r_alpha, acceleration and velocity clamped per axis.
+ *
+ * z_scale stretches vertical distances (3D only) so the repulsion region
+ * becomes an ellipsoid, see DownwashFlockPlanner.
+ */
+template <int Dim>
+class FlockPlanner {
+public:
+	// param: c1, c2, RepulsiveGradient, r_alpha, max_acc, max_vel (QNode flock_param)
+	FlockPlanner(const float param[6], float dt, float z_scale = 1.0) :
+		c1(param[0]), c2(param[1]), rho(param[2]), r_alpha(param[3]), a_max(param[4]), v_max(param[5]),
+		dt(dt), z_scale(z_scale)
+		{}
+
+	void Plan(const FleetSnapshot &snap, const std::vector<int> &fleet, int host, const float goal[3], float pos_nxt[3]) const {
+		const std::array<float,3> &pos = snap.pos[host];
+		const std::array<float,3> &vel = snap.vel[host];
+		float force[Dim];
+		for (int i = 0; i < Dim; i++) {
+			force[i] = -c1*vel[i] - c2*(pos[i] - goal[i]);
+		}
+		for (const auto &other : fleet){
+			if (other == host){ continue; }
+			float d[Dim];
+			float dist2 = 0;
+			for (int i = 0; i < Dim; i++) {
+				d[i] = pos[i] - snap.pos[other][i];
+				if (i == 2){ d[i] *= z_scale; }
+				dist2 += d[i]*d[i];
+			}
+			float dist = std::sqrt(dist2);
+			if (dist <= 0 || dist >= r_alpha){ continue; }
+			float f = rho*(dist - r_alpha)*(dist - r_alpha);
+			for (int i = 0; i < Dim; i++) {
+				force[i] += f*d[i]/dist;
+			}
+		}
+		float od, away[Dim];
+		if (obstacles.template Near<Dim>(pos, od, away)){
+			float f = obstacles.gain*(od - obstacles.range)*(od - obstacles.range);
+			for (int i = 0; i < Dim; i++) {
+				force[i] += f*away[i];
+			}
+		}
+		for (int i = 0; i < Dim; i++) {
+			float acc = std::min(std::max(force[i], -a_max), a_max);
+			float v = std::min(std::max(vel[i] + acc*dt, -v_max), v_max);
+			pos_nxt[i] = pos[i] + v*dt;
+		}
+	}
+
+	void Set_Obstacles(const DistanceField *field, float gain, float range){
+		obstacles.field = field;
+		obstacles.gain = gain;
+		obstacles.range = range;
+	}
+
+protected:
+	float c1, c2, rho, r_alpha, a_max, v_max;
+	float dt;
+	float z_scale;
+	obstacle_term obstacles;
+};
+
+/**
+ * @brief Flocking that keeps more vertical than horizontal separation, so no
+ * uav sits in the downwash of another. 3D only: in the plane it is the flock.
+ */
+template <int Dim>
+class DownwashFlockPlanner : public FlockPlanner<Dim> {
+	static_assert(Dim == 3, "downwash needs the vertical axis, use FlockPlanner<2> in 2D");
+public:
+	// z_scale > 1: a uav straight above counts as z_scale times closer
+	DownwashFlockPlanner(const float param[6], float dt, float z_scale) :
+		FlockPlanner<Dim>(param, dt, z_scale)
+		{}
+};
+
+/**
+ * @brief Optimal reciprocal collision avoidance.
+ *
+ * Each neighbour within NDist gives one half-space of admissible velocities
+ * (the RVO3 construction, which holds in any dimension). The preferred
+ * velocity towards the goal is pushed into their intersection by repeated
+ * projection, then clamped to the preferred speed.
+ */
+template <int Dim>
+class OrcaPlanner {
+public:
+	// param: tau, pref_v, r, Neighbor Dist (QNode orca_param)
+	OrcaPlanner(const float param[4], float dt, int iterations = 20) :
+		tau(param[0]), v_pref(param[1]), radius(param[2]), neighbor_dist(param[3]),
+		dt(dt), iterations(iterations)
+		{}
+
+	void Plan(const FleetSnapshot &snap, const std::vector<int> &fleet, int host, const float goal[3], float pos_nxt[3]) const {
+		const std::array<float,3> &pos = snap.pos[host];
+		const std::array<float,3> &vel = snap.vel[host];
+
+		// Preferred velocity: towards the goal, arriving within one step when close
+		float v[Dim];
+		for (int i = 0; i < Dim; i++) {
+			v[i] = (goal[i] - pos[i])/dt;
+		}
+		limit(v, v_pref);
+
+		// One constraint buffer per thread, reused across hosts and ticks; hosts of a tick run concurrently
+		static thread_local std::vector<plane> planes;
+		planes.clear();
+		float R = 2*radius;
+		for (const auto &other : fleet){
+			if (other == host){ continue; }
+			float p[Dim], rv[Dim];
+			float dist2 = 0;
+			for (int i = 0; i < Dim; i++) {
+				p[i] = snap.pos[other][i] - pos[i];
+				rv[i] = vel[i] - snap.vel[other][i];
+				dist2 += p[i]*p[i];
+			}
+			if (dist2 > neighbor_dist*neighbor_dist){ continue; }
+
+			plane pl;
+			float u[Dim];
+			float w[Dim];
+			if (dist2 > R*R){
+				float w2 = 0, wp = 0;
+				for (int i = 0; i < Dim; i++) {
+					w[i] = rv[i] - p[i]/tau;
+					w2 += w[i]*w[i];
+					wp += w[i]*p[i];
+				}
+				if (wp < 0 && wp*wp > R*R*w2){ // closest to the cut-off sphere
+					float wl = std::sqrt(w2);
+					if (wl <= 0){ continue; }
+					for (int i = 0; i < Dim; i++) {
+						pl.normal[i] = w[i]/wl;
+						u[i] = (R/tau - wl)*pl.normal[i];
+					}
+				} else{ // closest to the cone
+					float a = dist2, b = dot(p, rv), vv = dot(rv, rv);
+					float cross2 = std::max(a*vv - b*b, 0.0f);
+					float c = vv - cross2/(a - R*R);
+					float t = (b + std::sqrt(std::max(b*b - a*c, 0.0f)))/a;
+					float wl2 = 0;
+					for (int i = 0; i < Dim; i++) {
+						w[i] = rv[i] - t*p[i];
+						wl2 += w[i]*w[i];
+					}
+					float wl = std::sqrt(wl2);
+					if (wl <= 0){ continue; }
+					for (int i = 0; i < Dim; i++) {
+						pl.normal[i] = w[i]/wl;
+						u[i] = (R*t - wl)*pl.normal[i];
+					}
+				}
+			} else{ // already overlapping: separate within one step
+				float w2 = 0;
+				for (int i = 0; i < Dim; i++) {
+					w[i] = rv[i] - p[i]/dt;
+					w2 += w[i]*w[i];
+				}
+				float wl = std::sqrt(w2);
+				if (wl <= 0){ continue; }
+				for (int i = 0; i < Dim; i++) {
+					pl.normal[i] = w[i]/wl;
+					u[i] = (R/dt - wl)*pl.normal[i];
+				}
+			}
+			for (int i = 0; i < Dim; i++) {
+				pl.point[i] = vel[i] + 0.5f*u[i]; // half of the avoidance is left to the other uav
+			}
+			planes.push_back(pl);
+		}
+
+		// A static obstacle only bounds the speed towards it: no contact within tau
+		float od, away[Dim];
+		if (obstacles.template Near<Dim>(pos, od, away)){
+			plane pl;
+			float bound = od > radius ? -(od - radius)/tau : (radius - od)/dt;
+			for (int i = 0; i < Dim; i++) {
+				pl.normal[i] = away[i];
+				pl.point[i] = bound*away[i];
+			}
+			planes.push_back(pl);
+		}
+
+		for (int it = 0; it < iterations && !planes.empty(); it++) {
+			bool violated = false;
+			for (const auto &pl : planes){
+				float s = 0;
+				for (int i = 0; i < Dim; i++) { s += (v[i] - pl.point[i])*pl.normal[i]; }
+				if (s < 0){
+					for (int i = 0; i < Dim; i++) { v[i] -= s*pl.normal[i]; }
+					violated = true;
+				}
+			}
+			limit(v, v_pref);
+			if (!violated){ break; }
+		}
+		for (int i = 0; i < Dim; i++) {
+			pos_nxt[i] = pos[i] + v[i]*dt;
+		}
+	}
+
+	// gain is not used: the obstacle is a velocity constraint
+	void Set_Obstacles(const DistanceField *field, float gain, float range){
+		obstacles.field = field;
+		obstacles.gain = gain;
+		obstacles.range = range;
+	}
+
+private:
+	struct plane
+	{
+		float point[Dim];
+		float normal[Dim];
+	};
+
+	static float dot(const float a[Dim], const float b[Dim]){
+		float s = 0;
+		for (int i = 0; i < Dim; i++) { s += a[i]*b[i]; }
+		return s;
+	}
+
+	static void limit(float v[Dim], float v_max){
+		float n = std::sqrt(dot(v, v));
+		if (n > v_max && n > 0){
+			for (int i = 0; i < Dim; i++) { v[i] *= v_max/n; }
+		}
+	}
+
+	float tau, v_pref, radius, neighbor_dist;
+	float dt;
+	int iterations;
+	obstacle_term obstacles;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_PLANNERS_HPP_ */
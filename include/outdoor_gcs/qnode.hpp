@@ -28,10 +28,17 @@
 #endif
 
 #include <string>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
 #include <cmath>
 #include <math.h>
 // #include <unistd.h>
 // #include <Eigen/Eigen>
+#include <QList>
 #include <QThread>
 #include <QStringListModel>
 
@@ -41,6 +48,8 @@
 #include <outdoor_gcs/ControlCommand.h>
 #include <outdoor_gcs/Topic_for_log.h>
 #include <outdoor_gcs/PathPlan.h>
+#include <outdoor_gcs/FleetCommand.h>
+#include <outdoor_gcs/TimeSync.h>
 #include <mavros_msgs/State.h>
 #include <mavros_msgs/CommandBool.h>
 #include <mavros_msgs/CommandHome.h>
@@ -56,6 +65,33 @@
 #include <mavros_msgs/PositionTarget.h>
 #include <mavros_msgs/AttitudeTarget.h>
 #include <mavros_msgs/RTCM.h>
+#include <std_msgs/String.h>
+#include <std_srvs/Trigger.h>
+
+#include "setpoint_streamer.hpp"
+#include "trajectory.hpp"
+#include "state_predictor.hpp"
+#include "state_history.hpp"
+#include "latency_histogram.hpp"
+#include "thread_pool.hpp"
+#include "planners.hpp"
+#include "planner_plugin.hpp"
+#include "assignment.hpp"
+#include "occupancy_grid.hpp"
+#include "cbs_planner.hpp"
+#include "distance_field.hpp"
+#include "separation_monitor.hpp"
+#include "geofence.hpp"
+#include "command_scheduler.hpp"
+#include "mission.hpp"
+#include "readiness.hpp"
+#include "event_log.hpp"
+#include "binlog.hpp"
+#include "control_server.hpp"
+#include "fleet_shm.hpp"
+#include "command_tracer.hpp"
+#include "clock_sync.hpp"
+#include "metrics.hpp"
 
 
 /*****************************************************************************
@@ -138,6 +174,47 @@ namespace outdoor_gcs {
 		int uav_item = 1;
 	};
 
+	struct pub_stat
+	{
+		int num = 0; // number of vehicles commanded in the last tick
+		uint32_t bytes = 0; // serialized size of everything published in the last tick
+		float time_us = 0; // wall time spent in publish() in the last tick
+	};
+
+	struct plan_stat
+	{
+		int hosts = 0; // number of uavs planned in the last tick
+		int threads = 1;
+		float time_us = 0; // wall time of the planning step in the last tick
+	};
+
+	struct assign_stat
+	{
+		std::string mode; // sum, max or none
+		int num = 0;
+		int changed = 0; // uavs sent to another uav's goal
+		int unknown = 0; // uavs without odometry, left on their own goal
+		float fixed_sum = 0, fixed_max = 0; // [m] travel with the fixed goals
+		float sum = 0, max = 0; // [m] travel with the assigned goals
+		float time_us = 0;
+	};
+
+	struct global_plan
+	{
+		uint64_t goals = 0; // goals_gen the goals belong to
+		std::vector<int> uavs;
+		std::vector<waypoint> start, goal;
+		std::vector<std::vector<waypoint> > paths; // one cell center per step, the goal last
+		outdoor_gcs::cbs_stat stat;
+	};
+
+	struct plan_out
+	{
+		int type = 0; // 0 for nothing to send, 1 for move to pos, 2 for trajectory reference
+		float pos[3];
+		outdoor_gcs::TrajectoryPoint ref;
+	};
+
 	enum Command_Type
 	{
 		Idle,
@@ -159,8 +236,10 @@ class QNode : public QThread {
 public:
 	QNode(int argc, char** argv );
 	virtual ~QNode();
-	bool init();
+	bool init(); // false without a master or with another GCS running, see Init_Error()
 	void run();
+	void Set_Headless(bool on); // before init: no GUI, uavs detected at start and driven through ~control_socket
+	std::string Init_Error() const { return init_error; }
 	
 	ros::master::V_TopicInfo topic_infos;
 
@@ -191,9 +270,13 @@ public:
 	void uavs_pub_command();
 	void Set_Arm_uavs(bool arm_disarm, int ind);
 	void Set_Mode_uavs(std::string command_mode, int ind);
+	// action: arm, disarm, takeoff, land, rtl, loiter, posctl, offboard, move, stop or a mode name in capitals;
+	// the k-th uav at wall time at + k*stagger [s]. Returns the number of commands scheduled, -1 for an unknown action
+	int Schedule_Fleet(const std::string &action, const std::vector<int> &uavs, double at, double stagger);
 	void Set_GPS_Home_uavs(int host_ind, int origin_ind);
 	void Set_Square_Circle(int host_ind, float input[2]);
 	void move_uavs(int ind, float pos_input[3]);
+	void move_uavs_traj(int ind, const outdoor_gcs::TrajectoryPoint &ref);
 	void UAVS_Do_Plan();
 
 	void Update_UAV_info(outdoor_gcs::uav_info UAV_input, int ind);
@@ -206,6 +289,8 @@ public:
 	void Update_ORCA_Param(float param[4]);
 	void Update_PathPlan_Pos(int i, float pos_input[3], bool init_fin);
 	void Update_PathPlan_Des(int i, bool init_fin);
+	outdoor_gcs::assign_stat Assign_Goals(bool init_fin); // stops the global paths being flown
+	void Request_Global_Paths(); // from the positions to pos_des, planned off the ros thread and reported as an event
 	void Update_px4_apm(bool TF);
 
 	State GetState_uavs(int ind);
@@ -217,6 +302,32 @@ public:
 	outdoor_gcs::Topic_for_log GetLog_uavs(int ind);
 	float GetFlockParam(int i);
 	float GetORCAParam(int i);
+	outdoor_gcs::pub_stat GetCmdPubStat();
+	outdoor_gcs::stream_stat GetStreamStat();
+	float GetStreamRate();
+	outdoor_gcs::FleetSnapshot GetSnapshot();
+	bool GetEventPlanning();
+	const outdoor_gcs::LatencyHistogram &GetReactLatency();
+	outdoor_gcs::plan_stat GetPlanStat();
+	outdoor_gcs::separation_stat GetSeparationStat();
+	void GetFenceCount(int ind, int count[2]); // clamped, rejected
+	bool GetFenceLoaded();
+	bool GetFenceInside(const float p[3]);
+	float GetSyncDelay();
+	float GetTakeoffStagger();
+	int GetSchedulePending();
+	const outdoor_gcs::LatencyHistogram &GetScheduleSkew();
+	std::vector<outdoor_gcs::sched_record> GetScheduleRecent();
+	outdoor_gcs::mission_status GetMissionStatus();
+	outdoor_gcs::readiness_report GetReadiness();
+	outdoor_gcs::EventLog &GetEventLog(); // operator events, shown in the notice logger
+	outdoor_gcs::CommandTracer &GetCommandTracer();
+	outdoor_gcs::clock_estimate GetClockEstimate(int ind);
+	bool GetClockSync();
+	std::vector<outdoor_gcs::separation_alert> GetSeparationEvents(); // new since the last call
+	std::vector<outdoor_gcs::plugin_stat> GetPluginStats();
+	int GetActivePlanner();
+	bool GetFleetCommandMode();
 
 	QStringList lsAllTopics();
 	outdoor_gcs::Angles quaternion_to_euler(float quat[4]);
@@ -224,6 +335,7 @@ public:
 Q_SIGNALS:
 	void rosLoopUpdate();
     void rosShutdown();
+	void availUavsUpdate(QList<int> uavs); // avail_uavind set from the control socket
 
 private:
 	int init_argc;
@@ -276,7 +388,7 @@ private:
 	float dt = 0.25;
 	ros::Time last_change;
 	
-	int Plan_Dim[9]; // 0 for move wo planning, 2 for 2DFlock, 3 for 3DFlock, 4 9 for ORCA, 10 for square, 11 for circle
+	int Plan_Dim[9]; // 0 for move wo planning, 2 for 2DFlock, 3 for 3DFlock, 4 9 for ORCA, 10 for square, 11 for circle, 20 for planner plugin
 	
 	// Flocking params
 	// float c1 = 10.0; //7.0;
@@ -290,16 +402,212 @@ private:
 	float flock_param[6] = {10.0, 10.0, 50.0, 3.0, 10.0, 10.0}; // c1, c2, RepulsiveGradient, r_alpha, max_acc, max_vel
 
 	// Square & circle 
-	float sc_size;
-	float sc_time;
-	float sq_corners[9][5][2]; // 5 uavs, 4+1 conrners (extra one for coding simplicity purpose), 2D: xy
-	float square_x[8] = {2, 2, 2, 0, -2, -2, -2, 0}; 
-	float square_y[8] = {2, 0, -2, -2, -2, 0, 2, 2};
-	int path_i = 0;
-	float centers[9][3];
-	bool start_path = false;
+	float sc_size = 0;
+	float sc_time = 0;
+	float centers[9][3] = {{0}};
+	std::string square_shape = "polyline"; // polyline, min_jerk or min_snap through the corners
+	std::string circle_shape = "circle"; // circle or lemniscate
+	TrajectoryTable sc_traj[9]; // timed path of each uav (sc_time > 0)
+	std::vector<waypoint> sc_waypoints[9]; // stepped path of each uav (sc_time == 0)
+	std::mutex sc_mutex[9]; // Build_Path (GUI thread) swaps the tables while Plan_Host reads them
+	int path_i[9] = {0};
+	bool start_path[9] = {false};
+	ros::Time path_start[9];
+	void Build_Path(int host_ind, int dim);
 	bool pathplan = false;
 
+	// Latency compensation: planners use the state predicted at now + cmd_latency
+	bool predict_state = true;
+	float cmd_latency = 0.05; // [s] command transport and execution delay
+	float snapshot_stale = 0.5; // [s] without prediction, uavs with older odometry do not hold the snapshot back
+	StatePredictor predictor[9];
+
+	// Planners read one snapshot of the fleet, all uavs resampled to the same stamp
+	StateHistory history[9];
+	FleetSnapshot snap;
+	std::mutex snap_mutex; // Build_Snapshot (ros thread) rewrites snap while GetSnapshot copies it for the GUI
+	void Build_Snapshot(const ros::Time &t);
+	ros::Time Snapshot_Time();
+
+	// Planning of one uav, run for every uav on the loop tick or on fresh odometry (event_planning)
+	bool event_planning = false;
+	float event_rate = 20.0; // [Hz] max replanning rate of one uav
+	ros::Time last_plan[9];
+	ros::Time plan_odom[9]; // stamp of the odometry the last plan was built on
+	LatencyHistogram react_latency; // odometry stamp to command publish
+	void Plan_Hosts(const std::vector<int> &hosts);
+	void Plan_Begin(int host_ind);
+	void Plan_Host(int host_ind);
+	void Plan_Event(int ind);
+	void Pub_Move(int ind, outdoor_gcs::FleetCommand &fleet, pub_stat &stat); // pending command of ind
+	void Pub_Fleet(outdoor_gcs::FleetCommand &fleet, pub_stat &stat); // the batch, if fleet_command
+
+	// Flock, ORCA and DW flock run as planner templates (planners.hpp) on groups of hosts
+	bool local_pathplan = false; // ORCA & DW flock (Plan_Dim 4~7) here instead of the external planner
+	float downwash_scale = 2.0; // vertical distance stretch of the DW flock
+	std::vector<int> fleet; // avail_uavind of the current tick
+	void For_Hosts(const std::vector<int> &hosts, const std::function<void(int)> &f);
+	template <class Planner>
+	void Run_Planner(Planner planner, const std::vector<int> &hosts, bool keep_height);
+	// Static obstacles of ~occupancy_map for the planner templates
+	DistanceField obstacle_field;
+	float obstacle_gain = 50.0; // flock repulsion gain of obstacles
+	float obstacle_range = 2.0; // [m]
+
+	std::string goal_assignment = "none"; // Go Init / Go Final ALL: none (own goal), sum or max
+
+	// Global paths over ~occupancy_map: on Go Init / Go Final ALL the fleet gets conflict-free
+	// grid paths (CBS) and flies them in lockstep, pos_des stepping from cell to cell
+	OccupancyGrid occupancy;
+	float occupancy_inflate = 0.5; // [m] clearance kept from occupied cells
+	float cbs_budget = 1.0; // [s]
+	float cbs_suboptimality = 1.2; // bound on the total path length, 1 for optimal (slow on dense fleets)
+	std::mutex global_mutex;
+	std::vector<waypoint> global_path[9]; // one cell center per step, the goal last
+	int global_step = -1; // step the fleet is flying to, -1 without global paths
+	bool global_active[9] = {}; // still short of its goal, not arrived
+	uint64_t goals_gen = 0; // bumped by Assign_Goals, a plan for older goals is dropped
+	std::atomic<bool> global_request{false};
+	std::future<global_plan> global_job; // CBS on its own thread, the fleet holds meanwhile
+	void Start_Global_Paths();
+	void Apply_Global_Paths(const global_plan &plan);
+	void Step_Global_Paths();
+
+	// Separation of every pair of uavs, checked each tick (after planning)
+	SeparationMonitor separation;
+	bool separation_planned = false; // predict with the planned step instead of vel_cur
+	separation_stat sep_stat;
+	std::vector<separation_alert> sep_alerts; // this tick
+	std::set<std::pair<int,int> > sep_active; // pairs in alert, to report each once
+	std::vector<separation_alert> sep_events; // new alerts for the GUI
+	std::mutex sep_mutex;
+	void Check_Separation();
+
+	// Geofence of ~geofence_file, applied to every position command that leaves the GCS
+	Geofence geofence;
+	bool geofence_clamp = true; // false: reject commands outside instead of clamping them
+	std::atomic<int> fence_clamped[9];
+	std::atomic<int> fence_rejected[9];
+	bool Fence_Command(int ID, float pos[3]);
+	bool Fence_Command(int ID, const float from[3], float pos[3]);
+	bool Fence_Setpoint(float pos[3]); // single uav, /mavros/setpoint_raw/local
+
+	// Timed fleet commands, one scheduler lane per uav so the service calls of all uavs go out together
+	std::unique_ptr<CommandScheduler> scheduler;
+	float sync_delay = 0; // [s] fleet buttons act this long after the click, 0 for the serial service calls of the loop
+	float takeoff_stagger = 0; // [s] between consecutive uavs on TAKEOFF ALL
+	ros::Subscriber schedule_sub;
+	std::mutex move_mutex;
+	std::vector<std::pair<int, bool> > move_queue; // move / stop from the lanes, applied at the start of a tick
+	void Apply_Moves();
+	int Fill_Mode(int ind, const std::string &command_mode, mavros_msgs::SetMode &setmode, mavros_msgs::CommandTOL &landtoff);
+	void Call_Mode(int ind, const std::string &command_mode);
+	bool Schedule_Text(const std::string &text, std::string &error); // as on /uavs/schedule
+	void schedule_callback(const std_msgs::String::ConstPtr &msg);
+
+	// Operator events of the GUI and of qnode, spilled to ~event_log_file once they leave the ring
+	EventLog events;
+
+	// Mission script of ~mission_file, started by /uavs/mission_start and advanced after planning on every tick
+	Mission mission;
+	std::string mission_file;
+	bool mission_active = false; // started and not reported as ended yet
+	ros::ServiceServer mission_start_srv;
+	ros::ServiceServer mission_abort_srv;
+	void Run_Mission();
+	bool Mission_Act(const mission_step &step);
+	bool Mission_Test(const mission_step &step);
+	bool mission_start_callback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res);
+	bool mission_abort_callback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res);
+
+	// Pre-flight go / no-go of every available uav, evaluated on every tick (in parallel with plan_threads)
+	readiness_criteria ready_criteria;
+	ros::WallTime rx_state[9], rx_gps[9], rx_odom[9]; // last message of each telemetry stream
+	bool home_set[9] = {};
+	readiness_report ready_report;
+	std::mutex ready_mutex;
+	ros::ServiceServer preflight_srv;
+	unsigned Readiness_Of(int ind, std::string &reason);
+	void Check_Preflight();
+	bool preflight_callback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res);
+
+	// Local control and telemetry socket of ~control_socket, served after every tick
+	bool headless = false;
+	std::string init_error;
+	bool Other_GCS(std::string &error); // before ros::start, which would make the master shut the other one down
+	ControlServer control;
+	uint64_t control_tick = 0;
+	void Run_Control();
+	std::string Control_Command(int client, const std::string &line);
+	std::string Telemetry();
+	std::string Detect_UAVs(); // available uavs from the topics on the master, as Update UAV List
+
+	// Vehicle clock to GCS clock (~clock_sync: off, passive, or exchange with the timesync_responder of each uav);
+	// vehicle header stamps go through Stamp_To_GCS before anything compares them with ros::Time::now()
+	ClockSync clock_sync;
+	bool clock_passive = false, clock_exchange = false;
+	ros::Publisher uavs_timesync_pub[9];
+	ros::Subscriber uavs_timesync_sub[9];
+	uint32_t timesync_seq = 0;
+	ros::WallTime timesync_last;
+	ros::Time Stamp_To_GCS(int ind, const ros::Time &stamp);
+	void Request_Timesync();
+	void uavs_timesync_callback(const outdoor_gcs::TimeSync::ConstPtr &msg, int ind);
+
+	// Publish to echo latency of the position commands, matched by Command_ID in uavs_log_callback
+	CommandTracer tracer;
+
+	// Fleet state of every tick in the shared memory segment ~fleet_shm, for local readers
+	FleetShmWriter fleet_shm;
+	uint64_t shm_tick = 0;
+	void Publish_Fleet_Shm();
+
+	// Loop health, telemetry rates and fleet status for ~metrics_port (Prometheus text) and ~metrics_file
+	// (binary snapshots, see metrics_dump); the loop and the callbacks feed the registry, its thread serves it
+	enum Loop_Stage {Stage_Command, Stage_Plan, Stage_Mission, Stage_Separation, Stage_Preflight, Stage_Shm,
+			Stage_Service, Stage_Publish, Stage_Spin, Stage_Control, Stage_Count};
+	enum Rx_Stream {Rx_State, Rx_Imu, Rx_Gps, Rx_Global, Rx_Odom, Rx_Log, Rx_Count};
+	enum Service_Kind {Srv_Arming, Srv_Mode, Srv_Land, Srv_Takeoff, Srv_Home, Srv_Count};
+	MetricsRegistry metrics;
+	LatencyHistogram *m_loop_period, *m_loop_jitter, *m_stage[Stage_Count], *m_service[Srv_Count];
+	MetricCounter *m_service_failed[Srv_Count], *m_rx[9][Rx_Count], *m_trace[9][6], *m_command_bytes;
+	MetricCounter *m_events_dropped, *m_binlog_dropped;
+	MetricGauge *m_rx_age[9][Rx_Count], *m_clock_offset[9], *m_clock_drift[9];
+	MetricGauge *m_available[9], *m_connected[9], *m_armed[9], *m_ready[9];
+	MetricGauge *m_scheduled, *m_events_held, *m_control_clients, *m_sep_alerts, *m_sep_min_dist, *m_plan_hosts;
+	ros::WallTime rx_last[9][Rx_Count];
+	void Setup_Metrics();
+	void Update_Metrics();
+	void Count_Rx(int ind, Rx_Stream stream);
+	ros::WallTime Stage_Done(Loop_Stage stage, const ros::WallTime &start); // returns now, the start of the next stage
+	template <class Service>
+	bool Call_Service(ros::ServiceClient &client, Service &srv, Service_Kind kind);
+
+	// Planner plugins (Plan_Dim 20), loaded from ~planner_plugins or at runtime via /uavs/select_planner
+	std::vector<std::unique_ptr<PlannerLibrary> > planner_libs;
+	int active_planner = -1;
+	std::map<std::string, float> planner_params; // ~planner_params, passed to every plugin
+	std::atomic<bool> planner_config{false}; // gains changed, reconfigure before the next plan
+	std::mutex plugin_mutex;
+	std::vector<outdoor_gcs::plugin_stat> plugin_stats; // copy for the GUI, planner_libs is the ros thread's
+	int plugin_active = -1;
+	std::atomic<bool> plugin_stats_wanted{true};
+	ros::Subscriber planner_select_sub;
+	bool Load_Planner(const std::string &path);
+	void Select_Planner(const std::string &name);
+	void Configure_Planner(PlannerLibrary &lib);
+	void Run_Plugin(const std::vector<int> &hosts);
+	void Update_Plugin_Stats();
+	void planner_select_callback(const std_msgs::String::ConstPtr &msg);
+
+	// Plan_Host writes only its own slot, Apply_Plan sends it (serially, in host order)
+	plan_out plan_output[9];
+	std::unique_ptr<ThreadPool> plan_pool; // null for planning in the ros thread
+	plan_stat plan_time;
+	void Set_Plan_Output(int host_ind, const float pos[3]);
+	void Set_Plan_Output(int host_ind, const outdoor_gcs::TrajectoryPoint &ref);
+	void Apply_Plan(int host_ind);
+
 	int DroneNumber = 9;
 	outdoor_gcs::uav_info UAVs_info[9];
 	std::list<int> avail_uavind;
@@ -312,7 +620,18 @@ private:
 	bool received_rtcm;
 	bool Move[9]; // default false
 
-    int comid = 1;
+    std::atomic<int> comid{1};
+
+	// Command transport: per-vehicle ControlCommand topics and/or one batched FleetCommand
+	bool control_cmd = true;
+	bool fleet_cmd = false;
+	pub_stat cmd_pub_stat;
+
+	// Setpoint streaming: planner outputs are interpolated and sent at stream_rate (0 for off)
+	float stream_rate = 0;
+	SetpointStreamer streamer;
+	std::thread stream_thread;
+	void stream_loop();
 
 	ros::Subscriber ntrip_rtcm;
 	ros::Subscriber uavs_state_sub[9];
@@ -330,6 +649,7 @@ private:
 	ros::Publisher uavs_move_pub[9];
 	ros::Publisher uavs_gps_rtcm_pub[9];
 	ros::Publisher uavs_pathplan_pub;
+	ros::Publisher uavs_fleet_pub;
 
 	ros::ServiceClient uavs_arming_client[9];
 	ros::ServiceClient uavs_setmode_client[9];
@@ -353,6 +673,7 @@ private:
 	mavros_msgs::CommandTOL uavs_apm_landtoff[9];
 	GpsHomePos uavs_gps_home[9]; //origin of gps local
 	outdoor_gcs::ControlCommand Command_List[9];
+	outdoor_gcs::FleetCommand Fleet_Command;
 	RTCM uavs_gps_rtcm[9];
 	outdoor_gcs::PathPlan uavs_pathplan;
 	outdoor_gcs::PathPlan uavs_pathplan_nxt;
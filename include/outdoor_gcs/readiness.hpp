@@ -0,0 +1,87 @@
+/**
+ * @file /include/outdoor_gcs/readiness.hpp
+ *
+ * @brief Pre-flight readiness of a vehicle against configurable criteria:
+ * link, GPS fix and accuracy, telemetry freshness and home.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_READINESS_HPP_
+#define outdoor_gcs_READINESS_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <string>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Functions
+*****************************************************************************/
+
+	enum Ready_Check
+	{
+		Ready_Connected = 1 << 0,
+		Ready_Telemetry = 1 << 1, // every stream received, none older than max_age
+		Ready_Fix = 1 << 2,
+		Ready_Satellites = 1 << 3,
+		Ready_Hdop = 1 << 4,
+		Ready_HAcc = 1 << 5,
+		Ready_Home = 1 << 6,
+	};
+
+	// A threshold of 0 (false for home) turns its check off
+	struct readiness_criteria
+	{
+		int min_fix = 5; // GPSRAW fix_type, 5 for RTK float
+		int min_satellites = 10;
+		float max_hdop = 1.5;
+		float max_h_acc = 0.5; // [m]
+		float max_age = 1.0; // [s]
+		bool home = true; // GPS home set from the GCS
+	};
+
+	// Negative for unknown, which fails the check
+	struct readiness_input
+	{
+		bool connected;
+		int fix_type;
+		int satellites;
+		float hdop;
+		float h_acc; // [m]
+		float age; // [s] of the oldest telemetry stream
+		bool home;
+	};
+
+	struct readiness_row
+	{
+		int id;
+		unsigned failed; // Ready_Check bits
+		std::string reason; // of every failed check
+	};
+
+	struct readiness_report
+	{
+		std::vector<readiness_row> rows;
+		int ready = 0;
+		bool go = false; // every uav ready, and at least one
+		float time_us = 0;
+	};
+
+	// Failed Ready_Check bits, 0 when ready; reason lists the failures
+	unsigned Check_Readiness(const readiness_criteria &criteria, const readiness_input &in, std::string &reason);
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_READINESS_HPP_ */
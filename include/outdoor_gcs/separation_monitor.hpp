@@ -0,0 +1,80 @@
+/**
+ * @file /include/outdoor_gcs/separation_monitor.hpp
+ *
+ * @brief Separation monitor: current distance and closest point of approach
+ * of every pair of vehicles, alerts below a threshold.
+ *
+ * Each vehicle sweeps a box from its position along its velocity over the
+ * horizon, grown by half the threshold. Sweep-and-prune on x keeps only the
+ * pairs whose boxes overlap, and only those get the exact CPA.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_SEPARATION_MONITOR_HPP_
+#define outdoor_gcs_SEPARATION_MONITOR_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <array>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct separation_alert
+	{
+		int a, b; // vehicle ids, a < b
+		float dist; // [m] now
+		float t_cpa; // [s] to the closest point of approach, 0 when separating
+		float d_cpa; // [m] at the closest point of approach
+	};
+
+	struct separation_stat
+	{
+		int num = 0;
+		int candidates = 0; // pairs left after the sweep
+		int alerts = 0;
+		float min_dist = -1; // [m] closest pair now if closer than the threshold, else -1
+		float min_cpa = -1; // [m] closest predicted approach within the horizon if below the threshold, else -1
+		float time_us = 0;
+	};
+
+class SeparationMonitor {
+public:
+	// threshold: [m] minimum predicted separation, horizon: [s] prediction time
+	SeparationMonitor(float threshold = 2.0, float horizon = 5.0) : threshold(threshold), horizon(horizon) {}
+	void Configure(float threshold, float horizon);
+	float Threshold() const { return threshold; }
+
+	// Pairs of ids whose predicted separation falls below the threshold, closest first
+	void Check(const std::vector<int> &ids, const std::vector<std::array<float,3> > &pos,
+			const std::vector<std::array<float,3> > &vel, std::vector<separation_alert> &alerts, separation_stat &stat);
+
+private:
+	struct box
+	{
+		float lo[3], hi[3];
+		int k;
+	};
+
+	float threshold, horizon;
+	std::vector<box> boxes; // reused between ticks
+	std::vector<int> active;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_SEPARATION_MONITOR_HPP_ */
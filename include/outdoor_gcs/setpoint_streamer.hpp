@@ -0,0 +1,90 @@
+/**
+ * @file /include/outdoor_gcs/setpoint_streamer.hpp
+ *
+ * @brief High-rate setpoint streaming between planner outputs.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_SETPOINT_STREAMER_HPP_
+#define outdoor_gcs_SETPOINT_STREAMER_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#ifndef Q_MOC_RUN
+#include <ros/ros.h>
+#endif
+
+#include <mutex>
+#include <vector>
+#include <outdoor_gcs/TrajectoryPoint.h>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct stream_stat
+	{
+		int ticks = 0;
+		float period_ms = 0; // expected period
+		float jitter_mean_us = 0; // mean |actual - expected| period
+		float jitter_max_us = 0; // worst |actual - expected| period
+	};
+
+/**
+ * @brief Keeps the last two planner outputs of every uav and resamples them
+ * at the streaming rate.
+ *
+ * The planner output of one loop is reached one planner period after it was
+ * produced, so the reference moves smoothly from the previous output to the
+ * latest one instead of stepping. Linear mode feeds the segment slope forward
+ * as velocity; cubic mode builds a Hermite segment whose end tangents are the
+ * uav velocity (vel_cur) recorded with each output, and feeds velocity and
+ * acceleration forward.
+ */
+class SetpointStreamer {
+public:
+	SetpointStreamer(int size = 9);
+
+	void Update_Reference(int ind, const ros::Time &stamp, const float pos[3], const float vel[3]);
+	void Reset(int ind);
+	bool Active(int ind);
+	bool Sample(int ind, const ros::Time &t, outdoor_gcs::TrajectoryPoint &ref);
+
+	void Record_Tick(const ros::WallTime &now, float expected_period);
+	outdoor_gcs::stream_stat GetStat();
+
+	bool cubic = true;
+
+private:
+	struct ref_pair
+	{
+		int num = 0; // number of valid outputs, up to 2
+		ros::Time stamp[2]; // [0] previous, [1] latest
+		float pos[2][3];
+		float vel[2][3];
+	};
+
+	std::vector<ref_pair> refs;
+	std::mutex ref_mutex;
+
+	ros::WallTime last_tick;
+	double jitter_sum = 0;
+	outdoor_gcs::stream_stat stat;
+	std::mutex stat_mutex;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_SETPOINT_STREAMER_HPP_ */
@@ -0,0 +1,98 @@
+/**
+ * @file /include/outdoor_gcs/state_history.hpp
+ *
+ * @brief Stamped state history per uav and time-aligned fleet snapshots.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_STATE_HISTORY_HPP_
+#define outdoor_gcs_STATE_HISTORY_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#ifndef Q_MOC_RUN
+#include <ros/ros.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	struct stamped_state
+	{
+		ros::Time stamp;
+		float pos[3];
+		float vel[3];
+	};
+
+	/**
+	 * @brief Positions and velocities of the whole fleet at one common stamp.
+	 */
+	struct FleetSnapshot
+	{
+		ros::Time stamp;
+		std::vector<std::array<float,3> > pos;
+		std::vector<std::array<float,3> > vel;
+		std::vector<float> skew; // [s] common stamp - newest sample of that uav
+		std::vector<char> valid;
+		float max_skew = 0; // [s] largest |skew| over the fleet
+		float build_us = 0; // wall time to build the snapshot
+
+		void resize(int size){
+			pos.resize(size);
+			vel.resize(size);
+			skew.resize(size, 0);
+			valid.resize(size, 0);
+		}
+	};
+
+/**
+ * @brief Fixed-size ring of the last stamped states of one uav.
+ *
+ * Single writer (the odometry callback), any number of readers, no locks:
+ * every slot carries a sequence number that is odd while the slot is being
+ * written, readers skip slots that changed under them.
+ */
+class StateHistory {
+public:
+	static const int Capacity = 16;
+
+	StateHistory();
+
+	void Push(const stamped_state &s);
+	bool Latest(stamped_state &s) const;
+	// Interpolates the state at t; outside the stored span the nearest sample is returned
+	bool Sample(const ros::Time &t, float pos[3], float vel[3]) const;
+
+private:
+	struct slot
+	{
+		std::atomic<uint32_t> seq;
+		stamped_state state;
+	};
+
+	bool read(uint32_t index, stamped_state &s) const;
+
+	slot slots[Capacity];
+	std::atomic<uint32_t> head; // number of pushes so far
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_STATE_HISTORY_HPP_ */
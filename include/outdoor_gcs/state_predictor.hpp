@@ -0,0 +1,77 @@
+/**
+ * @file /include/outdoor_gcs/state_predictor.hpp
+ *
+ * @brief Per-uav constant-acceleration Kalman filter for latency compensation.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_STATE_PREDICTOR_HPP_
+#define outdoor_gcs_STATE_PREDICTOR_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#ifndef Q_MOC_RUN
+#include <ros/ros.h>
+#endif
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+/**
+ * @brief Position/velocity/acceleration filter of one uav, one decoupled
+ * filter per ENU axis.
+ *
+ * Odometry (position and velocity) and IMU acceleration (ENU, gravity
+ * removed) are fused at their header stamps. Predict() extrapolates the
+ * filtered state to any later time, e.g. when a command will be executed,
+ * without changing the filter.
+ */
+class StatePredictor {
+public:
+	StatePredictor();
+
+	void Configure(float q_jerk, float r_pos, float r_vel, float r_acc, float max_horizon);
+	void Update_Odometry(const ros::Time &stamp, const float pos[3], const float vel[3]);
+	void Update_Acceleration(const ros::Time &stamp, const float acc[3]);
+	bool Predict(const ros::Time &t, float pos[3], float vel[3]) const;
+	bool Initialized() const;
+	ros::Time Stamp() const;
+
+private:
+	struct axis_state
+	{
+		double x[3]; // p, v, a
+		double P[3][3];
+	};
+
+	void propagate(axis_state &s, double dt) const;
+	void correct(axis_state &s, int idx, double z, double r);
+	bool advance(const ros::Time &stamp);
+
+	axis_state axis[3];
+	ros::Time stamp;
+	bool init = false;
+
+	double q_jerk = 20.0; // jerk noise density [m^2/s^5]
+	double r_pos = 0.05*0.05; // [m^2]
+	double r_vel = 0.1*0.1; // [m^2/s^2]
+	double r_acc = 0.5*0.5; // [m^2/s^4]
+	double max_horizon = 0.5; // [s] longest extrapolation
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_STATE_PREDICTOR_HPP_ */
@@ -0,0 +1,76 @@
+/**
+ * @file /include/outdoor_gcs/thread_pool.hpp
+ *
+ * @brief Work-stealing thread pool for per-uav computations.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_THREAD_POOL_HPP_
+#define outdoor_gcs_THREAD_POOL_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+/**
+ * @brief Fixed set of workers, each with its own task deque.
+ *
+ * A worker pops from the back of its own deque and, when empty, steals from
+ * the front of the others. Parallel_For() blocks until the whole range is
+ * done; the calling thread works on it as well, so a pool of size n runs on
+ * n-1 extra threads.
+ */
+class ThreadPool {
+public:
+	explicit ThreadPool(int size);
+	~ThreadPool();
+
+	int Size() const;
+	// Calls f(i) for every i in [0, n), chunks of grain indices per task
+	void Parallel_For(int n, const std::function<void(int)> &f, int grain = 1);
+
+private:
+	typedef std::function<void()> task;
+	struct task_queue
+	{
+		std::mutex mutex;
+		std::deque<task> tasks;
+	};
+
+	bool pop(int self, task &t);
+	void worker(int self);
+
+	std::vector<std::unique_ptr<task_queue> > queues; // last one belongs to the calling thread
+	std::vector<std::thread> threads;
+	std::mutex wake_mutex;
+	std::condition_variable wake;
+	std::atomic<int> queued;
+	bool stop = false;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_THREAD_POOL_HPP_ */
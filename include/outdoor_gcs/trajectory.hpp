@@ -0,0 +1,77 @@
+/**
+ * @file /include/outdoor_gcs/trajectory.hpp
+ *
+ * @brief Precomputed time-parameterized trajectories.
+ *
+ * @date October 2026
+ **/
+/*****************************************************************************
+** Ifdefs
+*****************************************************************************/
+
+#ifndef outdoor_gcs_TRAJECTORY_HPP_
+#define outdoor_gcs_TRAJECTORY_HPP_
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <array>
+#include <vector>
+#include <outdoor_gcs/TrajectoryPoint.h>
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Class
+*****************************************************************************/
+
+	typedef std::array<float,3> waypoint;
+
+	struct traj_sample
+	{
+		float pos[3];
+		float vel[3];
+		float acc[3];
+	};
+
+/**
+ * @brief A trajectory sampled once into a fixed-step table.
+ *
+ * Builders do all the geometry (and trig) up front; Evaluate() is an index
+ * plus a blend of two neighbouring samples, so every uav can look up its
+ * own reference by elapsed time in O(1).
+ */
+class TrajectoryTable {
+public:
+	TrajectoryTable();
+
+	bool Empty() const;
+	float Duration() const;
+	bool Evaluate(float t, outdoor_gcs::TrajectoryPoint &ref) const; // false on an empty table, ref untouched
+	waypoint Start() const;
+
+	// Constant speed along the segments, corners included in order
+	static TrajectoryTable Polyline(const std::vector<waypoint> &wps, float period, bool loop, float dt = 0.01);
+	static TrajectoryTable Circle(const waypoint &center, float radius, float period, float dt = 0.01);
+	// Figure eight (lemniscate of Gerono) of the given width, centered at center
+	static TrajectoryTable Lemniscate(const waypoint &center, float size, float period, float dt = 0.01);
+	// Smooth piecewise polynomial through all waypoints, rest at both ends unless loop
+	static TrajectoryTable MinJerk(const std::vector<waypoint> &wps, float period, bool loop, float dt = 0.01);
+	static TrajectoryTable MinSnap(const std::vector<waypoint> &wps, float period, bool loop, float dt = 0.01);
+
+private:
+	static TrajectoryTable MinDerivative(int r, const std::vector<waypoint> &wps, float period, bool loop, float dt);
+
+	float dt;
+	bool loop;
+	std::vector<traj_sample> samples;
+};
+
+}  // namespace outdoor_gcs
+
+#endif /* outdoor_gcs_TRAJECTORY_HPP_ */
@@ -0,0 +1,59 @@
+/**
+ * @file /plugins/straight_line_planner.cpp
+ *
+ * @brief Example planner plugin: straight line to the goal at a fixed speed.
+ *
+ * Load with
+ *   <rosparam param="planner_plugins">[/path/to/devel/lib/libstraight_line_planner.so]</rosparam>
+ * and switch the fleet to it with
+ *   rostopic pub -1 /uavs/select_planner std_msgs/String straight_line
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "../include/outdoor_gcs/planner_plugin.hpp"
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+class StraightLinePlanner : public outdoor_gcs::PlannerPlugin {
+public:
+	const char *Name() const { return "straight_line"; }
+
+	void Configure(const std::map<std::string, float> &params){
+		std::map<std::string, float>::const_iterator it = params.find("straight_line_speed");
+		speed = (it != params.end()) ? it->second : 1.0;
+	}
+
+	void Plan(const outdoor_gcs::planner_input &in, outdoor_gcs::planner_command *out){
+		for (int k = 0; k < in.num_hosts; k++) {
+			int h = in.hosts[k];
+			float d[3], dist = 0;
+			for (int i = 0; i < 3; i++) {
+				d[i] = in.goal[h][i] - in.pos[h][i];
+				dist += d[i]*d[i];
+			}
+			dist = std::sqrt(dist);
+			float step = std::min(dist, speed*in.dt);
+			out[k].type = 2;
+			for (int i = 0; i < 3; i++) {
+				float dir = (dist > 0) ? d[i]/dist : 0;
+				out[k].pos[i] = in.pos[h][i] + dir*step;
+				out[k].vel[i] = (dist > speed*in.dt) ? dir*speed : 0;
+				out[k].acc[i] = 0;
+			}
+		}
+	}
+
+private:
+	float speed = 1.0;
+};
+
+OUTDOOR_GCS_PLANNER_PLUGIN(StraightLinePlanner)
@@ -0,0 +1,129 @@
+/**
+ * @file /src/assignment.cpp
+ *
+ * @brief Optimal assignment of interchangeable uavs to formation goals.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include "../include/outdoor_gcs/assignment.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+// Kuhn's augmenting path on the edges with cost <= limit
+bool augment(int r, int n, const std::vector<double> &cost, double limit, std::vector<int> &match_col, std::vector<char> &seen){
+	for (int c = 0; c < n; c++) {
+		if (seen[c] || cost[r*n+c] > limit){ continue; }
+		seen[c] = 1;
+		if (match_col[c] < 0 || augment(match_col[c], n, cost, limit, match_col, seen)){
+			match_col[c] = r;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool perfect_matching(int n, const std::vector<double> &cost, double limit){
+	std::vector<int> match_col(n, -1);
+	std::vector<char> seen(n);
+	for (int r = 0; r < n; r++) {
+		std::fill(seen.begin(), seen.end(), 0);
+		if (!augment(r, n, cost, limit, match_col, seen)){ return false; }
+	}
+	return true;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+std::vector<int> Assign_Min_Sum(const std::vector<double> &cost, int n){
+	// Shortest augmenting paths with row / column potentials (1-based, column 0 is virtual)
+	const double inf = std::numeric_limits<double>::infinity();
+	std::vector<double> u(n+1, 0), v(n+1, 0);
+	std::vector<int> p(n+1, 0), way(n+1, 0);
+	for (int i = 1; i <= n; i++) {
+		p[0] = i;
+		int j0 = 0;
+		std::vector<double> minv(n+1, inf);
+		std::vector<char> used(n+1, 0);
+		do {
+			used[j0] = 1;
+			int i0 = p[j0], j1 = 0;
+			double delta = inf;
+			for (int j = 1; j <= n; j++) {
+				if (used[j]){ continue; }
+				double cur = cost[(i0-1)*n + (j-1)] - u[i0] - v[j];
+				if (cur < minv[j]){
+					minv[j] = cur;
+					way[j] = j0;
+				}
+				if (minv[j] < delta){
+					delta = minv[j];
+					j1 = j;
+				}
+			}
+			for (int j = 0; j <= n; j++) {
+				if (used[j]){
+					u[p[j]] += delta;
+					v[j] -= delta;
+				} else{
+					minv[j] -= delta;
+				}
+			}
+			j0 = j1;
+		} while (p[j0] != 0);
+		do {
+			int j1 = way[j0];
+			p[j0] = p[j1];
+			j0 = j1;
+		} while (j0);
+	}
+	std::vector<int> assign(n, -1);
+	for (int j = 1; j <= n; j++) {
+		if (p[j] > 0){ assign[p[j]-1] = j-1; }
+	}
+	return assign;
+}
+
+std::vector<int> Assign_Min_Max(const std::vector<double> &cost, int n){
+	if (n == 0){ return std::vector<int>(); }
+	// Smallest threshold that still allows a perfect matching
+	std::vector<double> levels(cost);
+	std::sort(levels.begin(), levels.end());
+	levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+	int lo = 0, hi = levels.size()-1;
+	while (lo < hi) {
+		int mid = (lo + hi)/2;
+		if (perfect_matching(n, cost, levels[mid])){ hi = mid; }
+		else{ lo = mid+1; }
+	}
+	// Minimum total cost among the assignments below it
+	double limit = levels[lo];
+	double big = 1.0 + n*levels.back();
+	std::vector<double> capped(cost);
+	for (auto &c : capped){
+		if (c > limit){ c = big; }
+	}
+	return Assign_Min_Sum(capped, n);
+}
+
+}  // namespace outdoor_gcs
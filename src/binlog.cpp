@@ -0,0 +1,234 @@
+/**
+ * @file /src/binlog.cpp
+ *
+ * @brief Binary diagnostics log: per-thread queues and the writer thread.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../include/outdoor_gcs/binlog.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const uint32_t Queue_Slots = 512; // entries a thread may have waiting for the writer
+const int Drain_Period = 10; // [ms]
+
+// Single producer (its thread), single consumer (the writer)
+struct log_queue
+{
+	struct slot
+	{
+		uint16_t size;
+		char data[BinLog::Max_Entry];
+	};
+	std::atomic<uint32_t> head{0}; // next slot to fill
+	std::atomic<uint32_t> tail{0}; // next slot to write out
+	std::atomic<uint64_t> dropped{0};
+	uint16_t thread = 0;
+	slot slots[Queue_Slots];
+};
+
+struct log_state
+{
+	std::mutex mutex;
+	std::vector<std::unique_ptr<log_queue>> queues; // never freed, a thread may still hold its own
+	std::string formats; // every Log_Format_Record so far, rewritten to each new file
+	size_t formats_written = 0;
+	uint16_t next_id = 0;
+
+	std::FILE *file = nullptr;
+	std::thread writer;
+	std::condition_variable wake;
+	bool stop = false;
+};
+
+log_state &state(){
+	static log_state s;
+	return s;
+}
+
+thread_local log_queue *local_queue = nullptr;
+
+log_queue *queue_of_thread(){
+	if (!local_queue){
+		log_state &s = state();
+		std::lock_guard<std::mutex> lock(s.mutex);
+		s.queues.emplace_back(new log_queue);
+		local_queue = s.queues.back().get();
+		local_queue->thread = uint16_t(s.queues.size());
+	}
+	return local_queue;
+}
+
+template <class T>
+void append(std::string &out, const T &value){
+	out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void append_text(std::string &out, const char *text){
+	size_t n = std::min<size_t>(std::strlen(text), 0xffff);
+	append(out, uint16_t(n));
+	out.append(text, n);
+}
+
+// Writes out what the queues and the format table hold; the writer thread, or Close() after it
+void drain(log_state &s){
+	std::vector<log_queue *> queues;
+	std::string formats;
+	{
+		std::lock_guard<std::mutex> lock(s.mutex);
+		formats = s.formats.substr(s.formats_written);
+		s.formats_written = s.formats.size();
+		for (const auto &q : s.queues){ queues.push_back(q.get()); }
+	}
+	// Formats first, an entry may use one registered just now
+	std::fwrite(formats.data(), 1, formats.size(), s.file);
+	for (log_queue *q : queues){
+		uint32_t tail = q->tail.load(std::memory_order_relaxed);
+		uint32_t head = q->head.load(std::memory_order_acquire);
+		for (; tail != head; tail++) {
+			const log_queue::slot &slot = q->slots[tail % Queue_Slots];
+			std::fwrite(slot.data, 1, slot.size, s.file);
+		}
+		q->tail.store(tail, std::memory_order_release);
+	}
+	std::fflush(s.file);
+}
+
+void writer_loop(){
+	log_state &s = state();
+	std::unique_lock<std::mutex> lock(s.mutex);
+	while (!s.stop) {
+		s.wake.wait_for(lock, std::chrono::milliseconds(Drain_Period));
+		lock.unlock();
+		drain(s);
+		lock.lock();
+	}
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+std::atomic<bool> BinLog::enabled(false);
+
+bool BinLog::Open(const std::string &path, std::string &error){
+	log_state &s = state();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	if (s.file){
+		error = "already open";
+		return false;
+	}
+	s.file = std::fopen(path.c_str(), "wb");
+	if (!s.file){
+		error = path + ": " + std::strerror(errno);
+		return false;
+	}
+	std::fwrite(Log_Magic, 1, sizeof(Log_Magic), s.file);
+	std::fwrite(&Log_Version, sizeof(Log_Version), 1, s.file);
+	s.formats_written = 0;
+	for (const auto &q : s.queues){ // left over from a closed log
+		q->tail.store(q->head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+	s.stop = false;
+	s.writer = std::thread(writer_loop);
+	enabled.store(true);
+	return true;
+}
+
+void BinLog::Close(){
+	log_state &s = state();
+	{
+		std::lock_guard<std::mutex> lock(s.mutex);
+		if (!s.file){ return; }
+		enabled.store(false);
+		s.stop = true;
+	}
+	s.wake.notify_one();
+	s.writer.join();
+	drain(s);
+	std::lock_guard<std::mutex> lock(s.mutex);
+	std::fclose(s.file);
+	s.file = nullptr;
+}
+
+uint64_t BinLog::Dropped(){
+	log_state &s = state();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	uint64_t dropped = 0;
+	for (const auto &q : s.queues){ dropped += q->dropped.load(std::memory_order_relaxed); }
+	return dropped;
+}
+
+uint16_t BinLog::Register(Log_Level level, const char *file, int line, const char *format){
+	log_state &s = state();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	uint16_t id = s.next_id++;
+	const char *base = std::strrchr(file, '/');
+	append(s.formats, Log_Format_Record);
+	append(s.formats, id);
+	append(s.formats, uint8_t(level));
+	append(s.formats, uint16_t(line));
+	append_text(s.formats, base ? base + 1 : file);
+	append_text(s.formats, format);
+	return id;
+}
+
+void BinLog::push(uint16_t id, const char *payload, size_t n){
+	log_queue *q = queue_of_thread();
+	uint32_t head = q->head.load(std::memory_order_relaxed);
+	if (head - q->tail.load(std::memory_order_acquire) >= Queue_Slots){
+		q->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	uint16_t size = uint16_t(n);
+	log_queue::slot &slot = q->slots[head % Queue_Slots];
+	char *out = slot.data;
+	*out++ = char(Log_Entry_Record);
+	std::memcpy(out, &id, 2); out += 2;
+	std::memcpy(out, &q->thread, 2); out += 2;
+	std::memcpy(out, &time, 8); out += 8;
+	std::memcpy(out, &size, 2); out += 2;
+	std::memcpy(out, payload, n);
+	slot.size = uint16_t(Entry_Header + n);
+	q->head.store(head + 1, std::memory_order_release);
+}
+
+void BinLog::put_string(char *out, size_t &n, const char *value, size_t length){
+	if (n + 3 > Max_Payload){ return; }
+	length = std::min(length, Max_Payload - n - 3);
+	uint16_t size = uint16_t(length);
+	out[n++] = Log_String;
+	std::memcpy(out + n, &size, 2);
+	std::memcpy(out + n + 2, value, length);
+	n += 2 + length;
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,406 @@
+/**
+ * @file /src/cbs_planner.cpp
+ *
+ * @brief Conflict-based search over an occupancy grid.
+ *
+ * The constraint tree is searched with a focal list: among the nodes whose
+ * sum of path lengths is within the suboptimality factor of the best one,
+ * the node with the fewest conflicts goes first. The low level is a
+ * space-time A* per uav that breaks ties on conflicts with the other
+ * paths. Both keep the tree small when the fleet is dense.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include "../include/outdoor_gcs/cbs_planner.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+	struct constraint
+	{
+		int agent;
+		int t;
+		int cell;
+		int from; // -1: vertex constraint, else no move from -> cell arriving at t
+	};
+
+	struct conflict
+	{
+		int a, b;
+		int t;
+		int cell_a, cell_b; // vertex: both the shared cell; edge: the cells a and b arrive at
+		bool edge;
+	};
+
+	struct ct_node
+	{
+		std::vector<constraint> cons;
+		std::vector<std::vector<int> > paths;
+		int cost;
+		int conflicts;
+	};
+
+uint64_t key(int t, int cell){
+	return (uint64_t(uint32_t(t)) << 32) | uint32_t(cell);
+}
+
+int at(const std::vector<int> &path, int t){
+	return t < int(path.size()) ? path[t] : path.back();
+}
+
+class Search {
+public:
+	Search(const OccupancyGrid &grid, clock_type::time_point deadline, double suboptimality)
+		: grid(grid), deadline(deadline), suboptimality(suboptimality), nx(grid.Nx()), nxy(grid.Nx()*grid.Ny()) {}
+
+	bool Timed_Out() const { return clock_type::now() > deadline; }
+
+	int Heuristic(int a, int b) const {
+		return std::abs(a%nx - b%nx) + std::abs((a/nx)%grid.Ny() - (b/nx)%grid.Ny()) + std::abs(a/nxy - b/nxy);
+	}
+
+	// Face neighbours that are free, plus the cell itself when wait is set
+	int Neighbours(int cell, int out[7], bool wait) const {
+		int x = cell%nx, y = (cell/nx)%grid.Ny(), z = cell/nxy, n = 0;
+		static const int d[6][3] = {{1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1}};
+		if (wait){ out[n++] = cell; }
+		for (int i = 0; i < 6; i++) {
+			if (!grid.Blocked(x+d[i][0], y+d[i][1], z+d[i][2])){
+				out[n++] = grid.Index(x+d[i][0], y+d[i][1], z+d[i][2]);
+			}
+		}
+		return n;
+	}
+
+	// Shortest static path length, -1 if unreachable
+	int Distance(int start, int goal) const {
+		typedef std::pair<int,int> item; // f, cell
+		std::priority_queue<item, std::vector<item>, std::greater<item> > open;
+		std::unordered_map<int,int> g;
+		g[start] = 0;
+		open.push(item(Heuristic(start, goal), start));
+		int nb[7];
+		while (!open.empty()) {
+			int cell = open.top().second;
+			open.pop();
+			int gc = g[cell];
+			if (cell == goal){ return gc; }
+			int n = Neighbours(cell, nb, false);
+			for (int i = 0; i < n; i++) {
+				auto it = g.find(nb[i]);
+				if (it != g.end() && it->second <= gc+1){ continue; }
+				g[nb[i]] = gc+1;
+				open.push(item(gc+1 + Heuristic(nb[i], goal), nb[i]));
+			}
+		}
+		return -1;
+	}
+
+	// Space-time A* for one agent under its constraints, avoiding the other paths where it is free to
+	bool Path(int agent, int start, int goal, int horizon, const std::vector<constraint> &cons,
+			const std::vector<std::vector<int> > &paths, std::vector<int> &path) const {
+		std::unordered_set<uint64_t> vertex;
+		std::unordered_multimap<uint64_t,int> edge;
+		int goal_until = -1;
+		for (const auto &c : cons){
+			if (c.agent != agent){ continue; }
+			if (c.from < 0){
+				vertex.insert(key(c.t, c.cell));
+				if (c.cell == goal && c.t > goal_until){ goal_until = c.t; }
+			} else{
+				edge.insert(std::make_pair(key(c.t, c.cell), c.from));
+			}
+		}
+		// Conflict avoidance table of the other agents
+		std::unordered_map<uint64_t,int> reserved;
+		std::unordered_map<int,int> parked; // goal cell -> step from which it is held
+		for (size_t b = 0; b < paths.size(); b++) {
+			if (int(b) == agent || paths[b].empty()){ continue; }
+			for (size_t t = 0; t < paths[b].size(); t++) {
+				reserved[key(t, paths[b][t])]++;
+			}
+			parked[paths[b].back()] = paths[b].size()-1;
+		}
+		auto conflicts = [&](int t, int cell){
+			auto r = reserved.find(key(t, cell));
+			auto p = parked.find(cell);
+			return (r == reserved.end() ? 0 : r->second) + (p != parked.end() && p->second <= t ? 1 : 0);
+		};
+
+		// Focal search: open is ordered on f = t + h, focal holds the entries
+		// with f within the bound and is ordered on conflicts, deeper first
+		struct node { int cell, t, parent, conflicts; };
+		typedef std::pair<int,int> open_entry; // f, node
+		typedef std::pair<std::pair<int,int>, int> focal_entry; // (conflicts, -t), node
+		std::vector<node> nodes;
+		std::set<open_entry> open;
+		std::set<focal_entry> focal;
+		std::unordered_map<uint64_t,int> best; // conflicts on the best route to (t, cell)
+		auto push = [&](int cell, int t, int parent, int c, int bound){
+			nodes.push_back(node{cell, t, parent, c});
+			int index = nodes.size()-1;
+			int f = t + Heuristic(cell, goal);
+			open.insert(open_entry(f, index));
+			if (f <= bound){ focal.insert(focal_entry(std::make_pair(c, -t), index)); }
+		};
+		int f_min = Heuristic(start, goal);
+		int bound = int(f_min*suboptimality);
+		best[key(0, start)] = 0;
+		push(start, 0, -1, 0, bound);
+		int nb[7];
+		int pops = 0;
+		while (!focal.empty()) {
+			int index = focal.begin()->second;
+			focal.erase(focal.begin());
+			const node cur = nodes[index];
+			open.erase(open_entry(cur.t + Heuristic(cur.cell, goal), index));
+			if (best[key(cur.t, cur.cell)] >= cur.conflicts){
+				if (cur.cell == goal && cur.t > goal_until){
+					path.assign(cur.t+1, 0);
+					for (int i = index; i >= 0; i = nodes[i].parent) {
+						path[nodes[i].t] = nodes[i].cell;
+					}
+					return true;
+				}
+				if ((++pops & 255) == 0 && Timed_Out()){ return false; }
+				int t = cur.t+1;
+				int n = cur.t < horizon ? Neighbours(cur.cell, nb, true) : 0;
+				for (int i = 0; i < n; i++) {
+					int next = nb[i];
+					if (vertex.count(key(t, next))){ continue; }
+					auto range = edge.equal_range(key(t, next));
+					bool banned = false;
+					for (auto it = range.first; it != range.second; ++it){
+						if (it->second == cur.cell){ banned = true; }
+					}
+					if (banned){ continue; }
+					int c = cur.conflicts + conflicts(t, next);
+					auto it = best.find(key(t, next));
+					if (it != best.end() && it->second <= c){ continue; }
+					best[key(t, next)] = c;
+					push(next, t, index, c, bound);
+				}
+			}
+			// Widen the focal list when the lowest f in open has grown
+			if (!open.empty() && open.begin()->first > f_min){
+				f_min = open.begin()->first;
+				int widened = int(f_min*suboptimality);
+				for (auto it = open.lower_bound(open_entry(bound+1, 0)); it != open.end() && it->first <= widened; ++it){
+					const node &o = nodes[it->second];
+					focal.insert(focal_entry(std::make_pair(o.conflicts, -o.t), it->second));
+				}
+				bound = widened;
+			}
+		}
+		return false;
+	}
+
+private:
+	const OccupancyGrid &grid;
+	clock_type::time_point deadline;
+	double suboptimality;
+	int nx, nxy;
+};
+
+// Counts the conflicts between all paths, first holds the earliest one
+int find_conflicts(const std::vector<std::vector<int> > &paths, conflict &first){
+	int makespan = 0, count = 0;
+	for (const auto &p : paths){
+		makespan = std::max(makespan, int(p.size()));
+	}
+	first.t = -1;
+	std::unordered_map<int,int> now, next;
+	for (size_t a = 0; a < paths.size(); a++) {
+		now[at(paths[a], 0)] = a;
+	}
+	for (int t = 0; t < makespan; t++) {
+		next.clear();
+		for (size_t a = 0; a < paths.size(); a++) {
+			int cell = at(paths[a], t+1);
+			auto it = next.find(cell);
+			if (it == next.end()){
+				next[cell] = a;
+				continue;
+			}
+			if (first.t < 0){ first = conflict{it->second, int(a), t+1, cell, cell, false}; }
+			count++;
+		}
+		for (size_t a = 0; a < paths.size(); a++) {
+			int u = at(paths[a], t), v = at(paths[a], t+1);
+			if (u == v){ continue; }
+			auto it = now.find(v);
+			if (it == now.end() || it->second <= int(a)){ continue; } // each swap once
+			int b = it->second;
+			if (at(paths[b], t+1) != u){ continue; }
+			if (first.t < 0 || first.t > t+1){ first = conflict{int(a), b, t+1, v, u, true}; }
+			count++;
+		}
+		now.swap(next);
+	}
+	return count;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+CbsPlanner::CbsPlanner(const OccupancyGrid &grid, double budget, double suboptimality) :
+	grid(grid),
+	budget(budget),
+	suboptimality(std::max(1.0, suboptimality))
+{}
+
+bool CbsPlanner::Plan(const std::vector<grid_cell> &start, const std::vector<grid_cell> &goal,
+		std::vector<std::vector<grid_cell> > &paths, cbs_stat &stat) const {
+	clock_type::time_point t0 = clock_type::now();
+	auto deadline = t0 + std::chrono::microseconds(int64_t(budget*1e6));
+	stat = cbs_stat();
+	stat.agents = start.size();
+	paths.clear();
+	auto finish = [&](bool ok){
+		stat.solved = ok;
+		stat.time_ms = std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+		return ok;
+	};
+	if (!grid.Loaded() || start.size() != goal.size()){
+		stat.error = "no map or bad input";
+		return finish(false);
+	}
+
+	Search search(grid, deadline, suboptimality);
+	int n = start.size();
+	std::vector<int> s(n), g(n);
+	std::unordered_map<int,int> used_start, used_goal;
+	int horizon = 0;
+	for (int i = 0; i < n; i++) {
+		if (grid.Blocked(start[i][0], start[i][1], start[i][2]) || grid.Blocked(goal[i][0], goal[i][1], goal[i][2])){
+			stat.agent = i;
+			stat.error = "start or goal blocked";
+			return finish(false);
+		}
+		s[i] = grid.Index(start[i][0], start[i][1], start[i][2]);
+		g[i] = grid.Index(goal[i][0], goal[i][1], goal[i][2]);
+		if (used_start.count(s[i]) || used_goal.count(g[i])){
+			stat.agent = i;
+			stat.error = "shares a start or goal cell";
+			return finish(false);
+		}
+		used_start[s[i]] = i;
+		used_goal[g[i]] = i;
+		int d = search.Distance(s[i], g[i]);
+		if (d < 0){
+			stat.agent = i;
+			stat.error = "goal unreachable";
+			return finish(false);
+		}
+		horizon = std::max(horizon, d);
+	}
+	// Room for detours and waits, grows with the fleet
+	horizon = 2*horizon + 4*n + 16;
+
+	std::deque<ct_node> tree;
+	typedef std::pair<int,int> entry; // cost, node
+	std::set<entry> open;
+
+	ct_node root;
+	root.paths.resize(n);
+	root.cost = 0;
+	for (int i = 0; i < n; i++) {
+		if (!search.Path(i, s[i], g[i], horizon, root.cons, root.paths, root.paths[i])){
+			stat.agent = search.Timed_Out() ? -1 : i;
+			stat.error = search.Timed_Out() ? "time budget exceeded" : "no path";
+			return finish(false);
+		}
+		root.cost += root.paths[i].size()-1;
+	}
+	conflict first;
+	root.conflicts = find_conflicts(root.paths, first);
+	tree.push_back(root);
+	open.insert(entry(root.cost, 0));
+
+	while (!open.empty()) {
+		// Focal search: fewest conflicts among the nodes within the suboptimality bound
+		int bound = int(open.begin()->first*suboptimality);
+		auto pick = open.begin();
+		for (auto it = open.begin(); it != open.end() && it->first <= bound; ++it){
+			if (tree[it->second].conflicts < tree[pick->second].conflicts){ pick = it; }
+		}
+		int index = pick->second;
+		open.erase(pick);
+		stat.nodes++;
+		if (search.Timed_Out()){
+			stat.error = "time budget exceeded";
+			return finish(false);
+		}
+		if (find_conflicts(tree[index].paths, first) == 0){
+			const ct_node &best = tree[index];
+			paths.resize(n);
+			for (int i = 0; i < n; i++) {
+				for (int cell : best.paths[i]){
+					paths[i].push_back(grid_cell{{cell%grid.Nx(), (cell/grid.Nx())%grid.Ny(), cell/(grid.Nx()*grid.Ny())}});
+				}
+				stat.makespan = std::max(stat.makespan, int(best.paths[i].size())-1);
+			}
+			stat.cost = best.cost;
+			return finish(true);
+		}
+		// Split on the earliest conflict, one child per uav involved
+		for (int side = 0; side < 2; side++) {
+			int agent = side == 0 ? first.a : first.b;
+			constraint c;
+			c.agent = agent;
+			c.t = first.t;
+			if (first.edge){
+				c.cell = side == 0 ? first.cell_a : first.cell_b;
+				c.from = side == 0 ? first.cell_b : first.cell_a;
+			} else{
+				c.cell = first.cell_a;
+				c.from = -1;
+			}
+			ct_node child;
+			child.cons = tree[index].cons;
+			child.cons.push_back(c);
+			child.paths = tree[index].paths;
+			if (!search.Path(agent, s[agent], g[agent], horizon, child.cons, child.paths, child.paths[agent])){ continue; }
+			child.cost = tree[index].cost - (int(tree[index].paths[agent].size())-1) + (int(child.paths[agent].size())-1);
+			conflict unused;
+			child.conflicts = find_conflicts(child.paths, unused);
+			tree.push_back(child);
+			open.insert(entry(child.cost, int(tree.size())-1));
+		}
+		// The parent is done with, keep its slot but free its memory
+		std::vector<constraint>().swap(tree[index].cons);
+		std::vector<std::vector<int> >().swap(tree[index].paths);
+	}
+	stat.error = search.Timed_Out() ? "time budget exceeded" : "no conflict-free solution";
+	return finish(false);
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,155 @@
+/**
+ * @file /src/clock_sync.cpp
+ *
+ * @brief Offset and drift between the clock of each vehicle and the GCS.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "../include/outdoor_gcs/clock_sync.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const size_t Min_Fit = 5; // seconds with samples before the drift is fitted
+const double Min_Span = 10.0; // [s]
+
+// Least squares offset = a + b*(t - t_mean) over the samples of keep
+template <class Sample>
+void fit_line(const std::vector<const Sample *> &keep, double &a, double &b, double &t_mean){
+	t_mean = 0;
+	a = 0;
+	for (const auto &s : keep){
+		t_mean += s->t;
+		a += s->offset;
+	}
+	t_mean /= keep.size();
+	a /= keep.size();
+	double stt = 0, sto = 0;
+	for (const auto &s : keep){
+		stt += (s->t - t_mean)*(s->t - t_mean);
+		sto += (s->t - t_mean)*(s->offset - a);
+	}
+	b = stt > 0 ? sto/stt : 0;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+ClockSync::ClockSync(int uavs) {
+	for (int k = 0; k < uavs; k++) {
+		lanes.emplace_back(new lane);
+	}
+}
+
+void ClockSync::Configure(double w){
+	window = std::max(w, Min_Span);
+}
+
+void ClockSync::Add_Exchange(int uav, double t0, double t1, double t2, double t3){
+	double delay = (t3 - t0) - (t2 - t1);
+	if (delay < 0){ return; } // reordered or bogus
+	lane &l = *lanes[uav];
+	std::lock_guard<std::mutex> lock(l.mutex);
+	add(l, l.exchange, {t3, ((t0 - t1) + (t3 - t2))/2, delay});
+}
+
+void ClockSync::Add_Passive(int uav, double stamp, double received){
+	lane &l = *lanes[uav];
+	std::lock_guard<std::mutex> lock(l.mutex);
+	add(l, l.passive, {received, received - stamp, received - stamp});
+}
+
+double ClockSync::To_GCS(int uav, double stamp) const {
+	const lane &l = *lanes[uav];
+	std::lock_guard<std::mutex> lock(l.mutex);
+	const clock_estimate &e = l.estimate;
+	if (e.source == Clock_None){ return stamp; }
+	return stamp + e.offset + e.drift*(stamp + e.offset - e.t_ref);
+}
+
+clock_estimate ClockSync::Estimate(int uav) const {
+	const lane &l = *lanes[uav];
+	std::lock_guard<std::mutex> lock(l.mutex);
+	return l.estimate;
+}
+
+void ClockSync::add(lane &l, std::deque<clock_sample> &bins, const clock_sample &s){
+	if (!bins.empty() && std::floor(s.t) <= std::floor(bins.back().t)){ // passive arrivals may come out of order
+		if (s.delay >= bins.back().delay){ return; }
+		double t = std::max(s.t, bins.back().t); // the bin stays in its second
+		bins.back() = s;
+		bins.back().t = t;
+	} else{
+		bins.push_back(s);
+	}
+	while (!bins.empty() && bins.front().t < s.t - window) {
+		bins.pop_front();
+	}
+	while (!l.exchange.empty() && l.exchange.front().t < s.t - window) { // responder gone quiet
+		l.exchange.pop_front();
+	}
+	l.estimate = l.exchange.empty() ? fit(l.passive, Clock_Passive) : fit(l.exchange, Clock_Exchange);
+}
+
+clock_estimate ClockSync::fit(const std::deque<clock_sample> &bins, Clock_Source source){
+	clock_estimate e;
+	if (bins.empty()){ return e; }
+	e.source = source;
+	e.samples = bins.size();
+	const clock_sample *best = &bins.front();
+	for (const auto &s : bins){
+		if (s.delay < best->delay){ best = &s; }
+	}
+	e.offset = best->offset;
+	e.t_ref = best->t;
+	e.delay = source == Clock_Exchange ? best->delay : -1;
+	if (bins.size() < Min_Fit || bins.back().t - bins.front().t < Min_Span){ return e; }
+
+	// Congestion only ever delays a sample, so the line goes through the best seconds
+	std::vector<const clock_sample *> keep;
+	double a, b, t_mean;
+	if (source == Clock_Exchange){
+		std::vector<double> delays;
+		for (const auto &s : bins){ delays.push_back(s.delay); }
+		std::nth_element(delays.begin(), delays.begin() + delays.size()/4, delays.end());
+		double quartile = delays[delays.size()/4]; // the shortest round trips
+		for (const auto &s : bins){
+			if (s.delay <= quartile){ keep.push_back(&s); }
+		}
+	} else{
+		// Passive samples are offset + latency: keep those on or under a first line, the lower envelope
+		std::vector<const clock_sample *> all;
+		for (const auto &s : bins){ all.push_back(&s); }
+		fit_line(all, a, b, t_mean);
+		for (const auto &s : bins){
+			if (s.offset <= a + b*(s.t - t_mean)){ keep.push_back(&s); }
+		}
+	}
+	if (keep.size() < 2){ return e; }
+	fit_line(keep, a, b, t_mean);
+	e.t_ref = bins.back().t;
+	e.offset = a + b*(e.t_ref - t_mean);
+	e.drift = b;
+	return e;
+}
+
+}  // namespace outdoor_gcs
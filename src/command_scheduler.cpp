@@ -0,0 +1,246 @@
+/**
+ * @file /src/command_scheduler.cpp
+ *
+ * @brief Timed fleet commands on a hierarchical timer wheel.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "../include/outdoor_gcs/binlog.hpp"
+#include "../include/outdoor_gcs/command_scheduler.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const int Level0_Bits = 8; // 256 slots of 1 ms
+const int Level_Bits = 6; // 64 slots on the upper levels
+const size_t Recent_Size = 32;
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+CommandScheduler::CommandScheduler(int num) :
+	epoch(clock_type::now())
+{
+	wheel[0].resize(1 << Level0_Bits);
+	for (int level = 1; level < Levels; level++) {
+		wheel[level].resize(1 << Level_Bits);
+	}
+	now_tick = ticks_now();
+	for (int i = 0; i < num; i++) {
+		lanes.push_back(std::unique_ptr<lane_worker>(new lane_worker));
+	}
+	for (auto &lane : lanes) {
+		lane->thread = std::thread(&CommandScheduler::lane_loop, this, std::ref(*lane));
+	}
+	wheel_thread = std::thread(&CommandScheduler::wheel_loop, this);
+}
+
+CommandScheduler::~CommandScheduler() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop = true;
+	}
+	wake.notify_all();
+	wheel_thread.join();
+	for (auto &lane : lanes) {
+		{
+			std::lock_guard<std::mutex> lock(lane->mutex);
+			lane->stop = true;
+		}
+		lane->wake.notify_all();
+		lane->thread.join();
+	}
+}
+
+double CommandScheduler::Wall_Now(){
+	return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t CommandScheduler::ticks_now() const {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(clock_type::now() - epoch).count();
+}
+
+uint64_t CommandScheduler::Schedule(double at, int lane, const std::string &label, const action &f){
+	// Wall time to steady ticks once, so a clock step after this does not move the release
+	double due_ms = std::chrono::duration<double, std::milli>(clock_type::now() - epoch).count() + (at - Wall_Now())*1e3;
+	entry e = {0, int64_t(std::ceil(due_ms)), lane, at, label, f};
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		e.id = next_id++;
+		if (pending == 0){ now_tick = std::max(now_tick, ticks_now()); } // wheel thread idle, catch it up
+		insert(e);
+		pending++;
+	}
+	wake.notify_one();
+	return e.id;
+}
+
+bool CommandScheduler::Cancel(uint64_t id){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto erase = [&](std::vector<entry> &slot){
+		for (size_t k = 0; k < slot.size(); k++) {
+			if (slot[k].id == id){
+				slot.erase(slot.begin() + k);
+				pending--;
+				return true;
+			}
+		}
+		return false;
+	};
+	for (int level = 0; level < Levels; level++) {
+		for (auto &slot : wheel[level]) {
+			if (erase(slot)){ return true; }
+		}
+	}
+	return erase(overflow);
+}
+
+int CommandScheduler::Cancel_All(){
+	std::lock_guard<std::mutex> lock(mutex);
+	for (int level = 0; level < Levels; level++) {
+		for (auto &slot : wheel[level]) {
+			slot.clear();
+		}
+	}
+	overflow.clear();
+	int cancelled = pending;
+	pending = 0;
+	return cancelled;
+}
+
+int CommandScheduler::Pending(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return pending;
+}
+
+std::vector<outdoor_gcs::sched_record> CommandScheduler::Recent(){
+	std::lock_guard<std::mutex> lock(recent_mutex);
+	return std::vector<sched_record>(recent.begin(), recent.end());
+}
+
+void CommandScheduler::insert(entry &e){
+	int64_t t = std::max(e.tick, now_tick); // late ones go out on the next tick
+	int64_t delta = t - now_tick;
+	if (delta < (1 << Level0_Bits)){
+		wheel[0][t & ((1 << Level0_Bits) - 1)].push_back(std::move(e));
+		return;
+	}
+	int shift = Level0_Bits;
+	for (int level = 1; level < Levels; level++, shift += Level_Bits) {
+		if (delta < (int64_t(1) << (shift + Level_Bits))){
+			wheel[level][(t >> shift) & ((1 << Level_Bits) - 1)].push_back(std::move(e));
+			return;
+		}
+	}
+	overflow.push_back(std::move(e));
+}
+
+void CommandScheduler::cascade(std::vector<entry> &slot){
+	std::vector<entry> moved;
+	moved.swap(slot);
+	for (auto &e : moved) {
+		insert(e);
+	}
+}
+
+void CommandScheduler::advance(){
+	now_tick++;
+	if (now_tick & ((1 << Level0_Bits) - 1)){ return; }
+	// Entering a new level 0 revolution: spread the next slot of level 1 over it, and so on up
+	int64_t t = now_tick >> Level0_Bits;
+	for (int level = 1; level < Levels; level++, t >>= Level_Bits) {
+		int index = t & ((1 << Level_Bits) - 1);
+		cascade(wheel[level][index]);
+		if (index){ return; }
+	}
+	cascade(overflow);
+}
+
+void CommandScheduler::wheel_loop(){
+	std::unique_lock<std::mutex> lock(mutex);
+	std::vector<entry> due;
+	while (!stop) {
+		if (pending == 0){
+			wake.wait(lock, [this]{ return stop || pending > 0; });
+			continue;
+		}
+		int64_t target = ticks_now();
+		while (now_tick <= target && pending > 0) {
+			due.clear();
+			due.swap(wheel[0][now_tick & ((1 << Level0_Bits) - 1)]);
+			advance();
+			if (due.empty()){ continue; }
+			pending -= due.size();
+			lock.unlock();
+			for (auto &e : due) {
+				run(e);
+			}
+			lock.lock();
+		}
+		if (pending == 0){
+			now_tick = std::max(now_tick, ticks_now()); // nothing to cascade, skip the idle ticks
+			continue;
+		}
+		wake.wait_until(lock, epoch + std::chrono::milliseconds(now_tick));
+	}
+}
+
+void CommandScheduler::run(entry &e){
+	if (e.lane < 0 || e.lane >= int(lanes.size())){
+		execute(e);
+		return;
+	}
+	lane_worker &lane = *lanes[e.lane];
+	{
+		std::lock_guard<std::mutex> lock(lane.mutex);
+		lane.queue.push_back(std::move(e));
+	}
+	lane.wake.notify_one();
+}
+
+void CommandScheduler::execute(entry &e){
+	double start = Wall_Now();
+	e.f();
+	double end = Wall_Now();
+	skew.Add(std::fabs(start - e.at));
+	GCS_LOG(Log_Info, "scheduler: %s on lane %d, %.3f ms late, ran %.3f ms", e.label, e.lane, (start - e.at)*1e3,
+			(end - start)*1e3);
+	std::lock_guard<std::mutex> lock(recent_mutex);
+	recent.push_back({e.id, e.label, e.lane, e.at, float((start - e.at)*1e3), float((end - start)*1e3)});
+	if (recent.size() > Recent_Size){ recent.pop_front(); }
+}
+
+void CommandScheduler::lane_loop(lane_worker &lane){
+	while (true) {
+		entry e;
+		{
+			std::unique_lock<std::mutex> lock(lane.mutex);
+			lane.wake.wait(lock, [&lane]{ return lane.stop || !lane.queue.empty(); });
+			if (lane.queue.empty()){ return; }
+			e = std::move(lane.queue.front());
+			lane.queue.pop_front();
+		}
+		execute(e);
+	}
+}
+
+}  // namespace outdoor_gcs
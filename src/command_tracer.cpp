@@ -0,0 +1,106 @@
+/**
+ * @file /src/command_tracer.cpp
+ *
+ * @brief Command to execution latency of every uav, from the echoed Command_ID.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include "../include/outdoor_gcs/command_tracer.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+bool older(uint32_t a, uint32_t b){ // a sent before b, across a wrap of the ids
+	return int32_t(a - b) < 0;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+CommandTracer::CommandTracer(int uavs) {
+	for (int k = 0; k < uavs; k++) {
+		lanes.emplace_back(new lane);
+	}
+}
+
+void CommandTracer::Configure(double t){
+	timeout = t;
+}
+
+void CommandTracer::Sent(int uav, uint32_t id, double now){
+	lane &l = *lanes[uav];
+	std::lock_guard<std::mutex> lock(l.mutex);
+	l.stat.sent++;
+	// The stream thread and the loop draw ids from one counter, so a late one may land out of order
+	auto it = l.open.end();
+	while (it != l.open.begin() && older(id, (it-1)->id)) { it--; }
+	l.open.insert(it, {id, now});
+	if (l.open.size() > Window){
+		l.open.pop_front();
+		l.stat.dropped++;
+	}
+}
+
+void CommandTracer::Echoed(int uav, uint32_t id, double now){
+	lane &l = *lanes[uav];
+	std::lock_guard<std::mutex> lock(l.mutex);
+	if (l.echoed && id == l.last_echo){ return; } // still executing it
+	if (l.echoed && older(id, l.last_echo)){
+		l.stat.out_of_order++;
+		return;
+	}
+	size_t k = 0;
+	while (k < l.open.size() && l.open[k].id != id) { k++; }
+	if (k == l.open.size()){
+		if (id != l.last_unmatched){ l.stat.unmatched++; }
+		l.last_unmatched = id;
+		return;
+	}
+	float latency = now - l.open[k].time;
+	l.latency.Add(latency);
+	l.stat.executed++;
+	l.stat.superseded += k;
+	l.stat.last_ms = latency*1e3;
+	l.open.erase(l.open.begin(), l.open.begin() + k + 1);
+	l.echoed = true;
+	l.last_echo = id;
+}
+
+int CommandTracer::Check(double now){
+	int dropped = 0;
+	for (const auto &lp : lanes){
+		lane &l = *lp;
+		std::lock_guard<std::mutex> lock(l.mutex);
+		while (!l.open.empty() && now - l.open.front().time > timeout) {
+			l.open.pop_front();
+			l.stat.dropped++;
+			dropped++;
+		}
+	}
+	return dropped;
+}
+
+trace_stat CommandTracer::Stat(int uav){
+	lane &l = *lanes[uav];
+	std::lock_guard<std::mutex> lock(l.mutex);
+	return l.stat;
+}
+
+}  // namespace outdoor_gcs
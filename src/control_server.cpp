@@ -0,0 +1,226 @@
+/**
+ * @file /src/control_server.cpp
+ *
+ * @brief Local control and telemetry socket of the GCS backend.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../include/outdoor_gcs/control_server.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const size_t Max_Line = 4096; // longer lines disconnect the client
+const size_t Max_Requests = 256; // waiting for the loop, further lines are refused
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+ControlServer::~ControlServer() {
+	if (listen_fd < 0){ return; }
+	stop = true;
+	ssize_t n = ::write(wake_pipe[1], "x", 1);
+	(void)n;
+	server.join();
+	for (const auto &c : clients){
+		::close(c.second.fd);
+	}
+	::close(listen_fd);
+	::close(wake_pipe[0]);
+	::close(wake_pipe[1]);
+	::unlink(path.c_str());
+}
+
+bool ControlServer::Open(const std::string &socket_path, std::string &error){
+	if (listen_fd >= 0){
+		error = "already open";
+		return false;
+	}
+	sockaddr_un addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (socket_path.size() >= sizeof(addr.sun_path)){
+		error = socket_path + ": path too long";
+		return false;
+	}
+	std::strcpy(addr.sun_path, socket_path.c_str());
+	// A socket file nobody accepts on is left over from a crash
+	if (Listening(socket_path)){
+		error = socket_path + ": another GCS is listening";
+		return false;
+	}
+	int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0){
+		error = std::string("socket: ") + std::strerror(errno);
+		return false;
+	}
+	::unlink(socket_path.c_str());
+	if (::bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0 || ::listen(fd, 8) < 0 || ::pipe2(wake_pipe, O_CLOEXEC) < 0){
+		error = socket_path + ": " + std::strerror(errno);
+		::close(fd);
+		return false;
+	}
+	path = socket_path;
+	listen_fd = fd;
+	server = std::thread(&ControlServer::serve_loop, this);
+	return true;
+}
+
+bool ControlServer::Listening(const std::string &socket_path){
+	sockaddr_un addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (socket_path.empty() || socket_path.size() >= sizeof(addr.sun_path)){ return false; }
+	std::strcpy(addr.sun_path, socket_path.c_str());
+	int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0){ return false; }
+	bool listening = ::connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0;
+	::close(fd);
+	return listening;
+}
+
+std::vector<control_request> ControlServer::Take(){
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<control_request> out(requests.begin(), requests.end());
+	requests.clear();
+	return out;
+}
+
+void ControlServer::Reply(int id, const std::string &text){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = clients.find(id);
+	if (it != clients.end()){ send_to(id, it->second, text); }
+}
+
+void ControlServer::Watch(int id, bool on){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = clients.find(id);
+	if (it != clients.end()){ it->second.watch = on; }
+}
+
+void ControlServer::Publish(const std::string &frame){
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<int> ids;
+	for (const auto &c : clients){
+		if (c.second.watch){ ids.push_back(c.first); }
+	}
+	for (const auto &id : ids){
+		send_to(id, clients[id], frame);
+	}
+}
+
+int ControlServer::Clients(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return clients.size();
+}
+
+int ControlServer::Watchers(){
+	std::lock_guard<std::mutex> lock(mutex);
+	int n = 0;
+	for (const auto &c : clients){
+		n += c.second.watch;
+	}
+	return n;
+}
+
+void ControlServer::send_to(int id, client &c, const std::string &text){
+	// Under mutex. All or nothing: a partial frame would corrupt the stream of the client
+	std::string out = text;
+	if (!out.empty() && out.back() != '\n'){ out += '\n'; }
+	out += ".\n";
+	ssize_t n = ::send(c.fd, out.data(), out.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+	if (n != ssize_t(out.size())){
+		drop(id);
+	}
+}
+
+void ControlServer::drop(int id){
+	// Under mutex; the server thread sees the closed fd is gone on its next poll
+	auto it = clients.find(id);
+	if (it == clients.end()){ return; }
+	::shutdown(it->second.fd, SHUT_RDWR);
+	::close(it->second.fd);
+	clients.erase(it);
+}
+
+void ControlServer::serve_loop(){
+	std::vector<pollfd> fds;
+	std::vector<int> ids;
+	char buf[1024];
+	while (!stop) {
+		fds.assign(1, pollfd{listen_fd, POLLIN, 0});
+		fds.push_back(pollfd{wake_pipe[0], POLLIN, 0});
+		ids.assign(2, 0);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (const auto &c : clients){
+				fds.push_back(pollfd{c.second.fd, POLLIN, 0});
+				ids.push_back(c.first);
+			}
+		}
+		// The timeout picks up clients dropped by the loop thread
+		if (::poll(fds.data(), fds.size(), 200) <= 0){ continue; }
+		if (fds[0].revents & POLLIN){
+			int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+			if (fd >= 0){
+				std::lock_guard<std::mutex> lock(mutex);
+				clients[next_id++].fd = fd;
+			}
+		}
+		for (size_t k = 2; k < fds.size(); k++) {
+			if (!fds[k].revents){ continue; }
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = clients.find(ids[k]);
+			if (it == clients.end() || it->second.fd != fds[k].fd){ continue; } // dropped meanwhile
+			ssize_t n = ::recv(fds[k].fd, buf, sizeof(buf), MSG_DONTWAIT);
+			if (n <= 0){
+				if (n < 0 && (errno == EAGAIN || errno == EINTR)){ continue; }
+				drop(ids[k]);
+				continue;
+			}
+			std::string &in = it->second.in;
+			in.append(buf, n);
+			size_t start = 0, end;
+			while ((end = in.find('\n', start)) != std::string::npos) {
+				std::string line = in.substr(start, end - start);
+				if (!line.empty() && line.back() == '\r'){ line.pop_back(); }
+				start = end + 1;
+				if (line.empty()){ continue; }
+				if (requests.size() >= Max_Requests){
+					send_to(ids[k], it->second, "error busy");
+					break;
+				}
+				requests.push_back({ids[k], line});
+			}
+			if (clients.count(ids[k]) == 0){ continue; }
+			in.erase(0, start);
+			if (in.size() > Max_Line){ drop(ids[k]); }
+		}
+	}
+}
+
+}  // namespace outdoor_gcs
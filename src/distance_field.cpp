@@ -0,0 +1,163 @@
+/**
+ * @file /src/distance_field.cpp
+ *
+ * @brief Signed Euclidean distance field of the occupancy grid.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include "../include/outdoor_gcs/distance_field.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const float inf = 1e20f;
+
+	struct edt_buffers
+	{
+		std::vector<float> g, z;
+		std::vector<int> v;
+		void resize(int n){
+			g.resize(n);
+			z.resize(n+1);
+			v.resize(n);
+		}
+	};
+
+// Squared distance transform of one line (lower envelope of parabolas, Felzenszwalb & Huttenlocher)
+void edt_line(float *f, int n, size_t stride, edt_buffers &b){
+	for (int q = 0; q < n; q++) {
+		b.g[q] = f[q*stride];
+	}
+	int k = -1;
+	for (int q = 0; q < n; q++) {
+		if (b.g[q] >= inf){ continue; }
+		float s = -inf;
+		while (k >= 0) {
+			int p = b.v[k];
+			s = ((b.g[q] + q*q) - (b.g[p] + p*p))/(2.0f*(q - p));
+			if (s > b.z[k]){ break; }
+			k--;
+			s = -inf;
+		}
+		k++;
+		b.v[k] = q;
+		b.z[k] = s;
+		b.z[k+1] = inf;
+	}
+	if (k < 0){ return; } // no site on this line
+	for (int q = 0, j = 0; q < n; q++) {
+		while (b.z[j+1] < q) { j++; }
+		int p = b.v[j];
+		f[q*stride] = (q - p)*(q - p) + b.g[p];
+	}
+}
+
+// Squared distance [cells^2] of every cell to the nearest cell with site set
+void edt_3d(std::vector<float> &f, int nx, int ny, int nz){
+	edt_buffers b;
+	b.resize(std::max(nx, std::max(ny, nz)));
+	size_t nxy = size_t(nx)*ny;
+	for (int z = 0; z < nz; z++) {
+		for (int y = 0; y < ny; y++) {
+			edt_line(&f[z*nxy + size_t(y)*nx], nx, 1, b);
+		}
+	}
+	for (int z = 0; z < nz; z++) {
+		for (int x = 0; x < nx; x++) {
+			edt_line(&f[z*nxy + x], ny, nx, b);
+		}
+	}
+	for (int y = 0; y < ny; y++) {
+		for (int x = 0; x < nx; x++) {
+			edt_line(&f[size_t(y)*nx + x], nz, nxy, b);
+		}
+	}
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+bool DistanceField::Build(const OccupancyGrid &grid){
+	cells.clear();
+	if (!grid.Loaded()){ return false; }
+	nx = grid.Nx();
+	ny = grid.Ny();
+	nz = grid.Nz();
+	resolution = grid.Resolution();
+	for (int i = 0; i < 3; i++) { origin[i] = grid.Origin()[i]; }
+	size_t n = size_t(nx)*ny*nz;
+
+	// Distance of free cells to the occupied ones and of occupied cells to the free ones
+	std::vector<float> out(n), in(n);
+	bool any = false;
+	for (int z = 0; z < nz; z++) {
+		for (int y = 0; y < ny; y++) {
+			for (int x = 0; x < nx; x++) {
+				size_t i = grid.Index(x, y, z);
+				bool occ = grid.Occupied(x, y, z);
+				out[i] = occ ? 0 : inf;
+				in[i] = occ ? inf : 0;
+				any = any || occ;
+			}
+		}
+	}
+	if (!any){ return false; }
+	edt_3d(out, nx, ny, nz);
+	edt_3d(in, nx, ny, nz);
+
+	// Cell centers are half a cell off the obstacle surface
+	std::vector<float> sdf(n);
+	for (size_t i = 0; i < n; i++) {
+		sdf[i] = out[i] > 0 ? (std::sqrt(out[i]) - 0.5f)*resolution : -(std::sqrt(in[i]) - 0.5f)*resolution;
+	}
+	std::vector<float>().swap(out);
+	std::vector<float>().swap(in);
+
+	bx = (nx + 7)/8;
+	by = (ny + 7)/8;
+	int bz = (nz + 7)/8;
+	cells.assign(size_t(bx)*by*bz*512, cell{inf, {0, 0, 0}, 0});
+	int size[3] = {nx, ny, nz};
+	for (int z = 0; z < nz; z++) {
+		for (int y = 0; y < ny; y++) {
+			for (int x = 0; x < nx; x++) {
+				int c[3] = {x, y, z};
+				float g[3], norm2 = 0;
+				for (int a = 0; a < 3; a++) { // central differences, one-sided on the border
+					int lo[3] = {x, y, z}, hi[3] = {x, y, z};
+					lo[a] = std::max(c[a]-1, 0);
+					hi[a] = std::min(c[a]+1, size[a]-1);
+					g[a] = hi[a] > lo[a] ? (sdf[grid.Index(hi[0], hi[1], hi[2])] - sdf[grid.Index(lo[0], lo[1], lo[2])])/(hi[a] - lo[a]) : 0;
+					norm2 += g[a]*g[a];
+				}
+				cell &s = cells[Offset(x, y, z)];
+				s.dist = sdf[grid.Index(x, y, z)];
+				float norm = std::sqrt(norm2);
+				for (int a = 0; a < 3; a++) {
+					s.grad[a] = norm > 0 ? int8_t(std::lround(127*g[a]/norm)) : 0;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,159 @@
+/**
+ * @file /src/event_log.cpp
+ *
+ * @brief Operator event log in a fixed-size ring, spilled to a file.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include "../include/outdoor_gcs/event_log.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const size_t Max_Spill = 1 << 16; // events waiting for the writer before new ones are dropped
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+EventLog::EventLog(size_t capacity) :
+	ring(capacity > 0 ? capacity : 1)
+	{}
+
+EventLog::~EventLog() {
+	if (!file){ return; }
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (uint64_t seq = end > ring.size() ? end - ring.size() : 0; seq < end; seq++) {
+			spill.push_back(ring[seq % ring.size()]);
+		}
+		stop = true;
+	}
+	wake.notify_one();
+	writer.join();
+	std::fclose(file);
+}
+
+bool EventLog::Open_Spill(const std::string &path, std::string &error){
+	if (file){
+		error = "already open";
+		return false;
+	}
+	file = std::fopen(path.c_str(), "a");
+	if (!file){
+		error = path + ": " + std::strerror(errno);
+		return false;
+	}
+	writer = std::thread(&EventLog::writer_loop, this);
+	return true;
+}
+
+uint64_t EventLog::Append(int uav, Event_Severity severity, int code, const std::string &text){
+	double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+	bool spilling = false;
+	uint64_t seq;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		seq = end++;
+		event_entry &slot = ring[seq % ring.size()];
+		if (seq >= ring.size()){ // evict the oldest
+			if (file && spill.size() < Max_Spill){
+				spill.push_back(std::move(slot));
+				spilling = true;
+			} else{
+				dropped++;
+			}
+		}
+		slot.seq = seq;
+		slot.time = now;
+		slot.uav = uav;
+		slot.severity = severity;
+		slot.code = code;
+		slot.text = text;
+	}
+	if (spilling){ wake.notify_one(); }
+	return seq;
+}
+
+uint64_t EventLog::First(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return end > ring.size() ? end - ring.size() : 0;
+}
+
+uint64_t EventLog::End(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return end;
+}
+
+bool EventLog::Get(uint64_t seq, event_entry &entry){
+	std::lock_guard<std::mutex> lock(mutex);
+	if (seq >= end || seq + ring.size() < end){ return false; }
+	entry = ring[seq % ring.size()];
+	return true;
+}
+
+uint64_t EventLog::Spilled(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return spilled;
+}
+
+uint64_t EventLog::Dropped(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return dropped;
+}
+
+std::string EventLog::Format(const event_entry &entry){
+	static const char *severity[] = {"INFO", "CMD", "WARN", "ERROR"};
+	time_t sec = time_t(entry.time);
+	struct tm local;
+	localtime_r(&sec, &local);
+	char stamp[32];
+	std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+	char head[96];
+	std::snprintf(head, sizeof(head), "%s.%03d %-5s %-5s %3d ", stamp, int((entry.time - sec)*1e3),
+			severity[entry.severity], entry.uav >= 0 ? ("uav" + std::to_string(entry.uav+1)).c_str() : "-", entry.code);
+	return head + entry.text;
+}
+
+void EventLog::writer_loop(){
+	std::deque<event_entry> batch;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		wake.wait(lock, [this]{ return stop || !spill.empty(); });
+		if (spill.empty()){ return; }
+		batch.swap(spill);
+		lock.unlock();
+		for (const auto &entry : batch){
+			std::string line = Format(entry);
+			line += '\n';
+			std::fwrite(line.data(), 1, line.size(), file);
+		}
+		std::fflush(file);
+		size_t written = batch.size();
+		batch.clear();
+		lock.lock();
+		spilled += written;
+	}
+}
+
+}  // namespace outdoor_gcs
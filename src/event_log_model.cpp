@@ -0,0 +1,73 @@
+/**
+ * @file /src/event_log_model.cpp
+ *
+ * @brief List model over the EventLog ring for the notice logger view.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <QBrush>
+#include <QDateTime>
+#include "../include/outdoor_gcs/event_log_model.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+EventLogModel::EventLogModel(EventLog &log, QObject *parent) :
+	QAbstractListModel(parent),
+	log(log)
+{
+	first = end = log.First();
+	Sync();
+}
+
+int EventLogModel::rowCount(const QModelIndex &parent) const {
+	return parent.isValid() ? 0 : int(end - first);
+}
+
+QVariant EventLogModel::data(const QModelIndex &index, int role) const {
+	event_entry entry;
+	if (!index.isValid() || !log.Get(first + index.row(), entry)){ return QVariant(); }
+	if (role == Qt::DisplayRole){
+		return QDateTime::fromMSecsSinceEpoch(qint64(entry.time*1e3)).toString("hh:mm:ss") + " : " +
+				QString::fromStdString(entry.text);
+	} else if (role == Qt::ForegroundRole){
+		static const Qt::GlobalColor colors[] = {Qt::darkGreen, Qt::blue, Qt::red, Qt::darkRed};
+		return QBrush(colors[entry.severity]);
+	}
+	return QVariant();
+}
+
+bool EventLogModel::Sync(){
+	uint64_t log_first = log.First(), log_end = log.End();
+	if (log_first == first && log_end == end){ return false; }
+	if (log_first > first){
+		uint64_t gone = std::min(log_first, end);
+		if (gone > first){
+			beginRemoveRows(QModelIndex(), 0, int(gone - first) - 1);
+			first = gone;
+			endRemoveRows();
+		}
+		if (first < log_first){ first = end = log_first; } // evicted before they were shown
+	}
+	if (log_end > end){
+		beginInsertRows(QModelIndex(), int(end - first), int(log_end - first) - 1);
+		end = log_end;
+		endInsertRows();
+	}
+	return true;
+}
+
+}  // namespace outdoor_gcs
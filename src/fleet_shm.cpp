@@ -0,0 +1,137 @@
+/**
+ * @file /src/fleet_shm.cpp
+ *
+ * @brief Fleet state in POSIX shared memory under a seqlock.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/outdoor_gcs/fleet_shm.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+FleetShmWriter::~FleetShmWriter() {
+	if (!shm){ return; }
+	::munmap(shm, sizeof(fleet_shm_layout));
+	::shm_unlink(name.c_str());
+}
+
+bool FleetShmWriter::Open(const std::string &shm_name, bool reuse, std::string &error){
+	if (shm){
+		error = "already open";
+		return false;
+	}
+	// A segment left by a crashed GCS may have another layout; readers still mapping it keep the old one
+	if (reuse){ ::shm_unlink(shm_name.c_str()); }
+	int fd = ::shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+	if (fd < 0 && errno == EEXIST){
+		error = shm_name + " exists: another GCS writes it or a crashed one left it, set ~fleet_shm_reuse to replace it";
+		return false;
+	}
+	if (fd < 0){
+		error = shm_name + ": " + std::strerror(errno);
+		return false;
+	}
+	if (::ftruncate(fd, sizeof(fleet_shm_layout)) < 0){
+		::shm_unlink(shm_name.c_str());
+		error = shm_name + ": " + std::strerror(errno);
+		::close(fd);
+		return false;
+	}
+	void *p = ::mmap(nullptr, sizeof(fleet_shm_layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (p == MAP_FAILED){
+		error = shm_name + ": " + std::strerror(errno);
+		return false;
+	}
+	shm = static_cast<fleet_shm_layout *>(p); // zero filled by ftruncate
+	shm->version = Fleet_Shm_Version;
+	shm->size = sizeof(fleet_shm_layout);
+	shm->capacity = Fleet_Shm_Capacity;
+	shm->seq.store(0, std::memory_order_relaxed);
+	shm->magic.store(Fleet_Shm_Magic, std::memory_order_release);
+	name = shm_name;
+	return true;
+}
+
+fleet_frame &FleetShmWriter::Begin(){
+	shm->seq.store(shm->seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release); // the odd sequence is seen before any field changes
+	return shm->frame;
+}
+
+void FleetShmWriter::End(){
+	shm->seq.store(shm->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+FleetShmReader::~FleetShmReader() {
+	if (shm){ ::munmap(const_cast<fleet_shm_layout *>(shm), sizeof(fleet_shm_layout)); }
+}
+
+bool FleetShmReader::Open(const std::string &shm_name, std::string &error){
+	if (shm){
+		error = "already open";
+		return false;
+	}
+	int fd = ::shm_open(shm_name.c_str(), O_RDONLY, 0);
+	if (fd < 0){
+		error = shm_name + ": " + std::strerror(errno);
+		return false;
+	}
+	struct stat st;
+	if (::fstat(fd, &st) < 0 || size_t(st.st_size) < sizeof(fleet_shm_layout)){
+		error = shm_name + ": not a fleet segment of this version";
+		::close(fd);
+		return false;
+	}
+	void *p = ::mmap(nullptr, sizeof(fleet_shm_layout), PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (p == MAP_FAILED){
+		error = shm_name + ": " + std::strerror(errno);
+		return false;
+	}
+	const fleet_shm_layout *s = static_cast<const fleet_shm_layout *>(p);
+	if (s->magic.load(std::memory_order_acquire) != Fleet_Shm_Magic || s->version != Fleet_Shm_Version || s->size != sizeof(fleet_shm_layout) ||
+			s->capacity != uint32_t(Fleet_Shm_Capacity)){
+		error = shm_name + ": not a fleet segment of this version";
+		::munmap(p, sizeof(fleet_shm_layout));
+		return false;
+	}
+	shm = s;
+	return true;
+}
+
+bool FleetShmReader::Read(fleet_frame &out, int tries) const {
+	for (int k = 0; k < tries; k++) {
+		uint32_t before = shm->seq.load(std::memory_order_acquire);
+		if (before & 1){ continue; } // being written
+		std::memcpy(&out, &shm->frame, sizeof(out));
+		std::atomic_thread_fence(std::memory_order_acquire); // the copy is done before the second load
+		if (shm->seq.load(std::memory_order_relaxed) == before){ return true; }
+	}
+	return false;
+}
+
+uint32_t FleetShmReader::Sequence() const {
+	return shm->seq.load(std::memory_order_acquire);
+}
+
+}  // namespace outdoor_gcs
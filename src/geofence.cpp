@@ -0,0 +1,292 @@
+/**
+ * @file /src/geofence.cpp
+ *
+ * @brief Geofence of inclusion / exclusion polygons with altitude bands.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "../include/outdoor_gcs/geofence.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+float cross(float ax, float ay, float bx, float by, float cx, float cy){
+	return (bx - ax)*(cy - ay) - (by - ay)*(cx - ax);
+}
+
+// Proper crossing of segments p-q and a-b
+bool crosses(float px, float py, float qx, float qy, float ax, float ay, float bx, float by){
+	float d1 = cross(px, py, qx, qy, ax, ay), d2 = cross(px, py, qx, qy, bx, by);
+	float d3 = cross(ax, ay, bx, by, px, py), d4 = cross(ax, ay, bx, by, qx, qy);
+	return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+// Segment a-b touches the rectangle [x0,x1] x [y0,y1] (Liang-Barsky clipping)
+bool touches(float ax, float ay, float bx, float by, float x0, float y0, float x1, float y1){
+	float t0 = 0, t1 = 1;
+	float d[2] = {bx - ax, by - ay};
+	float p[4] = {-d[0], d[0], -d[1], d[1]};
+	float q[4] = {ax - x0, x1 - ax, ay - y0, y1 - ay};
+	for (int i = 0; i < 4; i++) {
+		if (p[i] == 0){
+			if (q[i] < 0){ return false; }
+			continue;
+		}
+		float t = q[i]/p[i];
+		if (p[i] < 0){ t0 = std::max(t0, t); }
+		else{ t1 = std::min(t1, t); }
+		if (t0 > t1){ return false; }
+	}
+	return true;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+bool Geofence::Load(const std::string &path, std::string &error){
+	loaded = false;
+	polygons.clear();
+	grid.clear();
+	z_min = -1e9;
+	z_max = 1e9;
+	std::ifstream file(path.c_str());
+	if (!file){
+		error = path + ": cannot open";
+		return false;
+	}
+	std::string line;
+	int line_no = 0;
+	polygon *open = nullptr;
+	while (std::getline(file, line)) {
+		line_no++;
+		line = line.substr(0, line.find('#'));
+		std::istringstream in(line);
+		std::string word;
+		if (!(in >> word)){ continue; }
+		std::string where = path + ":" + std::to_string(line_no) + ": ";
+		if (word == "altitude"){
+			if (!(in >> z_min >> z_max) || z_min >= z_max){
+				error = where + "altitude needs min < max";
+				return false;
+			}
+		} else if (word == "include" || word == "exclude"){
+			if (open){
+				error = where + "missing end";
+				return false;
+			}
+			if (int(polygons.size()) == Max_Polygons){
+				error = where + "more than " + std::to_string(Max_Polygons) + " polygons";
+				return false;
+			}
+			polygon poly;
+			poly.include = word == "include";
+			poly.z_min = -1e9;
+			poly.z_max = 1e9;
+			in >> poly.z_min >> poly.z_max;
+			polygons.push_back(poly);
+			open = &polygons.back();
+		} else if (word == "end"){
+			if (!open || open->x.size() < 3){
+				error = where + "a polygon needs 3 vertices";
+				return false;
+			}
+			open = nullptr;
+		} else{
+			float x, y;
+			std::istringstream vertex(line);
+			if (!open || !(vertex >> x >> y)){
+				error = where + "unexpected '" + word + "'";
+				return false;
+			}
+			open->x.push_back(x);
+			open->y.push_back(y);
+		}
+	}
+	if (open){
+		error = path + ": missing end";
+		return false;
+	}
+	any_include = false;
+	for (const auto &poly : polygons){
+		any_include = any_include || poly.include;
+	}
+	build_grid();
+	loaded = true;
+	return true;
+}
+
+void Geofence::build_grid(){
+	gx = gy = 0;
+	if (polygons.empty()){ return; }
+	float x1 = -1e30, y1 = -1e30;
+	x0 = y0 = 1e30;
+	size_t num_edges = 0;
+	for (const auto &poly : polygons){
+		for (size_t k = 0; k < poly.x.size(); k++) {
+			x0 = std::min(x0, poly.x[k]);
+			y0 = std::min(y0, poly.y[k]);
+			x1 = std::max(x1, poly.x[k]);
+			y1 = std::max(y1, poly.y[k]);
+		}
+		num_edges += poly.x.size();
+	}
+	float w = std::max(x1 - x0, 1e-3f), h = std::max(y1 - y0, 1e-3f);
+	x0 -= 0.01f*w;
+	y0 -= 0.01f*h;
+	w *= 1.02f;
+	h *= 1.02f;
+	// About 4 cells per edge keeps one or two edges in a boundary cell
+	float target = std::min(std::max(4.0f*num_edges, 16.0f), 65536.0f);
+	gx = std::min(std::max(int(std::lround(std::sqrt(target*w/h))), 1), 512);
+	gy = std::min(std::max(int(std::lround(target/gx)), 1), 512);
+	cell_w = w/gx;
+	cell_h = h/gy;
+	grid.assign(size_t(gx)*gy, cell());
+
+	for (int p = 0; p < int(polygons.size()); p++) {
+		const polygon &poly = polygons[p];
+		size_t n = poly.x.size();
+		for (size_t k = 0; k < n; k++) {
+			edge e = {p, poly.x[k], poly.y[k], poly.x[(k+1)%n], poly.y[(k+1)%n]};
+			int i0 = std::max(int((std::min(e.x0, e.x1) - x0)/cell_w), 0);
+			int i1 = std::min(int((std::max(e.x0, e.x1) - x0)/cell_w), gx-1);
+			int j0 = std::max(int((std::min(e.y0, e.y1) - y0)/cell_h), 0);
+			int j1 = std::min(int((std::max(e.y0, e.y1) - y0)/cell_h), gy-1);
+			for (int j = j0; j <= j1; j++) {
+				for (int i = i0; i <= i1; i++) {
+					if (touches(e.x0, e.y0, e.x1, e.y1, x0 + i*cell_w, y0 + j*cell_h, x0 + (i+1)*cell_w, y0 + (j+1)*cell_h)){
+						grid[j*gx + i].edges.push_back(e);
+					}
+				}
+			}
+		}
+	}
+
+	// Centers row by row: where the row crosses each polygon, even-odd between crossings
+	std::vector<float> xs;
+	for (int j = 0; j < gy; j++) {
+		float yc = y0 + (j + 0.5f)*cell_h;
+		for (int p = 0; p < int(polygons.size()); p++) {
+			const polygon &poly = polygons[p];
+			size_t n = poly.x.size();
+			xs.clear();
+			for (size_t k = 0; k < n; k++) {
+				float ax = poly.x[k], ay = poly.y[k], bx = poly.x[(k+1)%n], by = poly.y[(k+1)%n];
+				if ((ay > yc) != (by > yc)){
+					xs.push_back(ax + (yc - ay)*(bx - ax)/(by - ay));
+				}
+			}
+			std::sort(xs.begin(), xs.end());
+			size_t passed = 0;
+			for (int i = 0; i < gx; i++) {
+				float xc = x0 + (i + 0.5f)*cell_w;
+				while (passed < xs.size() && xs[passed] < xc) { passed++; }
+				if (passed % 2){ grid[j*gx + i].center_inside |= uint64_t(1) << p; }
+			}
+		}
+	}
+}
+
+bool Geofence::inside_polygons(float x, float y, uint64_t &inside) const {
+	int i = int(std::floor((x - x0)/cell_w)), j = int(std::floor((y - y0)/cell_h));
+	if (i < 0 || j < 0 || i >= gx || j >= gy){ return false; }
+	const cell &c = grid[j*gx + i];
+	inside = c.center_inside;
+	float xc = x0 + (i + 0.5f)*cell_w, yc = y0 + (j + 0.5f)*cell_h;
+	for (const auto &e : c.edges){
+		if (crosses(xc, yc, x, y, e.x0, e.y0, e.x1, e.y1)){
+			inside ^= uint64_t(1) << e.poly;
+		}
+	}
+	return true;
+}
+
+bool Geofence::Contains(const float p[3]) const {
+	if (p[2] < z_min || p[2] > z_max){ return false; }
+	uint64_t inside;
+	if (!inside_polygons(p[0], p[1], inside)){ return !any_include; } // beyond every polygon
+	bool included = !any_include;
+	for (size_t k = 0; k < polygons.size(); k++) {
+		if (!((inside >> k) & 1) || p[2] < polygons[k].z_min || p[2] > polygons[k].z_max){ continue; }
+		if (!polygons[k].include){ return false; }
+		included = true;
+	}
+	return included;
+}
+
+Fence_Result Geofence::Check(const float from[3], float target[3], bool clamp) const {
+	if (!loaded || Contains(target)){ return Fence_Inside; }
+	if (!clamp || !Contains(from)){ return Fence_Rejected; }
+	// Inside or out can only change where the segment crosses an edge or a band, so the first
+	// piece between two crossings found outside holds the exit: a bisection over the whole
+	// segment could land beyond a no-fly zone it passes through
+	float d[3] = {target[0] - from[0], target[1] - from[1], target[2] - from[2]};
+	std::vector<float> cuts(1, 1.0f);
+	auto band = [&](float z){
+		float t = d[2] != 0 ? (z - from[2])/d[2] : -1;
+		if (t > 0 && t < 1){ cuts.push_back(t); }
+	};
+	band(z_min);
+	band(z_max);
+	for (const auto &poly : polygons){
+		band(poly.z_min);
+		band(poly.z_max);
+		size_t n = poly.x.size();
+		for (size_t k = 0; k < n; k++) {
+			float ex = poly.x[(k+1)%n] - poly.x[k], ey = poly.y[(k+1)%n] - poly.y[k];
+			float ax = poly.x[k] - from[0], ay = poly.y[k] - from[1];
+			float denom = d[0]*ey - d[1]*ex;
+			if (denom == 0){ continue; }
+			float t = (ax*ey - ay*ex)/denom, u = (ax*d[1] - ay*d[0])/denom;
+			if (t > 0 && t < 1 && u >= 0 && u <= 1){ cuts.push_back(t); }
+		}
+	}
+	std::sort(cuts.begin(), cuts.end());
+	float lo = 0, hi = 1, start = 0, p[3];
+	for (const auto &cut : cuts){
+		float mid = 0.5f*(start + cut);
+		for (int i = 0; i < 3; i++) { p[i] = from[i] + mid*d[i]; }
+		if (!Contains(p)){
+			hi = mid;
+			break;
+		}
+		lo = mid;
+		start = cut;
+	}
+	// Only the exit lies between lo and hi now; bisect it to within 1 cm
+	float len = std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2])*(hi - lo);
+	int steps = std::min(std::max(int(std::ceil(std::log2(len/0.01f))), 0), 20);
+	for (int it = 0; it < steps; it++) {
+		float mid = 0.5f*(lo + hi);
+		for (int i = 0; i < 3; i++) { p[i] = from[i] + mid*d[i]; }
+		if (Contains(p)){ lo = mid; }
+		else{ hi = mid; }
+	}
+	for (int i = 0; i < 3; i++) {
+		target[i] = from[i] + lo*d[i];
+	}
+	return Fence_Clamped;
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,93 @@
+/**
+ * @file /src/latency_histogram.cpp
+ *
+ * @brief Log-bucketed latency histogram.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "../include/outdoor_gcs/latency_histogram.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+LatencyHistogram::LatencyHistogram() {
+	Reset();
+}
+
+int LatencyHistogram::bucket_of(double seconds){
+	double us = seconds*1e6;
+	if (us <= 1.0){ return 0; }
+	return std::min(int(std::ceil(4*std::log2(us))), Buckets-1);
+}
+
+double LatencyHistogram::Upper_Edge(int bucket){
+	return std::pow(2.0, bucket/4.0)*1e-6;
+}
+
+void LatencyHistogram::Add(double seconds){
+	seconds = std::max(seconds, 0.0);
+	counts[bucket_of(seconds)].fetch_add(1, std::memory_order_relaxed);
+	total.fetch_add(1, std::memory_order_relaxed);
+	uint64_t us = uint64_t(seconds*1e6);
+	sum_us.fetch_add(us, std::memory_order_relaxed);
+	uint64_t prev = max_us.load(std::memory_order_relaxed);
+	while (us > prev && !max_us.compare_exchange_weak(prev, us, std::memory_order_relaxed)){}
+}
+
+void LatencyHistogram::Reset(){
+	for (int i = 0; i < Buckets; i++) {
+		counts[i].store(0, std::memory_order_relaxed);
+	}
+	total.store(0, std::memory_order_relaxed);
+	sum_us.store(0, std::memory_order_relaxed);
+	max_us.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Count() const {
+	return total.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Count_Below(double seconds) const {
+	uint64_t n = 0;
+	for (int i = 0; i < Buckets && Upper_Edge(i) <= seconds*(1+1e-9); i++) {
+		n += counts[i].load(std::memory_order_relaxed);
+	}
+	return n;
+}
+
+double LatencyHistogram::Mean() const {
+	uint64_t n = Count();
+	return n ? sum_us.load(std::memory_order_relaxed)*1e-6/n : 0.0;
+}
+
+double LatencyHistogram::Max() const {
+	return max_us.load(std::memory_order_relaxed)*1e-6;
+}
+
+double LatencyHistogram::Percentile(double p) const {
+	uint64_t n = Count();
+	if (n == 0){ return 0.0; }
+	uint64_t target = std::max<uint64_t>(1, uint64_t(std::ceil(p*n)));
+	uint64_t seen = 0;
+	for (int i = 0; i < Buckets; i++) {
+		seen += counts[i].load(std::memory_order_relaxed);
+		if (seen >= target){ return std::min(Upper_Edge(i), Max()); }
+	}
+	return Max();
+}
+
+}  // namespace outdoor_gcs
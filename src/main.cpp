@@ -11,6 +11,9 @@
 
 #include <QtGui>
 #include <QApplication>
+#include <QCoreApplication>
+#include <cstring>
+#include <iostream>
 #include "../include/outdoor_gcs/main_window.hpp"
 
 /*****************************************************************************
@@ -19,6 +22,26 @@
 
 int main(int argc, char **argv) {
 
+    /*********************
+    ** Headless
+    **********************/
+    // The ros loop alone, driven and watched through ~control_socket
+    bool headless = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0){ headless = true; }
+    }
+    if (headless){
+        QCoreApplication app(argc, argv);
+        outdoor_gcs::QNode qnode(argc, argv);
+        qnode.Set_Headless(true);
+        if (!qnode.init()){
+            std::cerr << qnode.Init_Error() << std::endl;
+            return 1;
+        }
+        app.connect(&qnode, SIGNAL(rosShutdown()), &app, SLOT(quit()));
+        return app.exec();
+    }
+
     /*********************
     ** Qt
     **********************/
@@ -32,6 +32,9 @@ MainWindow::MainWindow(int argc, char** argv, QWidget *parent)
 	, qnode(argc,argv)
 {
 	ui.setupUi(this); // Calling this incidentally connects all ui's triggers to on_...() callbacks in this class.
+    notice_model = new outdoor_gcs::EventLogModel(qnode.GetEventLog(), this);
+    ui.notice_logger->setModel(notice_model);
+    ui.notice_logger->setUniformItemSizes(true); // rows laid out without measuring each one
     QObject::connect(ui.actionAbout_Qt, SIGNAL(triggered(bool)), qApp, SLOT(aboutQt())); // qApp is a global variable for the application
 
     ReadSettings();
@@ -42,7 +45,7 @@ MainWindow::MainWindow(int argc, char** argv, QWidget *parent)
     bool init_ros_ok = qnode.init();
     if (!init_ros_ok)
     {
-        showNoMasterMessage();
+        showInitError();
     }
     else
     {
@@ -55,6 +58,7 @@ MainWindow::MainWindow(int argc, char** argv, QWidget *parent)
     QObject::connect(&qnode, SIGNAL(rosLoopUpdate()), this, SLOT(updateuav()));
     QObject::connect(&qnode, SIGNAL(rosLoopUpdate()), this, SLOT(updateuavs()));
     QObject::connect(&qnode, SIGNAL(rosLoopUpdate()), this, SLOT(updateInfoLogger()));
+    QObject::connect(&qnode, SIGNAL(availUavsUpdate(QList<int>)), this, SLOT(updateAvailUavs(QList<int>)));
 }
 
 MainWindow::~MainWindow() {}
@@ -63,9 +67,9 @@ MainWindow::~MainWindow() {}
 ** Implementation [Slots]
 *****************************************************************************/
 
-void MainWindow::showNoMasterMessage() {
+void MainWindow::showInitError() {
 	QMessageBox msgBox;
-	msgBox.setText("Couldn't find the ros master.");
+	msgBox.setText(QString::fromStdString(qnode.Init_Error()));
 	msgBox.exec();
     close();
 }
@@ -590,7 +594,22 @@ void MainWindow::on_Update_UAV_List_clicked(bool check){
     }
     qnode.Update_Avail_UAVind(avail_uavind);
     ui.uav_detect_logger->addItems(UAV_Detected);
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Available uav list updated!");
+    notice("Available uav list updated!", outdoor_gcs::Event_Info);
+}
+
+void MainWindow::updateAvailUavs(QList<int> uavs){
+    // uavs / detect of the control socket: qnode already has the list, only the GUI copy follows
+    ui.uav_detect_logger->clear();
+    UAV_Detected.clear();
+    avail_uavind = uavs.toStdList();
+    for(int i = 0; i < DroneNumber ; i++) {
+        UAVs[i].rosReceived = uavs.contains(i);
+        if (UAVs[i].rosReceived){
+            UAV_Detected += "uav" + QString::number(i+1);
+        }
+    }
+    ui.uav_detect_logger->addItems(UAV_Detected);
+    notice("Available uav list updated by the control socket!", outdoor_gcs::Event_Info);
 }
 
 void MainWindow::on_px4_apm_clicked(bool check){
@@ -598,16 +617,12 @@ void MainWindow::on_px4_apm_clicked(bool check){
         px4_apm = false;
         qnode.Update_px4_apm(false);
         ui.px4_apm->setText("px4");
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : APM !!!! ");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+        notice("APM !!!! ", outdoor_gcs::Event_Info);
     } else{
         px4_apm = true;
         qnode.Update_px4_apm(true);
         ui.px4_apm->setText("apm");
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : PX4 !!!! ");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+        notice("PX4 !!!! ", outdoor_gcs::Event_Info);
     }
 }
 
@@ -620,16 +635,12 @@ void MainWindow::on_Set_GPS_Origin_clicked(bool check){
                 break;
             }
         }
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : uav " + QString::number(origin_ind+1) + " selected to set for origin!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+        notice("uav " + QString::number(origin_ind+1) + " selected to set for origin!", outdoor_gcs::Event_Info, origin_ind);
         for (const auto &i : avail_uavind){
             qnode.Set_GPS_Home_uavs(i, origin_ind);
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to set GPS origin!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to set GPS origin!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -641,16 +652,12 @@ void MainWindow::on_Button_GetCur_Select_clicked(bool check){
                 ui.x_input_all->setText(QString::number(UAVs[i].pos_cur[0], 'f', 2));
                 ui.y_input_all->setText(QString::number(UAVs[i].pos_cur[1], 'f', 2));
                 ui.z_input_all->setText(QString::number(UAVs[i].pos_cur[2], 'f', 2));
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Got current location for uav " + QString::number(i+1) + "!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Got current location for uav " + QString::number(i+1) + "!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to get current location!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to get current location!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -662,16 +669,12 @@ void MainWindow::on_Button_GetDes_Select_clicked(bool check){
                 ui.x_input_all->setText(QString::number(UAVs[i].pos_des[0], 'f', 2));
                 ui.y_input_all->setText(QString::number(UAVs[i].pos_des[1], 'f', 2));
                 ui.z_input_all->setText(QString::number(UAVs[i].pos_des[2], 'f', 2));
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Got desired location for uav " + QString::number(i+1) + "!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Got desired location for uav " + QString::number(i+1) + "!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to get desired location!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to get desired location!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -687,13 +690,9 @@ void MainWindow::on_Button_Set_All_Height_clicked(bool check){
             UAVs[i].pos_des[2] = target_height;
             qnode.Update_UAV_info(UAVs[i], i);
         }
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Desired height of all uav is set to " + QString::number(target_height));
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+        notice("Desired height of all uav is set to " + QString::number(target_height), outdoor_gcs::Event_Info);
     } else {
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Input height is out of range!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Input height is out of range!", outdoor_gcs::Event_Warning);
     };
 }
 
@@ -718,30 +717,28 @@ void MainWindow::on_Button_Set_Select_clicked(bool check){
             input_is_valid = false;
         }
 
+        bool in_fence = qnode.GetFenceInside(target_state);
+
         /*----------------send input ------------------*/
-        if(input_is_valid){
+        if(input_is_valid && in_fence){
             for (const auto &i : avail_uavind){
                 if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
                     UAVs[i].pos_des[0] = target_state[0];
                     UAVs[i].pos_des[1] = target_state[1];
                     UAVs[i].pos_des[2] = target_state[2];
                     qnode.Update_UAV_info(UAVs[i], i);
-                    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Desired location of uav " + QString::number(i+1) + " is set! ");
-                    int item_index = ui.notice_logger->count()-1;
-                    ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+                    notice("Desired location of uav " + QString::number(i+1) + " is set! ", outdoor_gcs::Event_Info, i);
                     break;
                 }
             }
+        } else if (input_is_valid){
+            notice("Input location is outside the geofence!", outdoor_gcs::Event_Warning);
         } else {
-            ui.notice_logger->addItem(QTime::currentTime().toString() + " : Input location is out of range!");
-            int item_index = ui.notice_logger->count()-1;
-            ui.notice_logger->item(item_index)->setForeground(Qt::red);
+            notice("Input location is out of range!", outdoor_gcs::Event_Warning);
         };
 
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to assign desired location!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to assign desired location!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -751,16 +748,12 @@ void MainWindow::on_ARM_ONE_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
                 qnode.Set_Arm_uavs(true, i);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to ARM is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to ARM is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to arm!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to arm!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_DISARM_ONE_clicked(bool check){
@@ -769,16 +762,12 @@ void MainWindow::on_DISARM_ONE_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
                 qnode.Set_Arm_uavs(false, i);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to DISARM is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to DISARM is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to disarm!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to disarm!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_TAKEOFF_ONE_clicked(bool check){
@@ -787,16 +776,12 @@ void MainWindow::on_TAKEOFF_ONE_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
         	    qnode.Set_Mode_uavs("AUTO.TAKEOFF", i);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to TAKEOFF is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to TAKEOFF is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to takeoff!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to takeoff!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_LAND_ONE_clicked(bool check){
@@ -805,16 +790,12 @@ void MainWindow::on_LAND_ONE_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
         	    qnode.Set_Mode_uavs("AUTO.LAND", i);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to LAND is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to LAND is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to land!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to land!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -824,16 +805,12 @@ void MainWindow::on_MODE_RTL_ONE_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
         	    qnode.Set_Mode_uavs("AUTO.RTL", i);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to RTL is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to RTL is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to rtl!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to rtl!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -843,16 +820,12 @@ void MainWindow::on_MODE_LOITER_ONE_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
         	    qnode.Set_Mode_uavs("AUTO.LOITER", i);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to LOITER is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to LOITER is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to loiter!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to loiter!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -862,16 +835,12 @@ void MainWindow::on_MODE_OFFBOARD_ONE_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
         	    qnode.Set_Mode_uavs("OFFBOARD", i);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to set OFFBOARD is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to set OFFBOARD is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to set offboard!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to set offboard!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -881,16 +850,12 @@ void MainWindow::on_Button_Move_One_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
         	    qnode.Update_Move(i, true);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to MOVE is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to MOVE is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to move!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to move!", outdoor_gcs::Event_Warning);
     }
 }
 
@@ -900,99 +865,85 @@ void MainWindow::on_Button_Stop_One_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
         	    qnode.Update_Move(i, false);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Command for uav " + QString::number(i+1) + " to STOP is sent!");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                notice("Command for uav " + QString::number(i+1) + " to STOP is sent!", outdoor_gcs::Event_Command, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to stop!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to stop!", outdoor_gcs::Event_Warning);
     }
 }
 
 void MainWindow::on_ARM_ALL_clicked(bool check){
+    if (schedule_all("arm", "ARM")){ return; }
     for (const auto &i : avail_uavind){
         qnode.Set_Arm_uavs(true, i);
         // sleep(1.0);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : ARM ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("ARM ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_DISARM_ALL_clicked(bool check){
+    if (schedule_all("disarm", "DISARM")){ return; }
     for (const auto &i : avail_uavind){
         qnode.Set_Arm_uavs(false, i);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : DISARM ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("DISARM ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_TAKEOFF_ALL_clicked(bool check){
+    if (schedule_all("takeoff", "TAKEOFF")){ return; }
     for (const auto &i : avail_uavind){
 	    qnode.Set_Mode_uavs("AUTO.TAKEOFF", i);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : TAKEOFF ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("TAKEOFF ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_LAND_ALL_clicked(bool check){
+    if (schedule_all("land", "LAND")){ return; }
     for (const auto &i : avail_uavind){
 	    qnode.Set_Mode_uavs("AUTO.LAND", i);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : LAND ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("LAND ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_Button_Move_All_clicked(bool check){
+    if (schedule_all("move", "MOVE")){ return; }
     for (const auto &i : avail_uavind){
         qnode.Update_Move(i, true);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : MOVE ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("MOVE ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_Button_Stop_All_clicked(bool check){
+    if (schedule_all("stop", "STOP")){ return; }
     for (const auto &i : avail_uavind){
         qnode.Update_Move(i, false);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : STOP ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("STOP ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_MODE_RTL_ALL_clicked(bool check){
+    if (schedule_all("rtl", "RTL")){ return; }
     for (const auto &i : avail_uavind){
 	    qnode.Set_Mode_uavs("AUTO.RTL", i);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : RTL ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("RTL ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_MODE_LOITER_ALL_clicked(bool check){
+    if (schedule_all("loiter", "LOITER")){ return; }
     for (const auto &i : avail_uavind){
 	    qnode.Set_Mode_uavs("AUTO.LOITER", i);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : LOITER ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("LOITER ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_MODE_POSCTL_ALL_clicked(bool check){
+    if (schedule_all("posctl", "POSCTL")){ return; }
     for (const auto &i : avail_uavind){
 	    qnode.Set_Mode_uavs("POSCTL", i);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : POSCTL ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("POSCTL ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_MODE_OFFBOARD_ALL_clicked(bool check){
+    if (schedule_all("offboard", "OFFBOARD")){ return; }
     for (const auto &i : avail_uavind){
 	    qnode.Set_Mode_uavs("OFFBOARD", i);
     }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : OFFBOARD ALL uavs command sent!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("OFFBOARD ALL uavs command sent!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_Button_Flock_Param_clicked(bool check){
     float param[6];
@@ -1003,9 +954,7 @@ void MainWindow::on_Button_Flock_Param_clicked(bool check){
     param[4] = ui.acc_input->text().toFloat();
     param[5] = ui.vel_input->text().toFloat();
     qnode.Update_Flock_Param(param);
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Flock params are updated!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("Flock params are updated!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_Button_ORCA_Param_clicked(bool check){
     float param[4];
@@ -1014,9 +963,7 @@ void MainWindow::on_Button_ORCA_Param_clicked(bool check){
     param[2] = ui.r_input->text().toFloat();
     param[3] = ui.NDist_input->text().toFloat();
     qnode.Update_ORCA_Param(param);
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : ORCA params are updated!");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+    notice("ORCA params are updated!", outdoor_gcs::Event_Command);
 }
 void MainWindow::on_Button_SetInit_clicked(bool check){
     /* read values from line edit */
@@ -1044,22 +991,16 @@ void MainWindow::on_Button_SetInit_clicked(bool check){
             for (const auto &i : avail_uavind){
                 if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
                     qnode.Update_PathPlan_Pos(i, pathplan_pos, true);
-                    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Init of uav " + QString::number(i+1) + " is set! ");
-                    int item_index = ui.notice_logger->count()-1;
-                    ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+                    notice("Init of uav " + QString::number(i+1) + " is set! ", outdoor_gcs::Event_Info, i);
                     break;
                 }
             }
         } else {
-            ui.notice_logger->addItem(QTime::currentTime().toString() + " : Input location is out of range!");
-            int item_index = ui.notice_logger->count()-1;
-            ui.notice_logger->item(item_index)->setForeground(Qt::red);
+            notice("Input location is out of range!", outdoor_gcs::Event_Warning);
         };
 
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to assign initial location!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to assign initial location!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_Button_SetFin_clicked(bool check){
@@ -1088,22 +1029,16 @@ void MainWindow::on_Button_SetFin_clicked(bool check){
             for (const auto &i : avail_uavind){
                 if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
                     qnode.Update_PathPlan_Pos(i, pathplan_pos, false);
-                    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Fin of uav " + QString::number(i+1) + " is set! ");
-                    int item_index = ui.notice_logger->count()-1;
-                    ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+                    notice("Fin of uav " + QString::number(i+1) + " is set! ", outdoor_gcs::Event_Info, i);
                     break;
                 }
             }
         } else {
-            ui.notice_logger->addItem(QTime::currentTime().toString() + " : Input location is out of range!");
-            int item_index = ui.notice_logger->count()-1;
-            ui.notice_logger->item(item_index)->setForeground(Qt::red);
+            notice("Input location is out of range!", outdoor_gcs::Event_Warning);
         };
 
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to assign final location!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to assign final location!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_Button_GoInit_clicked(bool check){
@@ -1115,16 +1050,12 @@ void MainWindow::on_Button_GoInit_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
                 qnode.Update_PathPlan_Des(i, true);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Desired location of uav " + QString::number(i+1) + " is set to Init! ");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+                notice("Desired location of uav " + QString::number(i+1) + " is set to Init! ", outdoor_gcs::Event_Info, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to GoInit!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to GoInit!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_Button_GoFin_clicked(bool check){
@@ -1136,53 +1067,76 @@ void MainWindow::on_Button_GoFin_clicked(bool check){
         for (const auto &i : avail_uavind){
             if (selected_uav[0]->text() == "uav" + QString::number(i+1)){
                 qnode.Update_PathPlan_Des(i, false);
-                ui.notice_logger->addItem(QTime::currentTime().toString() + " : Desired location of uav " + QString::number(i+1) + " is set to Fin! ");
-                int item_index = ui.notice_logger->count()-1;
-                ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+                notice("Desired location of uav " + QString::number(i+1) + " is set to Fin! ", outdoor_gcs::Event_Info, i);
                 break;
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to GoInit!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to GoInit!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_Button_GoInit_ALL_clicked(bool check){
     all_arrive = false;
     start_time = ros::Time::now();
     init_fin = 1;
-    for (const auto &i : avail_uavind){
-        qnode.Update_PathPlan_Des(i, true);
-    }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Desired location of all uavs is set to Init! ");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+    outdoor_gcs::assign_stat assign = qnode.Assign_Goals(true);
+    notice("Desired location of all uavs is set to Init! ", outdoor_gcs::Event_Info);
+    print_assignment(assign);
+    qnode.Request_Global_Paths(); // reported in the notices once planned
 }
 void MainWindow::on_Button_GoFin_ALL_clicked(bool check){
     all_arrive = false;
     start_time = ros::Time::now();
     init_fin = 2;
-    for (const auto &i : avail_uavind){
-        qnode.Update_PathPlan_Des(i, false);
-    }
-    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Desired location of all uavs is set to Fin! ");
-    int item_index = ui.notice_logger->count()-1;
-    ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+    outdoor_gcs::assign_stat assign = qnode.Assign_Goals(false);
+    notice("Desired location of all uavs is set to Fin! ", outdoor_gcs::Event_Info);
+    print_assignment(assign);
+    qnode.Request_Global_Paths(); // reported in the notices once planned
+}
+void MainWindow::print_assignment(const outdoor_gcs::assign_stat &assign){
+    if (assign.mode != "sum" && assign.mode != "max"){ return; }
+    notice("Goal assignment (min-" + QString::fromStdString(assign.mode) + "): " +
+           QString::number(assign.changed) + "/" + QString::number(assign.num) + " uavs swapped" +
+           (assign.unknown ? " (" + QString::number(assign.unknown) + " without odometry kept)" : QString()) + ", total " +
+           QString::number(assign.sum, 'f', 1) + " m (fixed " + QString::number(assign.fixed_sum, 'f', 1) + " m), max " +
+           QString::number(assign.max, 'f', 1) + " m (fixed " + QString::number(assign.fixed_max, 'f', 1) + " m), " +
+           QString::number(assign.time_us/1e3, 'f', 2) + " ms", outdoor_gcs::Event_Info);
+}
+void MainWindow::print_fence_count(int ind, bool by_item){
+    if (!qnode.GetFenceLoaded()){ return; }
+    int count[2];
+    qnode.GetFenceCount(ind, count);
+    ui.info_logger->addItem((by_item ? "uav " + QString::number(ind+1) + ": " : QString()) + "Geofence: " +
+                            QString::number(count[0]) + " commands clamped, " + QString::number(count[1]) + " rejected");
+    if (count[0] + count[1] > 0){
+        int item_index = ui.info_logger->count()-1;
+        ui.info_logger->item(item_index)->setForeground(Qt::red);
+    }
+}
+void MainWindow::notice(const QString &text, outdoor_gcs::Event_Severity severity, int uav, int code){
+    qnode.GetEventLog().Append(uav, severity, code, text.toStdString());
+    notice_model->Sync();
+    ui.notice_logger->scrollToBottom();
+}
+bool MainWindow::schedule_all(const std::string &action, const QString &name){
+    if (qnode.GetSyncDelay() <= 0){ return false; }
+    double at = outdoor_gcs::CommandScheduler::Wall_Now() + qnode.GetSyncDelay();
+    float stagger = action == "takeoff" ? qnode.GetTakeoffStagger() : 0;
+    qnode.Schedule_Fleet(action, std::vector<int>(avail_uavind.begin(), avail_uavind.end()), at, stagger);
+    notice(name + " ALL uavs scheduled at " +
+           QDateTime::fromMSecsSinceEpoch(qint64(at*1e3)).toString("hh:mm:ss.zzz") +
+           (stagger > 0 ? ", " + QString::number(stagger, 'f', 1) + " s apart!" : QString("!")), outdoor_gcs::Event_Command);
+    return true;
 }
 void MainWindow::on_Button_uavitem_clicked(bool check){
     if (checkbox_stat.uav_item == 1){
         checkbox_stat.uav_item = 2;
         ui.Button_uavitem->setText("uav");
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Print by item! ");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+        notice("Print by item! ", outdoor_gcs::Event_Info);
     } else{
         checkbox_stat.uav_item = 1;
         ui.Button_uavitem->setText("item");
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Print by uav! ");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+        notice("Print by uav! ", outdoor_gcs::Event_Info);
     }
 }
 
@@ -1195,14 +1149,10 @@ void MainWindow::on_Button_uavitem_clicked(bool check){
 void MainWindow::on_checkBox_rtcm_stateChanged(int){
     if (ui.checkBox_rtcm -> isChecked()){ 
         qnode.Update_RTCM(true);
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Send RTCM signal!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::darkGreen);
+        notice("Send RTCM signal!", outdoor_gcs::Event_Info);
     } else{ 
         qnode.Update_RTCM(false);
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Stop sending RTCM signal!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Stop sending RTCM signal!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_checkBox_square_stateChanged(int){
@@ -1217,9 +1167,7 @@ void MainWindow::on_checkBox_square_stateChanged(int){
                     size_time[1] =  ui.time_input->text().toFloat();
                     qnode.Set_Square_Circle(i, size_time);
                     qnode.Update_Planning_Dim(i, 10);
-                    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Square path of uav " + QString::number(i+1) + " is set!");
-                    int item_index = ui.notice_logger->count()-1;
-                    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                    notice("Square path of uav " + QString::number(i+1) + " is set!", outdoor_gcs::Event_Command, i);
                 }
                 else{
                     qnode.Update_Planning_Dim(i, 0);
@@ -1228,9 +1176,7 @@ void MainWindow::on_checkBox_square_stateChanged(int){
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to assign path!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to assign path!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_checkBox_circle_stateChanged(int){
@@ -1245,9 +1191,7 @@ void MainWindow::on_checkBox_circle_stateChanged(int){
                     size_time[1] =  ui.time_input->text().toFloat();
                     qnode.Set_Square_Circle(i, size_time);
                     qnode.Update_Planning_Dim(i, 11);
-                    ui.notice_logger->addItem(QTime::currentTime().toString() + " : Circle path of uav " + QString::number(i+1) + " is set!");
-                    int item_index = ui.notice_logger->count()-1;
-                    ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+                    notice("Circle path of uav " + QString::number(i+1) + " is set!", outdoor_gcs::Event_Command, i);
                 }
                 else{
                     qnode.Update_Planning_Dim(i, 0);
@@ -1256,9 +1200,7 @@ void MainWindow::on_checkBox_circle_stateChanged(int){
             }
         }
     } else{
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please select an uav to assign path!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+        notice("Please select an uav to assign path!", outdoor_gcs::Event_Warning);
     }
 }
 void MainWindow::on_checkBox_Flock_2D_stateChanged(int){
@@ -1267,9 +1209,7 @@ void MainWindow::on_checkBox_Flock_2D_stateChanged(int){
         ui.checkBox_ORCA_2D -> setChecked(false);
         ui.checkBox_ORCA_3D -> setChecked(false);
         qnode.Update_Planning_Dim(99, 2); // 99 as all agents
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : 2D Flock Planning Set!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+        notice("2D Flock Planning Set!", outdoor_gcs::Event_Command);
     }else{
         qnode.Update_Planning_Dim(99, 0);
     }
@@ -1280,9 +1220,7 @@ void MainWindow::on_checkBox_Flock_3D_stateChanged(int){
         ui.checkBox_ORCA_2D -> setChecked(false);
         ui.checkBox_ORCA_3D -> setChecked(false);
         qnode.Update_Planning_Dim(99, 3);
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : 3D Flock Planning Set!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+        notice("3D Flock Planning Set!", outdoor_gcs::Event_Command);
     }else{
         qnode.Update_Planning_Dim(99, 0);
     }
@@ -1295,9 +1233,7 @@ void MainWindow::on_checkBox_Flock_DW2_stateChanged(int){
         ui.checkBox_ORCA_2D -> setChecked(false);
         ui.checkBox_ORCA_3D -> setChecked(false);
         qnode.Update_Planning_Dim(99, 6);
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Flock Planning with Downwash 2D Set!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+        notice("Flock Planning with Downwash 2D Set!", outdoor_gcs::Event_Command);
     }else{
         qnode.Update_Planning_Dim(99, 0);
     }
@@ -1310,9 +1246,7 @@ void MainWindow::on_checkBox_Flock_DW3_stateChanged(int){
         ui.checkBox_ORCA_2D -> setChecked(false);
         ui.checkBox_ORCA_3D -> setChecked(false);
         qnode.Update_Planning_Dim(99, 7);
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Flock Planning with Downwash 3D Set!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+        notice("Flock Planning with Downwash 3D Set!", outdoor_gcs::Event_Command);
     }else{
         qnode.Update_Planning_Dim(99, 0);
     }
@@ -1324,9 +1258,7 @@ void MainWindow::on_checkBox_ORCA_2D_stateChanged(int){
         ui.checkBox_ORCA_3D -> setChecked(false);
         // ui.checkBox_Plan_ -> setChecked(false);
         qnode.Update_Planning_Dim(99, 4); // 99 as all agents
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : 2D ORCA Planning Set!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+        notice("2D ORCA Planning Set!", outdoor_gcs::Event_Command);
     }else{
         qnode.Update_Planning_Dim(99, 0);
     }
@@ -1337,9 +1269,7 @@ void MainWindow::on_checkBox_ORCA_3D_stateChanged(int){
         ui.checkBox_Flock_3D -> setChecked(false);
         ui.checkBox_ORCA_2D -> setChecked(false);
         qnode.Update_Planning_Dim(99, 5); // 99 as all agents
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : 3D ORCA Planning Set!");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::blue);
+        notice("3D ORCA Planning Set!", outdoor_gcs::Event_Command);
     }else{
         qnode.Update_Planning_Dim(99, 0);
     }
@@ -1408,12 +1338,17 @@ void MainWindow::on_Rostopic_Update_clicked(bool check){
 
 ////////////////////////// Update signals /////////////////////////
 void MainWindow::updateuavs(){
-    if (avail_uavind.size()==0){
-        ui.notice_logger->clear();
-        ui.notice_logger->addItem(QTime::currentTime().toString() + " : Please update available uavs");
-        int item_index = ui.notice_logger->count()-1;
-        ui.notice_logger->item(item_index)->setForeground(Qt::red);
+    if (avail_uavind.size()==0 && !no_uavs_noticed){ // once, not on every tick
+        notice("Please update available uavs", outdoor_gcs::Event_Warning);
     }
+    no_uavs_noticed = avail_uavind.size()==0;
+    std::vector<outdoor_gcs::separation_alert> sep_events = qnode.GetSeparationEvents();
+    for (const auto &alert : sep_events){
+        notice("Separation alert! uav" + QString::number(alert.a+1) +
+               " & uav" + QString::number(alert.b+1) + " " + QString::number(alert.dist, 'f', 1) + " m apart, " +
+               QString::number(alert.d_cpa, 'f', 1) + " m in " + QString::number(alert.t_cpa, 'f', 1) + " s", outdoor_gcs::Event_Warning);
+    }
+    notice_model->Sync(); // events of the ros thread: global paths, mission, pre-flight
     ui.notice_logger->scrollToBottom();
 
     all_arrive = true;
@@ -1456,6 +1391,123 @@ void MainWindow::updateInfoLogger(){
                                 ", pref_v: " + QString::number(qnode.GetORCAParam(1), 'f', 1) +
                                 ", r: " + QString::number(qnode.GetORCAParam(2), 'f', 1) +
                                 ", NDist: " + QString::number(qnode.GetORCAParam(3), 'f', 1));
+        outdoor_gcs::pub_stat cmd_stat = qnode.GetCmdPubStat();
+        ui.info_logger->addItem("Cmd Pub (" + QString(qnode.GetFleetCommandMode() ? "fleet" : "per-uav") + "): " +
+                                QString::number(cmd_stat.num) + " uavs, " + QString::number(cmd_stat.bytes) + " bytes, " +
+                                QString::number(cmd_stat.time_us, 'f', 1) + " us");
+        if (qnode.GetStreamRate() > 0){
+            outdoor_gcs::stream_stat stream = qnode.GetStreamStat();
+            ui.info_logger->addItem("Setpoint Stream: " + QString::number(qnode.GetStreamRate(), 'f', 1) + " Hz, jitter mean: " +
+                                    QString::number(stream.jitter_mean_us, 'f', 0) + " us, max: " +
+                                    QString::number(stream.jitter_max_us, 'f', 0) + " us");
+        }
+        outdoor_gcs::FleetSnapshot snap = qnode.GetSnapshot();
+        QString skews;
+        for (const auto &it : avail_uavind){
+            if (it < int(snap.skew.size()) && snap.valid[it]){
+                skews += " " + QString::number(it+1) + ":" + QString::number(snap.skew[it]*1e3, 'f', 0);
+            }
+        }
+        ui.info_logger->addItem("Fleet Snapshot: max skew " + QString::number(snap.max_skew*1e3, 'f', 1) + " ms, built in " +
+                                QString::number(snap.build_us, 'f', 0) + " us, skew (ms):" + skews);
+        outdoor_gcs::plan_stat plan = qnode.GetPlanStat();
+        ui.info_logger->addItem("Planning: " + QString::number(plan.hosts) + " uavs on " + QString::number(plan.threads) +
+                                " threads, " + QString::number(plan.time_us, 'f', 0) + " us");
+        outdoor_gcs::separation_stat sep = qnode.GetSeparationStat();
+        ui.info_logger->addItem("Separation: closest " + (sep.min_dist < 0 ? QString("none within threshold") :
+                                QString::number(sep.min_dist, 'f', 1) + " m") + ", predicted " + (sep.min_cpa < 0 ?
+                                QString("none within threshold") : QString::number(sep.min_cpa, 'f', 1) + " m") +
+                                ", " + QString::number(sep.alerts) + " alerts, " + QString::number(sep.candidates) + " pairs checked of " +
+                                QString::number(sep.num) + " uavs, " + QString::number(sep.time_us, 'f', 1) + " us");
+        const outdoor_gcs::LatencyHistogram &sched_skew = qnode.GetScheduleSkew();
+        int sched_pending = qnode.GetSchedulePending();
+        if (sched_skew.Count() > 0 || sched_pending > 0){
+            ui.info_logger->addItem("Scheduler: " + QString::number(sched_pending) + " pending, " + QString::number(sched_skew.Count()) +
+                                    " released, skew mean " + QString::number(sched_skew.Mean()*1e3, 'f', 2) + " ms, p99 " +
+                                    QString::number(sched_skew.Percentile(0.99)*1e3, 'f', 2) + " ms, max " +
+                                    QString::number(sched_skew.Max()*1e3, 'f', 2) + " ms");
+            std::vector<outdoor_gcs::sched_record> released = qnode.GetScheduleRecent();
+            for (size_t k = released.size() > 3 ? released.size() - 3 : 0; k < released.size(); k++) {
+                ui.info_logger->addItem("             " + QString::fromStdString(released[k].label) + ": skew " +
+                                        QString::number(released[k].skew_ms, 'f', 2) + " ms, call " +
+                                        QString::number(released[k].run_ms, 'f', 1) + " ms");
+            }
+        }
+        if (qnode.GetClockSync()){
+            QString clocks;
+            for (const auto &it : avail_uavind){
+                outdoor_gcs::clock_estimate clock = qnode.GetClockEstimate(it);
+                if (clock.source == outdoor_gcs::Clock_None){ continue; }
+                clocks += " " + QString::number(it+1) + ":" + QString::number(clock.offset*1e3, 'f', 1) +
+                          (clock.source == outdoor_gcs::Clock_Exchange ? "x" : "p");
+            }
+            ui.info_logger->addItem("Clock Sync: offset (ms, x: exchange, p: passive):" + (clocks.isEmpty() ? QString(" no samples") : clocks));
+        }
+        outdoor_gcs::CommandTracer &tracer = qnode.GetCommandTracer();
+        for (const auto &it : avail_uavind){
+            outdoor_gcs::trace_stat trace = tracer.Stat(it);
+            if (trace.sent == 0){ continue; }
+            const outdoor_gcs::LatencyHistogram &latency = tracer.Latency(it);
+            ui.info_logger->addItem("Command Trace uav" + QString::number(it+1) + ": " + (trace.executed == 0 ? QString("no echo") :
+                                    "p50 " + QString::number(latency.Percentile(0.5)*1e3, 'f', 0) + " ms, p99 " +
+                                    QString::number(latency.Percentile(0.99)*1e3, 'f', 0) + " ms, last " +
+                                    QString::number(trace.last_ms, 'f', 0) + " ms") + ", " + QString::number(trace.sent) + " sent, " +
+                                    QString::number(trace.dropped) + " dropped, " + QString::number(trace.out_of_order) + " out of order");
+            if (trace.dropped > 0 || trace.out_of_order > 0){
+                int item_index = ui.info_logger->count()-1;
+                ui.info_logger->item(item_index)->setForeground(Qt::red);
+            }
+        }
+        outdoor_gcs::mission_status mission = qnode.GetMissionStatus();
+        if (mission.running || mission.done || mission.failed){
+            ui.info_logger->addItem("Mission: " + (mission.running ? "step " + QString::number(mission.step+1) + "/" + QString::number(mission.steps) +
+                                    " '" + QString::fromStdString(mission.text) + "' for " + QString::number(mission.step_elapsed, 'f', 1) + " s" :
+                                    mission.done ? QString("done") : "stopped, " + QString::fromStdString(mission.error)) +
+                                    ", " + QString::number(mission.elapsed, 'f', 1) + " s");
+            if (mission.failed){
+                int item_index = ui.info_logger->count()-1;
+                ui.info_logger->item(item_index)->setForeground(Qt::red);
+            }
+        }
+        outdoor_gcs::readiness_report ready = qnode.GetReadiness();
+        if (!ready.rows.empty()){
+            ui.info_logger->addItem("Pre-flight: " + QString(ready.go ? "GO" : "NO-GO") + ", " + QString::number(ready.ready) + "/" +
+                                    QString::number(ready.rows.size()) + " uavs ready, checked in " + QString::number(ready.time_us, 'f', 0) + " us");
+            int item_index = ui.info_logger->count()-1;
+            ui.info_logger->item(item_index)->setForeground(ready.go ? Qt::darkGreen : Qt::red);
+            for (const auto &row : ready.rows){
+                if (row.failed == 0){ continue; }
+                ui.info_logger->addItem("             uav" + QString::number(row.id+1) + ": " + QString::fromStdString(row.reason));
+                item_index = ui.info_logger->count()-1;
+                ui.info_logger->item(item_index)->setForeground(Qt::red);
+            }
+        }
+        std::vector<outdoor_gcs::plugin_stat> plugins = qnode.GetPluginStats();
+        for (size_t k = 0; k < plugins.size(); k++) {
+            ui.info_logger->addItem("Planner Plugin " + QString::fromStdString(plugins[k].name) +
+                                    (int(k) == qnode.GetActivePlanner() ? " (active): " : ": ") +
+                                    QString::number(plugins[k].last_us, 'f', 0) + " us, mean " +
+                                    QString::number(plugins[k].mean_us, 'f', 0) + " us, max " +
+                                    QString::number(plugins[k].max_us, 'f', 0) + " us, over budget " +
+                                    QString::number(plugins[k].over_budget) + "/" + QString::number(plugins[k].ticks));
+        }
+        const outdoor_gcs::LatencyHistogram &react = qnode.GetReactLatency();
+        ui.info_logger->addItem("Reaction Latency (" + QString(qnode.GetEventPlanning() ? "event" : "tick") + "): " +
+                                QString::number(react.Count()) + " cmds, mean " + QString::number(react.Mean()*1e3, 'f', 1) +
+                                " ms, p50 " + QString::number(react.Percentile(0.5)*1e3, 'f', 1) +
+                                " ms, p90 " + QString::number(react.Percentile(0.9)*1e3, 'f', 1) +
+                                " ms, p99 " + QString::number(react.Percentile(0.99)*1e3, 'f', 1) +
+                                " ms, max " + QString::number(react.Max()*1e3, 'f', 1) + " ms");
+        QString react_bins = "             ";
+        double react_edges[6] = {0.01, 0.025, 0.05, 0.1, 0.25, 0.5};
+        uint64_t react_prev = 0;
+        for (int i = 0; i < 6; i++) {
+            uint64_t below = react.Count_Below(react_edges[i]);
+            react_bins += "<" + QString::number(react_edges[i]*1e3, 'f', 0) + "ms: " + QString::number(below - react_prev) + "  ";
+            react_prev = below;
+        }
+        react_bins += ">500ms: " + QString::number(react.Count() - react_prev);
+        ui.info_logger->addItem(react_bins);
         ui.info_logger->addItem("----------------------------------------------------------------------------------------");
     }
 
@@ -1540,6 +1592,7 @@ void MainWindow::updateInfoLogger(){
                     int item_index = ui.info_logger->count()-1;
                     ui.info_logger->item(item_index)->setForeground(Qt::darkGreen);
                 }
+                print_fence_count(it, false);
             }
             if (checkbox_stat.print_pathplan){
                 ui.info_logger->addItem("PP Init Position: X: " + QString::number(UAVs[it].pos_ini[0], 'f', 3) +
@@ -1646,6 +1699,7 @@ void MainWindow::updateInfoLogger(){
                     int item_index = ui.info_logger->count()-1;
                     ui.info_logger->item(item_index)->setForeground(Qt::darkGreen);
                 }
+                print_fence_count(it, true);
             }
             ui.info_logger->addItem("----------------------------------------------------------------------------------------");
         }
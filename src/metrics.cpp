@@ -0,0 +1,287 @@
+/**
+ * @file /src/metrics.cpp
+ *
+ * @brief Registry of counters, gauges and latency histograms, exported as
+ * Prometheus text and binary snapshots.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "../include/outdoor_gcs/metrics.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const size_t Max_Request = 4096; // header bytes read from a scraper
+const int First_Le = 20, Le_Step = 4; // histogram buckets exported: octaves from 32 us to 67 s
+
+double wall_now(){
+	return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string number(double v){
+	if (std::isnan(v)){ return "NaN"; }
+	if (std::isinf(v)){ return v > 0 ? "+Inf" : "-Inf"; }
+	char buf[32];
+	std::snprintf(buf, sizeof(buf), "%.9g", v);
+	return buf;
+}
+
+std::string series_name(const std::string &name, const std::string &labels, const std::string &more = ""){
+	std::string all = labels.empty() || more.empty() ? labels + more : labels + "," + more;
+	return all.empty() ? name : name + "{" + all + "}";
+}
+
+template <class T>
+void put(std::string &out, const T &value){
+	out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+bool send_all(int fd, const std::string &text){
+	size_t sent = 0;
+	while (sent < text.size()) {
+		ssize_t n = ::send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+		if (n <= 0){ return false; }
+		sent += n;
+	}
+	return true;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+MetricsRegistry::~MetricsRegistry() {
+	if (server.joinable()){
+		stop = true;
+		ssize_t n = ::write(wake_pipe[1], "x", 1);
+		(void)n;
+		server.join();
+		::close(wake_pipe[0]);
+		::close(wake_pipe[1]);
+	}
+	if (listen_fd >= 0){ ::close(listen_fd); }
+	if (file){
+		write_snapshot(wall_now()); // the end of the run
+		std::fclose(file);
+	}
+}
+
+MetricCounter *MetricsRegistry::Counter(const std::string &name, const std::string &labels, const std::string &help){
+	metric_series &s = add(name, labels, help, Metric_Counter);
+	s.counter.reset(new MetricCounter);
+	return s.counter.get();
+}
+
+MetricGauge *MetricsRegistry::Gauge(const std::string &name, const std::string &labels, const std::string &help){
+	metric_series &s = add(name, labels, help, Metric_Gauge);
+	s.gauge.reset(new MetricGauge);
+	return s.gauge.get();
+}
+
+LatencyHistogram *MetricsRegistry::Histogram(const std::string &name, const std::string &labels, const std::string &help){
+	metric_series &s = add(name, labels, help, Metric_Histogram);
+	s.own.reset(new LatencyHistogram);
+	s.histogram = s.own.get();
+	return s.own.get();
+}
+
+void MetricsRegistry::Histogram(const std::string &name, const std::string &labels, const std::string &help,
+		const LatencyHistogram *external){
+	add(name, labels, help, Metric_Histogram).histogram = external;
+}
+
+MetricsRegistry::metric_series &MetricsRegistry::add(const std::string &name, const std::string &labels,
+		const std::string &help, Metric_Type type){
+	size_t f = 0;
+	while (f < families.size() && families[f].name != name) { f++; }
+	if (f == families.size()){
+		families.push_back({name, help, type, {}});
+	}
+	families[f].series.push_back(series.size());
+	series.emplace_back(new metric_series);
+	series.back()->name = name;
+	series.back()->labels = labels;
+	series.back()->type = families[f].type;
+	return *series.back();
+}
+
+bool MetricsRegistry::Open(int port, const std::string &snapshot_file, double snapshot_period, std::string &error){
+	if (Opened()){
+		error = "already open";
+		return false;
+	}
+	if (port > 0){
+		int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd < 0){
+			error = std::string("socket: ") + std::strerror(errno);
+			return false;
+		}
+		int on = 1;
+		::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+		sockaddr_in addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // local only, nothing here is authenticated
+		if (::bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0 || ::listen(fd, 8) < 0){
+			error = "port " + std::to_string(port) + ": " + std::strerror(errno);
+			::close(fd);
+			return false;
+		}
+		listen_fd = fd;
+	}
+	if (!snapshot_file.empty()){
+		file = std::fopen(snapshot_file.c_str(), "wb");
+		if (!file){
+			error = snapshot_file + ": " + std::strerror(errno);
+			if (listen_fd >= 0){ ::close(listen_fd); }
+			listen_fd = -1;
+			return false;
+		}
+		std::string head(Metrics_Magic, sizeof(Metrics_Magic));
+		put(head, Metrics_Version);
+		put(head, uint32_t(series.size()));
+		for (const auto &s : series){
+			std::string name = series_name(s->name, s->labels);
+			put(head, uint8_t(s->type));
+			put(head, uint16_t(name.size()));
+			head += name;
+		}
+		std::fwrite(head.data(), 1, head.size(), file);
+		std::fflush(file);
+	}
+	if (listen_fd < 0 && !file){ return true; }
+	if (::pipe2(wake_pipe, O_CLOEXEC) < 0){
+		error = std::string("pipe: ") + std::strerror(errno);
+		return false;
+	}
+	period = std::max(snapshot_period, 0.01);
+	server = std::thread(&MetricsRegistry::serve_loop, this);
+	return true;
+}
+
+std::string MetricsRegistry::Text() const {
+	std::string out;
+	for (const auto &f : families){
+		out += "# HELP " + f.name + " " + f.help + "\n";
+		out += "# TYPE " + f.name + (f.type == Metric_Counter ? " counter\n" : f.type == Metric_Gauge ? " gauge\n" : " histogram\n");
+		for (const auto &k : f.series){
+			const metric_series &s = *series[k];
+			if (s.type == Metric_Counter){
+				out += series_name(s.name, s.labels) + " " + std::to_string(s.counter->Value()) + "\n";
+			} else if (s.type == Metric_Gauge){
+				out += series_name(s.name, s.labels) + " " + number(s.gauge->Value()) + "\n";
+			} else{
+				// Count first: buckets read after it may have grown, never the other way round
+				uint64_t count = s.histogram->Count();
+				double sum = s.histogram->Mean()*count;
+				for (int b = First_Le; b < LatencyHistogram::Buckets; b += Le_Step) {
+					double le = LatencyHistogram::Upper_Edge(b);
+					out += series_name(s.name + "_bucket", s.labels, "le=\"" + number(le) + "\"") + " " +
+							std::to_string(std::min(count, s.histogram->Count_Below(le))) + "\n";
+				}
+				out += series_name(s.name + "_bucket", s.labels, "le=\"+Inf\"") + " " + std::to_string(count) + "\n";
+				out += series_name(s.name + "_sum", s.labels) + " " + number(sum) + "\n";
+				out += series_name(s.name + "_count", s.labels) + " " + std::to_string(count) + "\n";
+			}
+		}
+	}
+	return out;
+}
+
+void MetricsRegistry::write_snapshot(double now){
+	std::string record;
+	put(record, now);
+	for (const auto &s : series){
+		if (s->type == Metric_Counter){
+			put(record, s->counter->Value());
+		} else if (s->type == Metric_Gauge){
+			put(record, s->gauge->Value());
+		} else{
+			uint64_t count = s->histogram->Count();
+			put(record, count);
+			put(record, s->histogram->Mean()*count);
+			put(record, s->histogram->Percentile(0.5));
+			put(record, s->histogram->Percentile(0.99));
+			put(record, s->histogram->Max());
+		}
+	}
+	std::fwrite(record.data(), 1, record.size(), file);
+	std::fflush(file); // a crashed run keeps its records
+}
+
+void MetricsRegistry::serve_loop(){
+	double next = wall_now() + period;
+	while (!stop) {
+		pollfd fds[2] = {{wake_pipe[0], POLLIN, 0}, {listen_fd, POLLIN, 0}};
+		int timeout = file ? std::max(0, int(std::ceil((next - wall_now())*1e3))) : -1;
+		int ready = ::poll(fds, listen_fd >= 0 ? 2 : 1, timeout);
+		if (stop){ break; }
+		if (ready > 0 && listen_fd >= 0 && (fds[1].revents & POLLIN)){
+			int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+			if (fd >= 0){
+				answer(fd);
+				::close(fd);
+			}
+		}
+		if (file && wall_now() >= next){
+			write_snapshot(wall_now());
+			next = std::max(next + period, wall_now()); // no burst of records after a stall
+		}
+	}
+}
+
+void MetricsRegistry::answer(int fd){
+	// One scrape at a time on this thread; a client slower than the timeouts is cut off
+	timeval tv = {0, 500000};
+	::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+	std::string request;
+	char buf[1024];
+	while (request.find("\r\n\r\n") == std::string::npos && request.size() < Max_Request) {
+		ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+		if (n <= 0){ return; }
+		request.append(buf, n);
+	}
+	std::string line = request.substr(0, request.find("\r\n"));
+	std::string status, body;
+	if (line.compare(0, 13, "GET /metrics ") == 0 || line.compare(0, 6, "GET / ") == 0){
+		status = "200 OK";
+		body = Text();
+	} else{
+		status = "404 Not Found";
+		body = "GET /metrics\n";
+	}
+	send_all(fd, "HTTP/1.0 " + status + "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+			std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,229 @@
+/**
+ * @file /src/mission.cpp
+ *
+ * @brief Fleet missions compiled to steps, advanced on every loop tick.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include "../include/outdoor_gcs/mission.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+// Words of every action and condition, with the number of arguments they take
+const std::map<std::string, int> &actions(){
+	static const std::map<std::string, int> table = {{"arm", 0}, {"disarm", 0}, {"takeoff", 0}, {"land", 0},
+			{"rtl", 0}, {"loiter", 0}, {"posctl", 0}, {"offboard", 0}, {"move", 0}, {"stop", 0}, {"mode", 1}, {"go", 1}};
+	return table;
+}
+
+const std::map<std::string, int> &conditions(){
+	static const std::map<std::string, int> table = {{"armed", 0}, {"disarmed", 0}, {"arrived", 0}, {"ready", 0},
+			{"mode", 1}, {"altitude", 1}};
+	return table;
+}
+
+bool number(const std::string &word, float &value){
+	char *end;
+	value = std::strtof(word.c_str(), &end);
+	return !word.empty() && *end == 0;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+bool Mission::Load(const std::string &path, std::string &error){
+	std::ifstream file(path.c_str());
+	if (!file){
+		error = path + ": cannot open";
+		return false;
+	}
+	return Compile(file, path, error);
+}
+
+bool Mission::Compile(std::istream &in, const std::string &name, std::string &error){
+	std::vector<mission_step> compiled;
+	std::string line;
+	int line_no = 0;
+	while (std::getline(in, line)) {
+		line_no++;
+		line = line.substr(0, line.find('#'));
+		std::istringstream words(line);
+		std::vector<std::string> w;
+		std::string word;
+		while (words >> word) { w.push_back(word); }
+		if (w.empty()){ continue; }
+		std::string where = name + ":" + std::to_string(line_no) + ": ";
+
+		mission_step step;
+		step.seconds = 0;
+		step.line = line_no;
+		step.text = line.substr(line.find_first_not_of(" \t"));
+		step.text = step.text.substr(0, step.text.find_last_not_of(" \t\r") + 1);
+		const std::map<std::string, int> *table = &actions();
+		size_t first = 0;
+		if (w[0] == "sleep"){
+			step.op = Mission_Sleep;
+			step.name = w[0];
+			if (w.size() != 2 || !number(w[1], step.seconds) || step.seconds < 0){
+				error = where + "sleep needs a time in seconds";
+				return false;
+			}
+			compiled.push_back(step);
+			continue;
+		} else if (w[0] == "wait"){
+			step.op = Mission_Wait;
+			table = &conditions();
+			first = 1;
+			if (w.size() < 2){
+				error = where + "wait needs a condition";
+				return false;
+			}
+		} else{
+			step.op = Mission_Do;
+		}
+		step.name = w[first];
+		auto it = table->find(step.name);
+		if (it == table->end()){
+			error = where + "unknown " + (step.op == Mission_Wait ? "condition" : "action") + " '" + step.name + "'";
+			return false;
+		}
+		size_t k = first + 1;
+		for (int a = 0; a < it->second; a++, k++) {
+			if (k >= w.size()){
+				error = where + step.name + " needs " + std::to_string(it->second) + " argument(s)";
+				return false;
+			}
+			step.args.push_back(w[k]);
+		}
+		float value;
+		if (step.name == "go" && step.args[0] != "init" && step.args[0] != "final"){
+			error = where + "go init or go final";
+			return false;
+		}
+		if (step.name == "mode" && std::any_of(step.args[0].begin(), step.args[0].end(), ::islower)){
+			error = where + "mode names are in capitals, e.g. OFFBOARD";
+			return false;
+		}
+		if (step.name == "altitude" && !number(step.args[0], value)){
+			error = where + "altitude needs a height in metres";
+			return false;
+		}
+		// Optional trailing "timeout <s>" for waits, "stagger <s>" for fleet actions
+		std::string option = step.op == Mission_Wait ? "timeout" : "stagger";
+		if (k < w.size()){
+			if (w[k] != option || k + 2 != w.size() || !number(w[k+1], value) || value < 0 ||
+					(step.op == Mission_Do && (step.name == "mode" || step.name == "go"))){
+				error = where + "unexpected '" + w[k] + "'";
+				return false;
+			}
+			if (step.op == Mission_Wait){ step.seconds = value; }
+			else{ step.args.push_back(w[k+1]); }
+		}
+		compiled.push_back(step);
+		if (step.name == "go"){ // the global paths are planned over the next ticks: wait for them
+			step.op = Mission_Wait;
+			step.name = "paths";
+			step.args.clear();
+			compiled.push_back(step);
+		}
+	}
+	if (compiled.empty()){
+		error = name + ": no steps";
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	steps.swap(compiled);
+	status = mission_status();
+	status.steps = steps.size();
+	return true;
+}
+
+bool Mission::Loaded(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return !steps.empty();
+}
+
+void Mission::Start(double now){
+	std::lock_guard<std::mutex> lock(mutex);
+	if (steps.empty()){ return; }
+	status = mission_status();
+	status.steps = steps.size();
+	status.running = true;
+	status.text = steps[0].text;
+	start_time = step_time = now;
+}
+
+void Mission::Abort(const std::string &reason){
+	std::lock_guard<std::mutex> lock(mutex);
+	if (status.running){ fail(reason); }
+}
+
+void Mission::fail(const std::string &error){
+	status.running = false;
+	status.failed = true;
+	status.error = error;
+}
+
+bool Mission::Resume(double now, const hook &act, const hook &test){
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!status.running){ return false; }
+	while (status.step < int(steps.size())) {
+		const mission_step &step = steps[status.step];
+		double on_step = now - step_time;
+		if (step.op == Mission_Sleep){
+			if (on_step < step.seconds){ return true; }
+		} else if (step.op == Mission_Wait){
+			if (!test(step)){
+				if (step.seconds > 0 && on_step >= step.seconds){
+					fail("line " + std::to_string(step.line) + ": '" + step.text + "' timed out");
+					return false;
+				}
+				return true;
+			}
+		} else if (!act(step)){
+			fail("line " + std::to_string(step.line) + ": '" + step.text + "' failed");
+			return false;
+		}
+		status.step++;
+		step_time = now;
+		status.text = status.step < int(steps.size()) ? steps[status.step].text : "";
+	}
+	status.running = false;
+	status.done = true;
+	return false;
+}
+
+outdoor_gcs::mission_status Mission::Status(double now){
+	std::lock_guard<std::mutex> lock(mutex);
+	if (status.running){
+		status.elapsed = now - start_time;
+		status.step_elapsed = now - step_time;
+	}
+	return status;
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,141 @@
+/**
+ * @file /src/occupancy_grid.cpp
+ *
+ * @brief Static 3D occupancy grid, memory-mapped from a map file.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include "../include/outdoor_gcs/occupancy_grid.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+OccupancyGrid::~OccupancyGrid() {
+	unmap();
+}
+
+void OccupancyGrid::unmap(){
+	if (map){
+		munmap(map, map_size);
+	}
+	map = nullptr;
+	map_size = 0;
+	cells = nullptr;
+	inflated.clear();
+	nx = ny = nz = 0;
+}
+
+bool OccupancyGrid::Load(const std::string &path, std::string &error){
+	unmap();
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0){
+		error = path + ": " + std::strerror(errno);
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(occupancy_header)){
+		error = path + ": too small for an occupancy grid";
+		close(fd);
+		return false;
+	}
+	void *m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping stays valid
+	if (m == MAP_FAILED){
+		error = path + ": mmap failed, " + std::strerror(errno);
+		return false;
+	}
+	occupancy_header h;
+	std::memcpy(&h, m, sizeof(h));
+	size_t count = size_t(h.nx)*h.ny*h.nz;
+	if (std::memcmp(h.magic, "OGCSGRID", 8) != 0 || h.version != 1){
+		error = path + ": not an occupancy grid (version 1)";
+	} else if (h.resolution <= 0 || count == 0 || size_t(st.st_size) < sizeof(h) + count){
+		error = path + ": bad size or resolution";
+	} else{
+		map = m;
+		map_size = st.st_size;
+		cells = static_cast<const uint8_t *>(m) + sizeof(h);
+		nx = h.nx;
+		ny = h.ny;
+		nz = h.nz;
+		resolution = h.resolution;
+		std::memcpy(origin, h.origin, sizeof(origin));
+		return true;
+	}
+	munmap(m, st.st_size);
+	return false;
+}
+
+bool OccupancyGrid::Loaded() const {
+	return cells != nullptr;
+}
+
+void OccupancyGrid::Inflate(float radius){
+	inflated.clear();
+	int r = int(std::ceil(radius/resolution));
+	if (!cells || r <= 0){ return; }
+	// Spherical kernel, applied around every occupied cell
+	std::vector<int> kernel;
+	for (int dz = -r; dz <= r; dz++) {
+		for (int dy = -r; dy <= r; dy++) {
+			for (int dx = -r; dx <= r; dx++) {
+				if (dx*dx + dy*dy + dz*dz > r*r){ continue; }
+				kernel.push_back(dx);
+				kernel.push_back(dy);
+				kernel.push_back(dz);
+			}
+		}
+	}
+	inflated.assign(size_t(nx)*ny*nz, 0);
+	for (int z = 0; z < nz; z++) {
+		for (int y = 0; y < ny; y++) {
+			for (int x = 0; x < nx; x++) {
+				if (!Occupied(x, y, z)){ continue; }
+				for (size_t k = 0; k < kernel.size(); k += 3) {
+					int cx = x + kernel[k], cy = y + kernel[k+1], cz = z + kernel[k+2];
+					if (Inside(cx, cy, cz)){ inflated[Index(cx, cy, cz)] = 1; }
+				}
+			}
+		}
+	}
+}
+
+bool OccupancyGrid::Blocked(int x, int y, int z) const {
+	if (!Inside(x, y, z)){ return true; }
+	int i = Index(x, y, z);
+	return inflated.empty() ? cells[i] != 0 : inflated[i] != 0;
+}
+
+bool OccupancyGrid::World_To_Cell(const float pos[3], int cell[3]) const {
+	for (int i = 0; i < 3; i++) {
+		cell[i] = int(std::floor((pos[i] - origin[i])/resolution));
+	}
+	return Inside(cell[0], cell[1], cell[2]);
+}
+
+void OccupancyGrid::Cell_To_World(const int cell[3], float pos[3]) const {
+	for (int i = 0; i < 3; i++) {
+		pos[i] = origin[i] + (cell[i] + 0.5f)*resolution;
+	}
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,175 @@
+/**
+ * @file /src/planner_plugin.cpp
+ *
+ * @brief Loading of runtime planner libraries.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "../include/outdoor_gcs/planner_plugin.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+// A file still being written maps past its end and faults once touched: every segment and the
+// section table have to be in it
+bool whole_elf(int fd, std::string &error){
+	off_t size = ::lseek(fd, 0, SEEK_END);
+	Elf64_Ehdr eh;
+	if (::pread(fd, &eh, sizeof(eh), 0) != ssize_t(sizeof(eh)) || std::memcmp(eh.e_ident, ELFMAG, SELFMAG) != 0 ||
+			eh.e_ident[EI_CLASS] != ELFCLASS64){
+		error = "not a 64-bit ELF file";
+		return false;
+	}
+	bool whole = uint64_t(eh.e_shoff) + uint64_t(eh.e_shnum)*eh.e_shentsize <= uint64_t(size) &&
+			uint64_t(eh.e_phoff) + uint64_t(eh.e_phnum)*sizeof(Elf64_Phdr) <= uint64_t(size);
+	for (int k = 0; whole && k < eh.e_phnum; k++) {
+		Elf64_Phdr ph;
+		whole = ::pread(fd, &ph, sizeof(ph), eh.e_phoff + k*sizeof(ph)) == ssize_t(sizeof(ph)) &&
+				ph.p_offset + ph.p_filesz <= uint64_t(size);
+	}
+	if (!whole){ error = "cut short (still being written)"; }
+	return whole;
+}
+
+// dlopen of a file already open hands back the old image, so every load maps a copy of its own;
+// the copy is unlinked once mapped
+void *open_copy(const std::string &path, std::string &error){
+	int in = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (in < 0){
+		error = path + ": " + std::strerror(errno);
+		return nullptr;
+	}
+	const char *dir = std::getenv("TMPDIR");
+	std::string copy = std::string(dir && *dir ? dir : "/tmp") + "/outdoor_gcs_planner_XXXXXX.so";
+	int out = ::mkstemps(&copy[0], 3);
+	if (out < 0){
+		error = copy + ": " + std::strerror(errno);
+		::close(in);
+		return nullptr;
+	}
+	char buf[65536];
+	ssize_t n;
+	bool copied = true;
+	while ((n = ::read(in, buf, sizeof(buf))) != 0) {
+		if (n < 0 || ::write(out, buf, n) != n){
+			copied = false;
+			break;
+		}
+	}
+	::close(in);
+	std::string bad;
+	copied = copied && whole_elf(out, bad);
+	copied = ::close(out) == 0 && copied;
+	void *handle = nullptr;
+	if (!copied){
+		error = path + ": " + (bad.empty() ? "copy to " + copy + " failed" : bad);
+	} else if (!(handle = dlopen(copy.c_str(), RTLD_NOW | RTLD_LOCAL))){
+		error = path + ": " + dlerror();
+	}
+	::unlink(copy.c_str());
+	return handle;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+PlannerLibrary::~PlannerLibrary() {
+	if (plugin && destroy){
+		destroy(plugin);
+	}
+	if (handle){
+		dlclose(handle);
+	}
+}
+
+std::unique_ptr<PlannerLibrary> PlannerLibrary::Load(const std::string &path, std::string &error){
+	std::unique_ptr<PlannerLibrary> lib(new PlannerLibrary);
+	lib->path = path;
+	lib->handle = open_copy(path, error);
+	if (!lib->handle){
+		return nullptr;
+	}
+	typedef int (*api_fn)();
+	typedef PlannerPlugin *(*create_fn)();
+	typedef void (*destroy_fn)(PlannerPlugin *);
+	api_fn api = reinterpret_cast<api_fn>(dlsym(lib->handle, "outdoor_gcs_planner_api"));
+	create_fn create = reinterpret_cast<create_fn>(dlsym(lib->handle, "outdoor_gcs_create_planner"));
+	lib->destroy = reinterpret_cast<destroy_fn>(dlsym(lib->handle, "outdoor_gcs_destroy_planner"));
+	if (!api || !create || !lib->destroy){
+		error = path + ": not a planner plugin (OUTDOOR_GCS_PLANNER_PLUGIN missing)";
+		return nullptr;
+	}
+	if (api() != OUTDOOR_GCS_PLANNER_API){
+		error = path + ": built for planner API " + std::to_string(api()) + ", expected " + std::to_string(OUTDOOR_GCS_PLANNER_API);
+		return nullptr;
+	}
+	lib->plugin = create();
+	if (!lib->plugin){
+		error = path + ": create failed";
+		return nullptr;
+	}
+	lib->name = lib->plugin->Name();
+	lib->stat.name = lib->name;
+	return lib;
+}
+
+const std::string &PlannerLibrary::Name() const {
+	return name;
+}
+
+const std::string &PlannerLibrary::Path() const {
+	return path;
+}
+
+void PlannerLibrary::Configure(const std::map<std::string, float> &params){
+	plugin->Configure(params);
+}
+
+void PlannerLibrary::Plan(const planner_input &in, planner_command *out){
+	for (int k = 0; k < in.num_hosts; k++) {
+		out[k].type = 0;
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	plugin->Plan(in, out);
+	float us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	stat.ticks++;
+	stat.last_us = us;
+	stat.mean_us += (us - stat.mean_us)/stat.ticks;
+	stat.max_us = std::max(stat.max_us, us);
+	if (us > in.budget*1e6){
+		stat.over_budget++;
+	}
+}
+
+plugin_stat PlannerLibrary::GetStat() const {
+	return stat;
+}
+
+}  // namespace outdoor_gcs
@@ -12,6 +12,7 @@
 
 #include <ros/ros.h>
 #include <ros/network.h>
+#include <algorithm>
 #include <string>
 #include <std_msgs/String.h>
 #include <sstream>
@@ -30,7 +31,12 @@ namespace outdoor_gcs {
 QNode::QNode(int argc, char** argv ) :
 	init_argc(argc),
 	init_argv(argv)
-	{}
+	{
+		for (int i = 0; i < 9; i++) {
+			fence_clamped[i] = 0;
+			fence_rejected[i] = 0;
+		}
+	}
 
 QNode::~QNode() {
     if(ros::isStarted()) {
@@ -38,15 +44,168 @@ QNode::~QNode() {
 		ros::waitForShutdown();
     }
 	wait();
+	if (stream_thread.joinable()){
+		stream_thread.join();
+	}
+	BinLog::Close();
 }
 
 bool QNode::init() {
 	ros::init(init_argc,init_argv,"outdoor_gcs");
 	if ( ! ros::master::check() ) {
+		init_error = "Couldn't find the ros master.";
+		return false;
+	}
+	if (Other_GCS(init_error)){
 		return false;
 	}
 	ros::start(); // explicitly needed since our nodehandle is going out of scope.
 	ros::NodeHandle n;
+	ros::NodeHandle nh("~");
+
+	nh.param<bool>("control_command", control_cmd, true); // per-vehicle /uavN/px4_command/control_command
+	nh.param<bool>("fleet_command", fleet_cmd, false); // one batched /uavs/fleet_command per loop
+	nh.param<float>("stream_rate", stream_rate, 0.0); // [Hz] setpoint streaming rate, 20~50 Hz when used
+	nh.param<bool>("stream_cubic", streamer.cubic, true); // cubic Hermite or linear interpolation
+	nh.param<std::string>("square_shape", square_shape, "polyline");
+	nh.param<std::string>("circle_shape", circle_shape, "circle");
+	nh.param<bool>("predict_state", predict_state, true);
+	nh.param<float>("cmd_latency", cmd_latency, 0.05);
+	nh.param<float>("snapshot_stale", snapshot_stale, 0.5); // [s] odometry older than this leaves the common snapshot time
+	nh.param<bool>("event_planning", event_planning, false); // replan on odometry instead of the loop tick
+	nh.param<float>("event_rate", event_rate, 20.0); // [Hz] max replanning rate of one uav in event mode
+	nh.param<std::string>("goal_assignment", goal_assignment, "none");
+	nh.param<bool>("local_pathplan", local_pathplan, false);
+	nh.param<float>("downwash_scale", downwash_scale, 2.0);
+	std::string occupancy_map;
+	nh.param<std::string>("occupancy_map", occupancy_map, "");
+	nh.param<float>("occupancy_inflate", occupancy_inflate, 0.5);
+	nh.param<float>("cbs_budget", cbs_budget, 1.0);
+	nh.param<float>("cbs_suboptimality", cbs_suboptimality, 1.2);
+	nh.param<float>("obstacle_gain", obstacle_gain, 50.0);
+	nh.param<float>("obstacle_range", obstacle_range, 2.0);
+	float sep_param[2];
+	nh.param<float>("separation_threshold", sep_param[0], 2.0);
+	nh.param<float>("separation_horizon", sep_param[1], 5.0);
+	nh.param<bool>("separation_planned", separation_planned, false);
+	separation.Configure(sep_param[0], sep_param[1]);
+	std::string geofence_file;
+	nh.param<std::string>("geofence_file", geofence_file, "");
+	nh.param<bool>("geofence_clamp", geofence_clamp, true);
+	nh.param<float>("sync_delay", sync_delay, 0.0);
+	nh.param<float>("takeoff_stagger", takeoff_stagger, 0.0);
+	scheduler.reset(new CommandScheduler(DroneNumber));
+	std::string event_log_file;
+	nh.param<std::string>("event_log_file", event_log_file, "");
+	if (!event_log_file.empty()){
+		std::string error;
+		if (!events.Open_Spill(event_log_file, error)){
+			ROS_ERROR("Event log file not opened: %s", error.c_str());
+		}
+	}
+	std::string binlog_file;
+	nh.param<std::string>("binlog_file", binlog_file, ""); // binary diagnostics log, see log_decode
+	if (!binlog_file.empty()){
+		std::string error;
+		if (!BinLog::Open(binlog_file, error)){
+			ROS_ERROR("Binary log not opened: %s", error.c_str());
+		}
+	}
+	std::string control_socket;
+	nh.param<std::string>("control_socket", control_socket, headless ? "/tmp/outdoor_gcs.sock" : "");
+	if (!control_socket.empty()){
+		std::string error;
+		if (control.Open(control_socket, error)){
+			ROS_INFO("Control socket %s", control_socket.c_str());
+		} else{
+			ROS_ERROR("Control socket not opened: %s", error.c_str());
+		}
+	}
+	std::string clock_mode;
+	float clock_window;
+	nh.param<std::string>("clock_sync", clock_mode, "off");
+	nh.param<float>("clock_window", clock_window, 60.0); // [s] of samples behind the offset and drift
+	clock_exchange = clock_mode == "exchange";
+	clock_passive = clock_exchange || clock_mode == "passive"; // passive until the responder answers
+	clock_sync.Configure(clock_window);
+	float trace_timeout;
+	nh.param<float>("trace_timeout", trace_timeout, 1.0); // [s] a command not echoed by then counts as dropped
+	tracer.Configure(trace_timeout);
+	std::string fleet_shm_name;
+	nh.param<std::string>("fleet_shm", fleet_shm_name, ""); // e.g. /outdoor_gcs_fleet, see fleet_shm.hpp
+	bool fleet_shm_reuse;
+	nh.param<bool>("fleet_shm_reuse", fleet_shm_reuse, false); // replace a segment of that name left by a crashed GCS
+	if (!fleet_shm_name.empty()){
+		std::string error;
+		if (!fleet_shm.Open(fleet_shm_name, fleet_shm_reuse, error)){
+			ROS_ERROR("Fleet shared memory not opened: %s", error.c_str());
+		}
+	}
+	nh.param<int>("ready_fix", ready_criteria.min_fix, 5);
+	nh.param<int>("ready_satellites", ready_criteria.min_satellites, 10);
+	nh.param<float>("ready_hdop", ready_criteria.max_hdop, 1.5);
+	nh.param<float>("ready_h_acc", ready_criteria.max_h_acc, 0.5);
+	nh.param<float>("ready_age", ready_criteria.max_age, 1.0);
+	nh.param<bool>("ready_home", ready_criteria.home, true);
+	nh.param<std::string>("mission_file", mission_file, "");
+	if (!mission_file.empty()){
+		std::string error;
+		if (mission.Load(mission_file, error)){
+			ROS_INFO("Mission %s: %d steps, start with /uavs/mission_start", mission_file.c_str(), mission.Status(0).steps);
+		} else{
+			ROS_ERROR("Mission not loaded: %s", error.c_str());
+		}
+	}
+	if (!geofence_file.empty()){
+		std::string error;
+		if (geofence.Load(geofence_file, error)){
+			ROS_INFO("Geofence %s: %d polygons", geofence_file.c_str(), geofence.Polygons());
+		} else{
+			ROS_ERROR("Geofence not loaded: %s", error.c_str());
+		}
+	}
+	if (!occupancy_map.empty()){
+		std::string error;
+		if (occupancy.Load(occupancy_map, error)){
+			occupancy.Inflate(occupancy_inflate);
+			ROS_INFO("Occupancy map %s: %dx%dx%d cells of %.2f m", occupancy_map.c_str(),
+					occupancy.Nx(), occupancy.Ny(), occupancy.Nz(), occupancy.Resolution());
+			ros::WallTime start = ros::WallTime::now();
+			if (obstacle_field.Build(occupancy)){
+				ROS_INFO("Obstacle distance field: %.1f MB, built in %.0f ms", obstacle_field.Bytes()/1e6,
+						(ros::WallTime::now() - start).toSec()*1e3);
+			}
+		} else{
+			ROS_ERROR("Occupancy map not loaded: %s", error.c_str());
+		}
+	}
+	std::vector<std::string> plugin_paths;
+	std::string planner;
+	nh.param<std::vector<std::string> >("planner_plugins", plugin_paths, std::vector<std::string>());
+	nh.param<std::string>("planner", planner, "");
+	nh.getParam("planner_params", planner_params);
+	for (const auto &path : plugin_paths){
+		Load_Planner(path);
+	}
+	for (size_t k = 0; k < planner_libs.size(); k++) { // used once uavs are switched to Plan_Dim 20
+		if (planner_libs[k]->Name() == planner){ active_planner = k; }
+	}
+	Update_Plugin_Stats();
+	int plan_threads;
+	nh.param<int>("plan_threads", plan_threads, 1); // threads planning the uavs of one tick
+	if (plan_threads > 1){
+		plan_pool.reset(new ThreadPool(plan_threads));
+	}
+	float kf_param[5]; // jerk noise, pos / vel / acc std, max prediction horizon
+	nh.param<float>("predict_q_jerk", kf_param[0], 20.0);
+	nh.param<float>("predict_r_pos", kf_param[1], 0.05);
+	nh.param<float>("predict_r_vel", kf_param[2], 0.1);
+	nh.param<float>("predict_r_acc", kf_param[3], 0.5);
+	nh.param<float>("predict_horizon", kf_param[4], 0.5);
+	for (int i = 0; i < DroneNumber; i++) {
+		predictor[i].Configure(kf_param[0], kf_param[1], kf_param[2], kf_param[3], kf_param[4]);
+	}
+	snap.resize(DroneNumber);
 	
 	// uav_state_sub 	= n.subscribe<mavros_msgs::State>("/mavros/state", 1, &QNode::state_callback, this);
 	uav_imu_sub 	= n.subscribe<Imu>("/mavros/imu/data", 1, &QNode::imu_callback, this);
@@ -75,6 +234,10 @@ bool QNode::init() {
 		uavs_gpsL_sub[i] 	= n.subscribe<Gpslocal>("/uav" + std::to_string(i+1) + "/mavros/global_position/local", 1, std::bind(&QNode::uavs_gpsL_callback, this, std::placeholders::_1, i));
 		uavs_from_sub[i] 	= n.subscribe<mavros_msgs::Mavlink>("/uav" + std::to_string(i+1) + "/mavlink/from", 1, std::bind(&QNode::uavs_from_callback, this, std::placeholders::_1, i));
 		uavs_log_sub[i]		= n.subscribe<outdoor_gcs::Topic_for_log>("/uav" + std::to_string(i+1) + "/px4_command/topic_for_log", 1, std::bind(&QNode::uavs_log_callback, this, std::placeholders::_1, i));
+		if (clock_exchange){
+			uavs_timesync_sub[i] = n.subscribe<outdoor_gcs::TimeSync>("/uav" + std::to_string(i+1) + "/timesync/response", 10, std::bind(&QNode::uavs_timesync_callback, this, std::placeholders::_1, i));
+			uavs_timesync_pub[i] = n.advertise<outdoor_gcs::TimeSync>("/uav" + std::to_string(i+1) + "/timesync/request", 10);
+		}
 
 		uavs_setpoint_pub[i] 		= n.advertise<PosTarg>("/uav" + std::to_string(i+1) + "/mavros/setpoint_raw/local", 1);
 		uavs_setpoint_alt_pub[i] 	= n.advertise<AltTarg>("/uav" + std::to_string(i+1) + "/mavros/setpoint_raw/attitude", 1);
@@ -92,22 +255,79 @@ bool QNode::init() {
 	}
 	uavs_pathplan_sub = n.subscribe<outdoor_gcs::PathPlan>("/uavs/pathplan_nxt",1, &QNode::uavs_pathplan_callback, this);
 	uavs_pathplan_pub = n.advertise<outdoor_gcs::PathPlan>("/uavs/pathplan",1);
+	uavs_fleet_pub = n.advertise<outdoor_gcs::FleetCommand>("/uavs/fleet_command",1);
+	planner_select_sub = n.subscribe<std_msgs::String>("/uavs/select_planner", 1, &QNode::planner_select_callback, this);
+	schedule_sub = n.subscribe<std_msgs::String>("/uavs/schedule", 10, &QNode::schedule_callback, this);
+	mission_start_srv = n.advertiseService("/uavs/mission_start", &QNode::mission_start_callback, this);
+	mission_abort_srv = n.advertiseService("/uavs/mission_abort", &QNode::mission_abort_callback, this);
+	preflight_srv = n.advertiseService("/uavs/preflight", &QNode::preflight_callback, this);
 	last_change = ros::Time::now();
+	Setup_Metrics();
+	int metrics_port;
+	std::string metrics_file;
+	float metrics_period;
+	nh.param<int>("metrics_port", metrics_port, 0); // Prometheus text on 127.0.0.1
+	nh.param<std::string>("metrics_file", metrics_file, ""); // binary snapshots, see metrics_dump
+	nh.param<float>("metrics_period", metrics_period, 1.0); // [s] between snapshots
+	if (metrics_port > 0 || !metrics_file.empty()){
+		std::string error;
+		if (metrics.Open(metrics_port, metrics_file, metrics_period, error)){
+			ROS_INFO("Metrics: %d series%s", metrics.Series(),
+					metrics_port > 0 ? (", http://127.0.0.1:" + std::to_string(metrics_port) + "/metrics").c_str() : "");
+		} else{
+			ROS_ERROR("Metrics not opened: %s", error.c_str());
+		}
+	}
+	if (headless){
+		ROS_INFO("Headless: %s", Detect_UAVs().c_str());
+	}
 
 	start();
+	if (stream_rate > 0){
+		stream_thread = std::thread(&QNode::stream_loop, this);
+	}
 	return true;
 }
 
 void QNode::run() {
 	ros::Rate loop_rate(freq); // change update rate here
+	ros::WallTime tick_start;
 
 	while ( ros::ok() ) {
+		ros::WallTime t = ros::WallTime::now();
+		if (!tick_start.isZero()){
+			double period = (t - tick_start).toSec();
+			m_loop_period->Add(period);
+			m_loop_jitter->Add(std::fabs(period - 1.0/freq));
+		}
+		tick_start = t;
 
+		Apply_Moves();
 		pub_command();
+		t = Stage_Done(Stage_Command, t);
 		UAVS_Do_Plan(); // for multi-uav
+		t = Stage_Done(Stage_Plan, t);
+		Run_Mission();
+		t = Stage_Done(Stage_Mission, t);
+		Check_Separation();
+		t = Stage_Done(Stage_Separation, t);
+		Check_Preflight();
+		t = Stage_Done(Stage_Preflight, t);
+		Publish_Fleet_Shm();
+		t = Stage_Done(Stage_Shm, t);
 		uavs_call_service(); // for multi-uav
+		t = Stage_Done(Stage_Service, t);
 		uavs_pub_command(); // for multi-uav
+		Request_Timesync();
+		t = Stage_Done(Stage_Publish, t);
 		ros::spinOnce();
+		t = Stage_Done(Stage_Spin, t);
+		if (int dropped = tracer.Check(ros::WallTime::now().toSec())){
+			GCS_LOG(Log_Warn, "trace: %d commands not echoed in time", dropped);
+		}
+		Run_Control();
+		Stage_Done(Stage_Control, t);
+		Update_Metrics();
 
 		uav_received.stateReceived = false;
 		uav_received.imuReceived = false;
@@ -172,9 +392,59 @@ void QNode::run() {
 		loop_rate.sleep();
 	}
 	std::cout << "Ros shutdown, proceeding to close the gui." << std::endl;
+	GCS_LOG(Log_Info, "ros shutdown, %llu entries dropped", (unsigned long long)BinLog::Dropped());
 	Q_EMIT rosShutdown(); // used to signal the gui for a shutdown (useful to roslaunch)
 }
 
+void QNode::stream_loop() {
+	// Runs beside the planner loop, sending interpolated references of every moving uav
+	ros::Rate loop_rate(stream_rate);
+
+	while ( ros::ok() ) {
+		ros::Time now = ros::Time::now();
+		streamer.Record_Tick(ros::WallTime::now(), 1.0/stream_rate);
+
+		outdoor_gcs::FleetCommand fleet_command;
+		for (int ind = 0; ind < DroneNumber; ind++) {
+			outdoor_gcs::ControlCommand command;
+			if (!streamer.Sample(ind, now, command.Reference_State)){ continue; }
+			float pos[3] = {command.Reference_State.position_ref[0], command.Reference_State.position_ref[1], command.Reference_State.position_ref[2]};
+			// Clamp from the odometry history, uavs_gpsL_callback rewrites pos_cur meanwhile
+			stamped_state latest = stamped_state();
+			if (geofence.Loaded() && !history[ind].Latest(latest)){ continue; }
+			if (!Fence_Command(ind, latest.pos, pos)){ continue; }
+			if (pos[0] != command.Reference_State.position_ref[0] || pos[1] != command.Reference_State.position_ref[1] ||
+					pos[2] != command.Reference_State.position_ref[2]){
+				for (int i = 0; i < 3; i++) { // clamped: stop on the fence
+					command.Reference_State.position_ref[i] = pos[i];
+					command.Reference_State.velocity_ref[i] = 0;
+					command.Reference_State.acceleration_ref[i] = 0;
+				}
+			}
+			command.header.stamp = now;
+			command.Mode = Trajectory_Tracking;
+			command.Command_ID = comid++;
+			if (control_cmd){
+				uavs_move_pub[ind].publish(command);
+			}
+			if (control_cmd || fleet_cmd){
+				tracer.Sent(ind, command.Command_ID, ros::WallTime::now().toSec());
+			}
+			if (fleet_cmd){
+				fleet_command.uav_index.push_back(ind);
+				fleet_command.Command_ID.push_back(command.Command_ID);
+				fleet_command.Mode.push_back(command.Mode);
+				fleet_command.Reference_State.push_back(command.Reference_State);
+			}
+		}
+		if (fleet_cmd && !fleet_command.uav_index.empty()){
+			fleet_command.header.stamp = now;
+			uavs_fleet_pub.publish(fleet_command);
+		}
+		loop_rate.sleep();
+	}
+}
+
 ///////////// Single uav ///////////////////
 void QNode::state_callback(const mavros_msgs::State::ConstPtr &msg){
 	uav_state = *msg;
@@ -207,6 +477,15 @@ void QNode::from_callback(const mavros_msgs::Mavlink::ConstPtr &msg){
 	uav_from = *msg;
 }
 
+template <class Service>
+bool QNode::Call_Service(ros::ServiceClient &client, Service &srv, Service_Kind kind){
+	ros::WallTime start = ros::WallTime::now();
+	bool called = client.call(srv);
+	m_service[kind]->Add((ros::WallTime::now() - start).toSec());
+	if (!called){ m_service_failed[kind]->Add(); }
+	return called;
+}
+
 void QNode::pub_command(){
 	uav_setpoint.header.stamp = ros::Time::now();
 	uav_setpoint_pub.publish(uav_setpoint);
@@ -214,11 +493,11 @@ void QNode::pub_command(){
 
 void QNode::Set_Arm(bool arm_disarm){
 	uav_arm.request.value = arm_disarm;
-	uav_arming_client.call(uav_arm);
+	Call_Service(uav_arming_client, uav_arm, Srv_Arming);
 }
 void QNode::Set_Mode(std::string command_mode){
 	uav_setmode.request.custom_mode = command_mode;
-	uav_setmode_client.call(uav_setmode);
+	Call_Service(uav_setmode_client, uav_setmode, Srv_Mode);
 	// std::cout << uav_setmode.response.mode_sent << std::endl;
 }
 void QNode::Set_Home(){
@@ -227,7 +506,7 @@ void QNode::Set_Home(){
 	// uav_sethome.request.latitude = uav_gps.lat*1e-7;
 	// uav_sethome.request.longitude = uav_gps.lon*1e-7;
 	// uav_sethome.request.altitude = uav_gps.alt/1000.0;
-	uav_sethome_client.call(uav_sethome);
+	Call_Service(uav_sethome_client, uav_sethome, Srv_Home);
 }
 void QNode::Set_GPS_Home(){
 	uav_gps_home.geo.latitude  = uav_gpsG.latitude;
@@ -259,10 +538,12 @@ void QNode::move_uav(bool mask[3], float target[4]){
     //Bit 1:x, bit 2:y, bit 3:z, bit 4:vx, bit 5:vy, bit 6:vz, bit 7:ax, bit 8:ay, bit 9:az, bit 10:is_force_sp, bit 11:yaw, bit 12:yaw_rate
     //Bit 10 should set to 0, means is not force sp
 	if (mask[0]){
+		float pos[3] = {target[0], target[1], target[2]};
+		if (!Fence_Setpoint(pos)){ return; } // the last setpoint stays
 		uav_setpoint.type_mask = 0b100111111000;
-		uav_setpoint.position.x = target[0];
-		uav_setpoint.position.y = target[1];
-		uav_setpoint.position.z = target[2];
+		uav_setpoint.position.x = pos[0];
+		uav_setpoint.position.y = pos[1];
+		uav_setpoint.position.z = pos[2];
 		uav_setpoint.yaw = (target[3])/180*3.14157;
 	}
 	else if (mask[1]){
@@ -287,10 +568,12 @@ void QNode::move_uav_keyboard(bool mask[3], float target[4]){
     //Bit 1:x, bit 2:y, bit 3:z, bit 4:vx, bit 5:vy, bit 6:vz, bit 7:ax, bit 8:ay, bit 9:az, bit 10:is_force_sp, bit 11:yaw, bit 12:yaw_rate
     //Bit 10 should set to 0, means is not force sp
 	if (mask[0]){
+		float pos[3] = {target[0], target[1], target[2]};
+		if (!Fence_Setpoint(pos)){ return; }
 		uav_setpoint.type_mask = 0b010111111000;
-		uav_setpoint.position.x = target[0];
-		uav_setpoint.position.y = target[1];
-		uav_setpoint.position.z = target[2];
+		uav_setpoint.position.x = pos[0];
+		uav_setpoint.position.y = pos[1];
+		uav_setpoint.position.z = pos[2];
 		uav_setpoint.yaw_rate = (target[3])/180*3.14157;
 	}
 	else if (mask[1]){
@@ -313,9 +596,11 @@ void QNode::move_uav_height(float height){
 	//Bitmask toindicate which dimensions should be ignored (1 means ignore,0 means not ignore; Bit 10 must set to 0)
     //Bit 1:x, bit 2:y, bit 3:z, bit 4:vx, bit 5:vy, bit 6:vz, bit 7:ax, bit 8:ay, bit 9:az, bit 10:is_force_sp, bit 11:yaw, bit 12:yaw_rate
     //Bit 10 should set to 0, means is not force sp
+	float pos[3] = {float(uav_gpsL.pose.pose.position.x), float(uav_gpsL.pose.pose.position.y), height};
+	if (!Fence_Setpoint(pos)){ return; }
     uav_setpoint.type_mask = 0b110111111011;
     uav_setpoint.coordinate_frame = 1;
-	uav_setpoint.position.z = height;
+	uav_setpoint.position.z = pos[2];
 }
 
 State QNode::GetState(){
@@ -352,35 +637,71 @@ outdoor_gcs::signalRec QNode::Get_uav_signal(){
 void QNode::uavs_call_service(){
 	for (const auto &ind : avail_uavind){
 		if (service_flag[ind] == 1){ // arm or disarm
-			uavs_arming_client[ind].call(uavs_arm[ind]);
+			Call_Service(uavs_arming_client[ind], uavs_arm[ind], Srv_Arming);
 			service_flag[ind] = 0;
 		}
 		else if (service_flag[ind] == 2){ // set mode (AUTO.TAKEOFF, AUTO.LAUBD, OFFBOARD ... etc)
 			if (!px4_apm && apm_landtoff[ind]!=0){
 				if (apm_landtoff[ind] == 1){
-					uavs_apm_land_client[ind].call(uavs_apm_landtoff[ind]); 
+					Call_Service(uavs_apm_land_client[ind], uavs_apm_landtoff[ind], Srv_Land);
 				} else if (apm_landtoff[ind] == 2){
-					uavs_apm_toff_client[ind].call(uavs_apm_landtoff[ind]); 
+					Call_Service(uavs_apm_toff_client[ind], uavs_apm_landtoff[ind], Srv_Takeoff);
 				}
 			} else{
-				uavs_setmode_client[ind].call(uavs_setmode[ind]);
+				Call_Service(uavs_setmode_client[ind], uavs_setmode[ind], Srv_Mode);
 			}
 			service_flag[ind] = 0;
 		}
 	}
 }
 
+void QNode::Pub_Move(int ind, outdoor_gcs::FleetCommand &fleet, pub_stat &stat){
+	// The pending command of ind on its own topic, and into the batch
+	if (control_cmd){
+		ros::WallTime pub_start = ros::WallTime::now();
+		uavs_move_pub[ind].publish(Command_List[ind]);
+		stat.time_us += (ros::WallTime::now() - pub_start).toSec()*1e6;
+		stat.bytes += ros::serialization::serializationLength(Command_List[ind]);
+	}
+	if (fleet_cmd){
+		fleet.uav_index.push_back(ind);
+		fleet.Command_ID.push_back(Command_List[ind].Command_ID);
+		fleet.Mode.push_back(Command_List[ind].Mode);
+		fleet.Reference_State.push_back(Command_List[ind].Reference_State);
+	}
+	stat.num++;
+	if (control_cmd || fleet_cmd){
+		tracer.Sent(ind, Command_List[ind].Command_ID, ros::WallTime::now().toSec());
+	}
+	pub_move_flag[ind] = false;
+	if (!plan_odom[ind].isZero()){
+		react_latency.Add((ros::Time::now() - plan_odom[ind]).toSec());
+	}
+}
+void QNode::Pub_Fleet(outdoor_gcs::FleetCommand &fleet, pub_stat &stat){
+	if (!fleet_cmd || fleet.uav_index.empty()){ return; }
+	ros::WallTime pub_start = ros::WallTime::now();
+	fleet.header.stamp = ros::Time::now();
+	uavs_fleet_pub.publish(fleet);
+	stat.time_us += (ros::WallTime::now() - pub_start).toSec()*1e6;
+	stat.bytes += ros::serialization::serializationLength(fleet);
+}
 void QNode::uavs_pub_command(){
 	bool pathplan_flag = false;
+	pub_stat stat;
+	Fleet_Command.uav_index.clear();
+	Fleet_Command.Command_ID.clear();
+	Fleet_Command.Mode.clear();
+	Fleet_Command.Reference_State.clear();
 	for (const auto &ind : avail_uavind){
 		if (pub_home_flag[ind]){ // gps set origin
 			uavs_gps_home_pub[ind].publish(uavs_gps_home[ind]);
 			pub_home_flag[ind] = false;
+			home_set[ind] = true;
 		}
 		if (pub_move_flag[ind]){
 			// uavs_setpoint_pub[ind].publish(uavs_setpoint[ind]);
-        	uavs_move_pub[ind].publish(Command_List[ind]);
-			pub_move_flag[ind] = false;
+			Pub_Move(ind, Fleet_Command, stat);
 		}
 		if (received_rtcm && pub_rtcm_flag){
 			uavs_gps_rtcm[ind].data = gps_rtcm.data;
@@ -392,6 +713,10 @@ void QNode::uavs_pub_command(){
 			pathplan_flag=true;
 		}
 	}
+	Pub_Fleet(Fleet_Command, stat);
+	cmd_pub_stat = stat;
+	m_command_bytes->Add(cmd_pub_stat.bytes);
+	GCS_LOG(Log_Debug, "publish: %d commands, %d bytes, %.1f us", cmd_pub_stat.num, cmd_pub_stat.bytes, cmd_pub_stat.time_us);
 	if (pathplan_flag){	
 		Update_PathPlan();
 		uavs_pathplan_pub.publish(uavs_pathplan); 
@@ -405,10 +730,13 @@ void QNode::rtcm_callback(const RTCM::ConstPtr &msg){
 void QNode::uavs_state_callback(const mavros_msgs::State::ConstPtr &msg, int ind){
 	uavs_state[ind] = *msg;
 	UAVs_info[ind].prestateReceived = true;
+	Count_Rx(ind, Rx_State);
+	rx_state[ind] = ros::WallTime::now();
 }
 void QNode::uavs_imu_callback(const sensor_msgs::Imu::ConstPtr &msg, int ind){
 	uavs_imu[ind] = *msg;
 	UAVs_info[ind].preimuReceived = true;
+	Count_Rx(ind, Rx_Imu);
 	UAVs_info[ind].acc_cur[0] = uavs_imu[ind].linear_acceleration.x;
 	UAVs_info[ind].acc_cur[1] = uavs_imu[ind].linear_acceleration.y;
 	UAVs_info[ind].acc_cur[2] = uavs_imu[ind].linear_acceleration.z;
@@ -417,31 +745,81 @@ void QNode::uavs_imu_callback(const sensor_msgs::Imu::ConstPtr &msg, int ind){
 	UAVs_info[ind].ang_cur[0] = uav_euler.roll*180/3.14159;
 	UAVs_info[ind].ang_cur[1] = uav_euler.pitch*180/3.14159;
 	UAVs_info[ind].ang_cur[2] = uav_euler.yaw*180/3.14159;
+
+	// Body-frame specific force to ENU acceleration for the predictor
+	float w = quat[0], x = quat[1], y = quat[2], z = quat[3];
+	float *a = UAVs_info[ind].acc_cur;
+	float acc_enu[3];
+	acc_enu[0] = (1-2*(y*y+z*z))*a[0] + 2*(x*y-w*z)*a[1] + 2*(x*z+w*y)*a[2];
+	acc_enu[1] = 2*(x*y+w*z)*a[0] + (1-2*(x*x+z*z))*a[1] + 2*(y*z-w*x)*a[2];
+	acc_enu[2] = 2*(x*z-w*y)*a[0] + 2*(y*z+w*x)*a[1] + (1-2*(x*x+y*y))*a[2] - 9.81;
+	predictor[ind].Update_Acceleration(Stamp_To_GCS(ind, msg->header.stamp), acc_enu);
 }
 void QNode::uavs_gps_callback(const outdoor_gcs::GPSRAW::ConstPtr &msg, int ind){
 	uavs_gps[ind] = *msg;
 	UAVs_info[ind].pregpsReceived = true;
+	Count_Rx(ind, Rx_Gps);
+	rx_gps[ind] = ros::WallTime::now();
 }
 void QNode::uavs_gpsG_callback(const Gpsglobal::ConstPtr &msg, int ind){
 	uavs_gpsG[ind] = *msg;
+	Count_Rx(ind, Rx_Global);
 }
 void QNode::uavs_gpsL_callback(const Gpslocal::ConstPtr &msg, int ind){
 	uavs_gpsL[ind] = *msg;
 	UAVs_info[ind].pregpsLReceived = true;
+	Count_Rx(ind, Rx_Odom);
+	rx_odom[ind] = ros::WallTime::now();
+	if (clock_passive){
+		clock_sync.Add_Passive(ind, msg->header.stamp.toSec(), ros::Time::now().toSec());
+	}
+	ros::Time stamp = Stamp_To_GCS(ind, msg->header.stamp);
 	UAVs_info[ind].pos_cur[0] = uavs_gpsL[ind].pose.pose.position.x;
 	UAVs_info[ind].pos_cur[1] = uavs_gpsL[ind].pose.pose.position.y;
 	UAVs_info[ind].pos_cur[2] = uavs_gpsL[ind].pose.pose.position.z;
 	UAVs_info[ind].vel_cur[0] = uavs_gpsL[ind].twist.twist.linear.x;
 	UAVs_info[ind].vel_cur[1] = uavs_gpsL[ind].twist.twist.linear.y;
 	UAVs_info[ind].vel_cur[2] = -uavs_gpsL[ind].twist.twist.linear.z; //Somehow z-velocity is in opposite direction
+	predictor[ind].Update_Odometry(stamp, UAVs_info[ind].pos_cur, UAVs_info[ind].vel_cur);
+	stamped_state state;
+	state.stamp = stamp;
+	for (int i = 0; i < 3; i++) {
+		state.pos[i] = UAVs_info[ind].pos_cur[i];
+		state.vel[i] = UAVs_info[ind].vel_cur[i];
+	}
+	history[ind].Push(state);
+	if (event_planning){
+		Plan_Event(ind);
+	}
 }
 void QNode::uavs_from_callback(const mavros_msgs::Mavlink::ConstPtr &msg, int ind){
 	uavs_from[ind] = *msg;
 	UAVs_info[ind].id = uavs_from[ind].sysid;
 }
 
+ros::Time QNode::Stamp_To_GCS(int ind, const ros::Time &stamp){
+	if (!clock_passive || stamp.isZero()){ return stamp; }
+	return ros::Time(clock_sync.To_GCS(ind, stamp.toSec()));
+}
+void QNode::Request_Timesync(){
+	// Once a second; the estimator keeps the shortest round trip of each second
+	if (!clock_exchange || (ros::WallTime::now() - timesync_last).toSec() < 1.0){ return; }
+	timesync_last = ros::WallTime::now();
+	outdoor_gcs::TimeSync request;
+	request.seq = timesync_seq++;
+	for (const auto &ind : avail_uavind){
+		request.gcs_send = ros::Time::now();
+		uavs_timesync_pub[ind].publish(request);
+	}
+}
+void QNode::uavs_timesync_callback(const outdoor_gcs::TimeSync::ConstPtr &msg, int ind){
+	clock_sync.Add_Exchange(ind, msg->gcs_send.toSec(), msg->vehicle_receive.toSec(), msg->vehicle_send.toSec(),
+			ros::Time::now().toSec());
+}
 void QNode::uavs_log_callback(const outdoor_gcs::Topic_for_log::ConstPtr &msg, int ind){
 	uavs_log[ind] = *msg;
+	Count_Rx(ind, Rx_Log);
+	tracer.Echoed(ind, msg->Control_Command.Command_ID, ros::WallTime::now().toSec());
 }
 void QNode::uavs_pathplan_callback(const outdoor_gcs::PathPlan::ConstPtr &msg){
 	uavs_pathplan_nxt = *msg;
@@ -464,28 +842,539 @@ void QNode::Set_Arm_uavs(bool arm_disarm, int ind){
 }
 
 void QNode::Set_Mode_uavs(std::string command_mode, int ind){
-	uavs_setmode[ind].request.custom_mode = command_mode;
-	if (!px4_apm){
-		apm_landtoff[ind] = 0;
+	apm_landtoff[ind] = Fill_Mode(ind, command_mode, uavs_setmode[ind], uavs_apm_landtoff[ind]);
+	service_flag[ind] = 2;
+}
+// Returns 1 for an APM land, 2 for an APM takeoff (landtoff filled), 0 for a plain mode change
+int QNode::Fill_Mode(int ind, const std::string &command_mode, mavros_msgs::SetMode &setmode, mavros_msgs::CommandTOL &landtoff){
+	setmode.request.custom_mode = command_mode;
+	if (px4_apm){ return 0; }
+	if (command_mode == "AUTO.LAND" || command_mode == "AUTO.TAKEOFF"){
+		landtoff.request.min_pitch = 0.0;
+		landtoff.request.yaw = 0.0;
+		landtoff.request.latitude = uavs_gpsG[ind].latitude;
+		landtoff.request.longitude = uavs_gpsG[ind].longitude;
 		if (command_mode == "AUTO.LAND"){
-			apm_landtoff[ind] = 1;
-			uavs_apm_landtoff[ind].request.min_pitch = 0.0;
-			uavs_apm_landtoff[ind].request.yaw = 0.0;
-			uavs_apm_landtoff[ind].request.latitude = uavs_gpsG[ind].latitude;
-			uavs_apm_landtoff[ind].request.longitude = uavs_gpsG[ind].longitude;
-			uavs_apm_landtoff[ind].request.altitude = 0.0;
-		} else if (command_mode == "AUTO.TAKEOFF"){
-			apm_landtoff[ind] = 2;
-			uavs_apm_landtoff[ind].request.min_pitch = 0.0;
-			uavs_apm_landtoff[ind].request.yaw = 0.0;
-			uavs_apm_landtoff[ind].request.latitude = uavs_gpsG[ind].latitude;
-			uavs_apm_landtoff[ind].request.longitude = uavs_gpsG[ind].longitude;
-			uavs_apm_landtoff[ind].request.altitude = uavs_gpsG[ind].altitude + 2.5;
-		} else if (command_mode == "OFFBOARD"){
-			uavs_setmode[ind].request.custom_mode = "GUIDED";
+			landtoff.request.altitude = 0.0;
+			return 1;
 		}
+		landtoff.request.altitude = uavs_gpsG[ind].altitude + 2.5;
+		return 2;
+	} else if (command_mode == "OFFBOARD"){
+		setmode.request.custom_mode = "GUIDED";
 	}
-	service_flag[ind] = 2;
+	return 0;
+}
+void QNode::Call_Mode(int ind, const std::string &command_mode){
+	mavros_msgs::SetMode setmode;
+	mavros_msgs::CommandTOL landtoff;
+	int apm = Fill_Mode(ind, command_mode, setmode, landtoff);
+	bool sent;
+	if (apm == 1){
+		sent = Call_Service(uavs_apm_land_client[ind], landtoff, Srv_Land) && landtoff.response.success;
+	} else if (apm == 2){
+		sent = Call_Service(uavs_apm_toff_client[ind], landtoff, Srv_Takeoff) && landtoff.response.success;
+	} else{
+		sent = Call_Service(uavs_setmode_client[ind], setmode, Srv_Mode) && setmode.response.mode_sent;
+	}
+	if (!sent){
+		ROS_WARN("Scheduled %s of uav%d not accepted", command_mode.c_str(), ind+1);
+	}
+}
+int QNode::Schedule_Fleet(const std::string &action, const std::vector<int> &uavs, double at, double stagger){
+	static const std::map<std::string, std::string> modes = {{"takeoff", "AUTO.TAKEOFF"}, {"land", "AUTO.LAND"},
+			{"rtl", "AUTO.RTL"}, {"loiter", "AUTO.LOITER"}, {"posctl", "POSCTL"}, {"offboard", "OFFBOARD"}};
+	std::function<void(int)> f;
+	if (action == "arm" || action == "disarm"){
+		bool arm = action == "arm";
+		f = [this, arm](int ind){
+			mavros_msgs::CommandBool srv;
+			srv.request.value = arm;
+			if (!Call_Service(uavs_arming_client[ind], srv, Srv_Arming) || !srv.response.success){
+				ROS_WARN("Scheduled %s of uav%d not accepted", arm ? "arm" : "disarm", ind+1);
+			}
+		};
+	} else if (action == "move" || action == "stop"){ // the planner picks it up on the next tick, the same one for all
+		bool move = action == "move";
+		f = [this, move](int ind){
+			std::lock_guard<std::mutex> lock(move_mutex);
+			move_queue.push_back({ind, move});
+		};
+	} else if (modes.count(action) || (!action.empty() && std::none_of(action.begin(), action.end(), ::islower))){
+		std::string mode = modes.count(action) ? modes.at(action) : action;
+		f = [this, mode](int ind){ Call_Mode(ind, mode); };
+	} else{
+		return -1;
+	}
+	for (size_t k = 0; k < uavs.size(); k++) {
+		scheduler->Schedule(at + k*stagger, uavs[k], action + " uav" + std::to_string(uavs[k]+1), std::bind(f, uavs[k]));
+	}
+	ROS_INFO("Scheduled %s of %d uavs in %.3f s, %.2f s apart", action.c_str(), int(uavs.size()),
+			at - CommandScheduler::Wall_Now(), stagger);
+	return uavs.size();
+}
+bool QNode::mission_start_callback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res){
+	std::string error;
+	if (!mission_file.empty() && !mission.Load(mission_file, error)){ // pick up edits since the last start
+		res.success = false;
+		res.message = error;
+		return true;
+	}
+	if (!mission.Loaded()){
+		res.success = false;
+		res.message = "no mission, set ~mission_file";
+		return true;
+	}
+	mission.Start(ros::WallTime::now().toSec());
+	mission_active = true;
+	events.Append(-1, Event_Command, Event_Mission, "Mission " + mission_file + " started");
+	res.success = true;
+	res.message = "started, " + std::to_string(mission.Status(0).steps) + " steps";
+	ROS_INFO("Mission %s started", mission_file.c_str());
+	return true;
+}
+bool QNode::mission_abort_callback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res){
+	res.success = mission_active;
+	res.message = mission_active ? "aborted" : "no mission running";
+	mission.Abort("aborted");
+	return true;
+}
+void QNode::Run_Mission(){
+	if (!mission_active){ return; }
+	double now = ros::WallTime::now().toSec();
+	if (mission.Resume(now, std::bind(&QNode::Mission_Act, this, std::placeholders::_1),
+			std::bind(&QNode::Mission_Test, this, std::placeholders::_1))){ return; }
+	mission_active = false;
+	mission_status status = mission.Status(now);
+	char text[256];
+	GCS_LOG(Log_Info, "mission: ended at step %d/%d after %.1f s, %s", status.step+1, status.steps, status.elapsed,
+			status.done ? "done" : status.error);
+	if (status.done){
+		std::snprintf(text, sizeof(text), "Mission done in %.1f s", status.elapsed);
+		ROS_INFO("%s", text);
+		events.Append(-1, Event_Info, Event_Mission, text);
+	} else{
+		std::snprintf(text, sizeof(text), "Mission stopped at step %d/%d: %s", status.step+1, status.steps, status.error.c_str());
+		ROS_ERROR("%s", text);
+		events.Append(-1, Event_Error, Event_Mission, text);
+	}
+}
+bool QNode::Mission_Act(const mission_step &step){
+	GCS_LOG(Log_Info, "mission: line %d, %s", step.line, step.text);
+	std::vector<int> uavs(avail_uavind.begin(), avail_uavind.end());
+	if (uavs.empty()){ return false; }
+	if (step.name == "go"){
+		bool init = step.args[0] == "init";
+		Assign_Goals(init);
+		for (const auto &ind : uavs){
+			UAVs_info[ind].arrive = false;
+		}
+		Request_Global_Paths();
+		ROS_INFO("Mission: desired location of all uavs set to %s", init ? "Init" : "Fin");
+		return true;
+	}
+	// Fleet commands go out together from the scheduler lanes, the loop does not wait on the service calls
+	std::string action = step.name == "mode" ? step.args[0] : step.name;
+	double stagger = step.name != "mode" && !step.args.empty() ? std::atof(step.args[0].c_str()) : 0;
+	return Schedule_Fleet(action, uavs, CommandScheduler::Wall_Now(), stagger) > 0;
+}
+bool QNode::Mission_Test(const mission_step &step){
+	if (step.name == "paths"){ // after go: no global path plan queued or running
+		return !global_request && !global_job.valid();
+	}
+	if (avail_uavind.empty()){ return false; }
+	for (const auto &ind : avail_uavind){
+		bool holds;
+		if (step.name == "armed" || step.name == "disarmed"){
+			holds = uavs_state[ind].armed == (step.name == "armed");
+		} else if (step.name == "arrived"){
+			holds = UAVs_info[ind].arrive;
+		} else if (step.name == "mode"){
+			holds = uavs_state[ind].mode == step.args[0];
+		} else if (step.name == "ready"){
+			std::string reason;
+			holds = Readiness_Of(ind, reason) == 0;
+		} else{ // altitude
+			holds = UAVs_info[ind].pos_cur[2] >= std::atof(step.args[0].c_str());
+		}
+		if (!holds){ return false; }
+	}
+	return true;
+}
+unsigned QNode::Readiness_Of(int ind, std::string &reason){
+	readiness_input in;
+	const outdoor_gcs::GPSRAW &gps = uavs_gps[ind];
+	in.connected = uavs_state[ind].connected;
+	in.fix_type = rx_gps[ind].isZero() ? -1 : gps.fix_type;
+	in.satellites = rx_gps[ind].isZero() || gps.satellites_visible == 255 ? -1 : gps.satellites_visible;
+	in.hdop = rx_gps[ind].isZero() || gps.eph == 65535 ? -1 : gps.eph/100.0; // MAVLink sends DOP x 100
+	in.h_acc = rx_gps[ind].isZero() || gps.h_acc == 0 ? -1 : gps.h_acc/1000.0;
+	in.age = -1;
+	if (!rx_state[ind].isZero() && !rx_gps[ind].isZero() && !rx_odom[ind].isZero()){
+		ros::WallTime oldest = std::min(rx_state[ind], std::min(rx_gps[ind], rx_odom[ind]));
+		in.age = (ros::WallTime::now() - oldest).toSec();
+	}
+	in.home = home_set[ind];
+	return Check_Readiness(ready_criteria, in, reason);
+}
+void QNode::Check_Preflight(){
+	ros::WallTime start = ros::WallTime::now();
+	std::vector<int> uavs(avail_uavind.begin(), avail_uavind.end());
+	readiness_report report;
+	report.rows.resize(uavs.size());
+	std::map<int, int> row_of;
+	for (size_t k = 0; k < uavs.size(); k++) {
+		row_of[uavs[k]] = k;
+	}
+	For_Hosts(uavs, [this, &report, &row_of](int ind){
+		readiness_row &row = report.rows[row_of.at(ind)];
+		row.id = ind;
+		row.failed = Readiness_Of(ind, row.reason);
+	});
+	for (const auto &row : report.rows){
+		report.ready += row.failed == 0;
+	}
+	report.go = !uavs.empty() && report.ready == int(uavs.size());
+	report.time_us = (ros::WallTime::now() - start).toSec()*1e6;
+	std::lock_guard<std::mutex> lock(ready_mutex);
+	ready_report = report;
+}
+bool QNode::preflight_callback(std_srvs::Trigger::Request &req, std_srvs::Trigger::Response &res){
+	Check_Preflight();
+	readiness_report report = GetReadiness();
+	res.success = report.go;
+	res.message = std::string(report.go ? "GO" : "NO-GO") + ", " + std::to_string(report.ready) + "/" +
+			std::to_string(report.rows.size()) + " uavs ready";
+	for (const auto &row : report.rows){
+		res.message += "\nuav" + std::to_string(row.id+1) + ": " + (row.failed ? row.reason : "ready");
+	}
+	return true;
+}
+void QNode::schedule_callback(const std_msgs::String::ConstPtr &msg){
+	std::string error;
+	if (!Schedule_Text(msg->data, error)){
+		ROS_WARN("Schedule '%s': %s", msg->data.c_str(), error.c_str());
+	}
+}
+bool QNode::Schedule_Text(const std::string &text, std::string &error){
+	// "<action> [in <s> | at <unix s>] [stagger <s>] [uavs <1,2,...>]", or "cancel"
+	std::istringstream in(text);
+	std::string action, word;
+	in >> action;
+	if (action == "cancel"){
+		ROS_INFO("Cancelled %d scheduled commands", scheduler->Cancel_All());
+		return true;
+	}
+	double at = CommandScheduler::Wall_Now() + sync_delay;
+	double stagger = action == "takeoff" ? takeoff_stagger : 0;
+	std::vector<int> uavs(avail_uavind.begin(), avail_uavind.end());
+	while (in >> word) {
+		double value;
+		if (word == "in" && in >> value){
+			at = CommandScheduler::Wall_Now() + value;
+		} else if (word == "at" && in >> value){
+			at = value;
+		} else if (word == "stagger" && in >> value){
+			stagger = value;
+		} else if (word == "uavs" && in >> word){
+			uavs.clear();
+			std::istringstream list(word);
+			std::string id;
+			while (std::getline(list, id, ',')) {
+				int ind = std::atoi(id.c_str()) - 1;
+				if (ind >= 0 && ind < DroneNumber){ uavs.push_back(ind); }
+			}
+		} else{
+			error = "unexpected '" + word + "'";
+			return false;
+		}
+	}
+	if (Schedule_Fleet(action, uavs, at, stagger) < 0){
+		error = "unknown action";
+		return false;
+	}
+	return true;
+}
+
+void QNode::Set_Headless(bool on){
+	headless = on;
+}
+bool QNode::Other_GCS(std::string &error){
+	// Both would publish on /uavN: a daemon on its socket, the configured one or the --headless default
+	std::string control_socket;
+	ros::param::get("~control_socket", control_socket);
+	for (const auto &path : {control_socket, std::string("/tmp/outdoor_gcs.sock")}){
+		if (ControlServer::Listening(path)){
+			error = "A GCS is already running with the control socket " + path + ".";
+			return true;
+		}
+	}
+	// Any other GCS by its node name; one that crashed stays listed until rosnode cleanup
+	ros::V_string nodes;
+	if (ros::master::getNodes(nodes) && std::find(nodes.begin(), nodes.end(), ros::this_node::getName()) != nodes.end()){
+		error = "A GCS is already running as node " + ros::this_node::getName() + " (rosnode cleanup if it crashed).";
+		return true;
+	}
+	return false;
+}
+void QNode::Run_Control(){
+	if (!control.Opened()){ return; }
+	for (const auto &request : control.Take()){
+		control.Reply(request.client, Control_Command(request.client, request.line));
+	}
+	control_tick++;
+	if (control.Watchers() > 0){
+		control.Publish(Telemetry());
+	}
+}
+std::string QNode::Control_Command(int client, const std::string &line){
+	// One line in, "ok ..." or "error ..." out; runs in the ros thread, between two ticks
+	std::istringstream in(line);
+	std::string verb, arg;
+	in >> verb;
+	std::getline(in >> std::ws, arg);
+	GCS_LOG(Log_Info, "control: %s", line);
+	if (verb == "help"){
+		return "ok status | watch | unwatch | detect | uavs <1,2,...> | pos <uav> init|final <x> <y> <z> | "
+				"go init|final | schedule <as /uavs/schedule> | mission start|abort | preflight";
+	} else if (verb == "status"){
+		return "ok\n" + Telemetry();
+	} else if (verb == "watch" || verb == "unwatch"){
+		control.Watch(client, verb == "watch");
+		return "ok";
+	}
+	events.Append(-1, Event_Command, Event_General, "Control: " + line);
+	if (verb == "detect"){
+		std::string detected = Detect_UAVs();
+		Q_EMIT availUavsUpdate(QList<int>::fromStdList(avail_uavind));
+		return "ok " + detected;
+	} else if (verb == "uavs"){
+		std::list<int> uavs;
+		std::istringstream list(arg);
+		std::string id;
+		while (std::getline(list, id, ',')) {
+			int ind = std::atoi(id.c_str()) - 1;
+			if (ind < 0 || ind >= DroneNumber){ return "error bad uav '" + id + "'"; }
+			uavs.push_back(ind);
+		}
+		avail_uavind = uavs;
+		Q_EMIT availUavsUpdate(QList<int>::fromStdList(avail_uavind));
+		return "ok " + std::to_string(uavs.size()) + " uavs";
+	} else if (verb == "pos"){
+		int id;
+		std::string which;
+		float pos[3];
+		std::istringstream args(arg);
+		if (!(args >> id >> which >> pos[0] >> pos[1] >> pos[2]) || id < 1 || id > DroneNumber ||
+				(which != "init" && which != "final")){
+			return "error usage: pos <uav> init|final <x> <y> <z>";
+		}
+		Update_PathPlan_Pos(id-1, pos, which == "init");
+		return "ok";
+	} else if (verb == "go"){
+		if (arg != "init" && arg != "final"){ return "error usage: go init|final"; }
+		mission_step step;
+		step.op = Mission_Do;
+		step.name = "go";
+		step.args.push_back(arg);
+		return Mission_Act(step) ? "ok" : "error no available uavs";
+	} else if (verb == "schedule"){
+		std::string error;
+		return Schedule_Text(arg, error) ? "ok" : "error " + error;
+	} else if (verb == "mission" || verb == "preflight"){
+		std_srvs::Trigger::Request req;
+		std_srvs::Trigger::Response res;
+		if (verb == "preflight"){
+			preflight_callback(req, res);
+		} else if (arg == "start"){
+			mission_start_callback(req, res);
+		} else if (arg == "abort"){
+			mission_abort_callback(req, res);
+		} else{
+			return "error usage: mission start|abort";
+		}
+		return (res.success ? "ok " : "error ") + res.message;
+	}
+	return "error unknown command '" + verb + "', try help";
+}
+std::string QNode::Telemetry(){
+	std::ostringstream out;
+	out.setf(std::ios::fixed);
+	out.precision(2);
+	mission_status status = mission.Status(ros::WallTime::now().toSec());
+	readiness_report ready = GetReadiness();
+	out << "tick " << control_tick << " " << ros::WallTime::now().toSec() << "\n";
+	out << "plan " << plan_time.hosts << " uavs " << plan_time.time_us << " us\n";
+	out << "preflight " << (ready.go ? "GO " : "NO-GO ") << ready.ready << "/" << ready.rows.size() << "\n";
+	out << "mission " << (mission_active ? std::to_string(status.step+1) + "/" + std::to_string(status.steps) + " " +
+			status.text : "idle") << "\n";
+	out << "scheduled " << scheduler->Pending() << "\n";
+	for (const auto &ind : avail_uavind){
+		const uav_info &uav = UAVs_info[ind];
+		out << "uav" << ind+1 << " " << (uavs_state[ind].connected ? "connected " : "lost ") <<
+				(uavs_state[ind].armed ? "armed " : "disarmed ") << (uavs_state[ind].mode.empty() ? "-" : uavs_state[ind].mode) <<
+				" pos " << uav.pos_cur[0] << " " << uav.pos_cur[1] << " " << uav.pos_cur[2] <<
+				" vel " << uav.vel_cur[0] << " " << uav.vel_cur[1] << " " << uav.vel_cur[2] <<
+				" des " << uav.pos_des[0] << " " << uav.pos_des[1] << " " << uav.pos_des[2] <<
+				(Move[ind] ? (uav.arrive ? " arrived" : " moving") : " idle") << "\n";
+	}
+	for (const auto &ind : avail_uavind){
+		clock_estimate clock = clock_sync.Estimate(ind);
+		if (clock.source == Clock_None){ continue; }
+		out << "clock uav" << ind+1 << (clock.source == Clock_Exchange ? " exchange" : " passive") << " offset " <<
+				clock.offset*1e3 << " ms drift " << clock.drift*1e6 << " ppm\n";
+	}
+	for (const auto &ind : avail_uavind){
+		trace_stat trace = tracer.Stat(ind);
+		if (trace.sent == 0){ continue; }
+		const LatencyHistogram &latency = tracer.Latency(ind);
+		out << "trace uav" << ind+1 << " sent " << trace.sent << " executed " << trace.executed << " superseded " <<
+				trace.superseded << " dropped " << trace.dropped << " out_of_order " << trace.out_of_order << " unmatched " <<
+				trace.unmatched << " p50 " << latency.Percentile(0.5)*1e3 << " ms p99 " << latency.Percentile(0.99)*1e3 << " ms\n";
+	}
+	return out.str();
+}
+void QNode::Publish_Fleet_Shm(){
+	if (!fleet_shm.Opened()){ return; }
+	readiness_report ready = GetReadiness();
+	ros::WallTime wall = ros::WallTime::now();
+	fleet_frame &f = fleet_shm.Begin();
+	f.tick = shm_tick++;
+	f.stamp = ros::Time::now().toNSec();
+	f.count = 0;
+	for (const auto &ind : avail_uavind){
+		if (f.count == uint32_t(Fleet_Shm_Capacity)){ break; }
+		const uav_info &uav = UAVs_info[ind];
+		int k = f.count++;
+		f.id[k] = ind;
+		for (int i = 0; i < 3; i++) {
+			f.pos[i][k] = uav.pos_cur[i];
+			f.vel[i][k] = uav.vel_cur[i];
+			f.des[i][k] = uav.pos_des[i];
+			f.nxt[i][k] = uav.pos_nxt[i];
+		}
+		f.age[k] = rx_odom[ind].isZero() ? -1 : (wall - rx_odom[ind]).toSec();
+		std::strncpy(f.mode[k], uavs_state[ind].mode.c_str(), sizeof(f.mode[k]) - 1);
+		f.mode[k][sizeof(f.mode[k]) - 1] = 0;
+		uint32_t health = 0;
+		if (uavs_state[ind].connected){ health |= Health_Connected; }
+		if (uavs_state[ind].armed){ health |= Health_Armed; }
+		if (Move[ind]){ health |= Health_Moving; }
+		if (uav.arrive){ health |= Health_Arrived; }
+		if (f.age[k] >= 0 && (ready_criteria.max_age <= 0 || f.age[k] <= ready_criteria.max_age)){ health |= Health_Fresh; }
+		for (const auto &row : ready.rows){
+			if (row.id == ind && row.failed == 0){ health |= Health_Ready; }
+		}
+		for (const auto &alert : sep_alerts){
+			if (alert.a == ind || alert.b == ind){ health |= Health_Separation; }
+		}
+		f.health[k] = health;
+	}
+	fleet_shm.End();
+}
+void QNode::Setup_Metrics(){
+	// Every series up front, also with no endpoint: updates are relaxed atomics and cost the loop nothing
+	static const char *stages[Stage_Count] = {"command", "plan", "mission", "separation", "preflight", "shm",
+			"service", "publish", "spin", "control"};
+	static const char *streams[Rx_Count] = {"state", "imu", "gps", "global", "odom", "log"};
+	static const char *services[Srv_Count] = {"arming", "set_mode", "land", "takeoff", "set_home"};
+	static const char *outcomes[6] = {"sent", "executed", "superseded", "dropped", "out_of_order", "unmatched"};
+	m_loop_period = metrics.Histogram("gcs_loop_period_seconds", "", "Time between the starts of two ticks of the ros loop");
+	m_loop_jitter = metrics.Histogram("gcs_loop_jitter_seconds", "", "Deviation of the tick period from 1/freq");
+	for (int k = 0; k < Stage_Count; k++) {
+		m_stage[k] = metrics.Histogram("gcs_stage_seconds", std::string("stage=\"") + stages[k] + "\"", "Wall time of each stage of a tick");
+	}
+	metrics.Histogram("gcs_react_seconds", "", "Odometry stamp to the publish of the command planned on it", &react_latency);
+	metrics.Histogram("gcs_schedule_skew_seconds", "", "Lateness of the timed fleet commands", &scheduler->Skew());
+	for (int k = 0; k < Srv_Count; k++) {
+		std::string label = std::string("service=\"") + services[k] + "\"";
+		m_service[k] = metrics.Histogram("gcs_service_seconds", label, "Round trip of the mavros service calls");
+		m_service_failed[k] = metrics.Counter("gcs_service_failures_total", label, "Service calls that did not reach mavros");
+	}
+	m_command_bytes = metrics.Counter("gcs_command_bytes_total", "", "Serialized bytes of the commands published by the loop");
+	m_plan_hosts = metrics.Gauge("gcs_plan_hosts", "", "Uavs planned in the last tick");
+	m_scheduled = metrics.Gauge("gcs_queue_depth", "queue=\"schedule\"", "Entries waiting in the internal queues");
+	m_events_held = metrics.Gauge("gcs_queue_depth", "queue=\"events\"", "");
+	m_control_clients = metrics.Gauge("gcs_control_clients", "", "Clients of the control socket");
+	m_events_dropped = metrics.Counter("gcs_events_dropped_total", "", "Operator events evicted without being written");
+	m_binlog_dropped = metrics.Counter("gcs_binlog_dropped_total", "", "Binary log entries lost to full queues");
+	m_sep_alerts = metrics.Gauge("gcs_separation_alerts", "", "Pairs of uavs in separation alert");
+	m_sep_min_dist = metrics.Gauge("gcs_separation_min_distance_meters", "", "Closest pair within the threshold, -1 for none");
+	for (int i = 0; i < DroneNumber; i++) {
+		std::string uav = "uav=\"" + std::to_string(i+1) + "\"";
+		for (int k = 0; k < Rx_Count; k++) {
+			std::string label = uav + ",stream=\"" + streams[k] + "\"";
+			m_rx[i][k] = metrics.Counter("gcs_messages_total", label, "Telemetry messages received");
+			m_rx_age[i][k] = metrics.Gauge("gcs_message_age_seconds", label, "Time since the last message, -1 before the first");
+		}
+		for (int k = 0; k < 6; k++) {
+			m_trace[i][k] = metrics.Counter("gcs_commands_total", uav + ",outcome=\"" + outcomes[k] + "\"",
+					"Position commands by outcome of the echo trace");
+		}
+		metrics.Histogram("gcs_command_latency_seconds", uav, "Publish to echo of the position commands", &tracer.Latency(i));
+		m_clock_offset[i] = metrics.Gauge("gcs_clock_offset_seconds", uav, "GCS minus vehicle clock");
+		m_clock_drift[i] = metrics.Gauge("gcs_clock_drift", uav, "Drift of the clock offset [s/s]");
+		m_available[i] = metrics.Gauge("gcs_uav_available", uav, "In the uav list of the GCS");
+		m_connected[i] = metrics.Gauge("gcs_uav_connected", uav, "Mavros connected to the flight controller");
+		m_armed[i] = metrics.Gauge("gcs_uav_armed", uav, "Armed");
+		m_ready[i] = metrics.Gauge("gcs_uav_ready", uav, "Passing every pre-flight check");
+	}
+}
+void QNode::Update_Metrics(){
+	ros::WallTime wall = ros::WallTime::now();
+	readiness_report ready = GetReadiness();
+	for (int i = 0; i < DroneNumber; i++) {
+		for (int k = 0; k < Rx_Count; k++) {
+			m_rx_age[i][k]->Set(rx_last[i][k].isZero() ? -1 : (wall - rx_last[i][k]).toSec());
+		}
+		trace_stat trace = tracer.Stat(i);
+		uint64_t counts[6] = {trace.sent, trace.executed, trace.superseded, trace.dropped, trace.out_of_order, trace.unmatched};
+		for (int k = 0; k < 6; k++) {
+			m_trace[i][k]->Set(counts[k]);
+		}
+		clock_estimate clock = clock_sync.Estimate(i);
+		m_clock_offset[i]->Set(clock.offset);
+		m_clock_drift[i]->Set(clock.drift);
+		m_available[i]->Set(std::find(avail_uavind.begin(), avail_uavind.end(), i) != avail_uavind.end());
+		m_connected[i]->Set(uavs_state[i].connected);
+		m_armed[i]->Set(uavs_state[i].armed);
+		m_ready[i]->Set(0);
+	}
+	for (const auto &row : ready.rows){
+		m_ready[row.id]->Set(row.failed == 0);
+	}
+	m_plan_hosts->Set(plan_time.hosts);
+	m_scheduled->Set(scheduler->Pending());
+	m_events_held->Set(events.End() - events.First());
+	m_control_clients->Set(control.Clients());
+	m_events_dropped->Set(events.Dropped());
+	m_binlog_dropped->Set(BinLog::Dropped());
+	m_sep_alerts->Set(sep_alerts.size());
+	m_sep_min_dist->Set(sep_stat.min_dist);
+}
+void QNode::Count_Rx(int ind, Rx_Stream stream){
+	m_rx[ind][stream]->Add();
+	rx_last[ind][stream] = ros::WallTime::now();
+}
+ros::WallTime QNode::Stage_Done(Loop_Stage stage, const ros::WallTime &start){
+	ros::WallTime now = ros::WallTime::now();
+	m_stage[stage]->Add((now - start).toSec());
+	return now;
+}
+std::string QNode::Detect_UAVs(){
+	QStringList topics = lsAllTopics();
+	std::list<int> uavs;
+	std::string names;
+	for (int i = 0; i < DroneNumber; i++) {
+		// Same filter as the Update UAV List button
+		UAVs_info[i].rosReceived = !topics.filter(QString::fromStdString("uav" + std::to_string(i+1) + "/mavlink/from")).isEmpty();
+		if (UAVs_info[i].rosReceived){
+			uavs.push_back(i);
+			names += " uav" + std::to_string(i+1);
+		}
+	}
+	avail_uavind = uavs;
+	return std::to_string(uavs.size()) + " uavs detected" + names;
 }
 void QNode::Set_GPS_Home_uavs(int host_ind, int origin_ind){
 	uavs_gps_home[host_ind].geo.latitude  = uavs_gpsG[origin_ind].latitude;
@@ -506,27 +1395,59 @@ void QNode::Set_GPS_Home_uavs(int host_ind, int origin_ind){
 // }
 
 void QNode::Set_Square_Circle(int host_ind, float input[2]){
-	path_i = 0;
+	{
+		std::lock_guard<std::mutex> lock(sc_mutex[host_ind]);
+		path_i[host_ind] = 0;
+	}
 	sc_size = input[0]; // length of square or diameter of circle
 	sc_time = input[1]; // time to finish one cycle
 	centers[host_ind][0] = UAVs_info[host_ind].pos_des[0];
 	centers[host_ind][1] = UAVs_info[host_ind].pos_des[1];
 	centers[host_ind][2] = UAVs_info[host_ind].pos_des[2];
-	sq_corners[host_ind][0][0] = sc_size/2+centers[host_ind][0];
-	sq_corners[host_ind][0][1] = sc_size/2+centers[host_ind][1];
-	sq_corners[host_ind][1][0] = -sc_size/2+centers[host_ind][0];
-	sq_corners[host_ind][1][1] = sc_size/2+centers[host_ind][1];
-	sq_corners[host_ind][2][0] = -sc_size/2+centers[host_ind][0];
-	sq_corners[host_ind][2][1] = -sc_size/2+centers[host_ind][1];
-	sq_corners[host_ind][3][0] = sc_size/2+centers[host_ind][0];
-	sq_corners[host_ind][3][1] = -sc_size/2+centers[host_ind][1];
-	// Extra corner for coding simplicity (to close up the loop)
-	sq_corners[host_ind][4][0] = sc_size/2+centers[host_ind][0]; 
-	sq_corners[host_ind][4][1] = sc_size/2+centers[host_ind][1];
+}
+
+void QNode::Build_Path(int host_ind, int dim){
+	// Everything geometric is done here once, UAVS_Do_Plan only looks samples up
+	waypoint center = {{centers[host_ind][0], centers[host_ind][1], centers[host_ind][2]}};
+	float period = (sc_time > 0) ? sc_time : 36.0; // stepped paths only use the shape
+	TrajectoryTable traj;
+	std::vector<waypoint> waypoints;
+	if (dim == 10){ // square
+		float half = sc_size/2;
+		std::vector<waypoint> corners = {
+			{{center[0]+half, center[1]+half, center[2]}},
+			{{center[0]-half, center[1]+half, center[2]}},
+			{{center[0]-half, center[1]-half, center[2]}},
+			{{center[0]+half, center[1]-half, center[2]}}};
+		if (square_shape == "min_snap"){
+			traj = TrajectoryTable::MinSnap(corners, period, true);
+		} else if (square_shape == "min_jerk"){
+			traj = TrajectoryTable::MinJerk(corners, period, true);
+		} else{
+			traj = TrajectoryTable::Polyline(corners, period, true);
+		}
+		waypoints = corners;
+	} else{ // circle (set 36 points for stepping! 1 per 10 degree.)
+		if (circle_shape == "lemniscate"){
+			traj = TrajectoryTable::Lemniscate(center, sc_size, period);
+		} else{
+			traj = TrajectoryTable::Circle(center, sc_size/2, period);
+		}
+		for (int k = 0; k < 36; k++) {
+			outdoor_gcs::TrajectoryPoint ref;
+			traj.Evaluate(period*k/36, ref);
+			waypoints.push_back({{ref.position_ref[0], ref.position_ref[1], ref.position_ref[2]}});
+		}
+	}
+	// Built aside, swapped in under the lock: the ros thread may be reading the old table
+	std::lock_guard<std::mutex> lock(sc_mutex[host_ind]);
+	sc_traj[host_ind] = std::move(traj);
+	sc_waypoints[host_ind].swap(waypoints);
 }
 
 void QNode::move_uavs(int ID, float pos_input[3]) {
-	pub_move_flag[ID] = true;
+	if (!Fence_Command(ID, pos_input)){ return; }
+	pub_move_flag[ID] = stream_rate <= 0; // when streaming, stream_loop sends it instead
     Command_List[ID].header.stamp = ros::Time::now();
     Command_List[ID].Mode = Move_ENU;
 
@@ -542,162 +1463,433 @@ void QNode::move_uavs(int ID, float pos_input[3]) {
     Command_List[ID].Reference_State.acceleration_ref[2] = 0;
 
     Command_List[ID].Reference_State.yaw_ref = 0;
-    Command_List[ID].Command_ID = comid;
-    comid++;
+    Command_List[ID].Command_ID = comid++;
+	if (stream_rate > 0){
+		streamer.Update_Reference(ID, Command_List[ID].header.stamp, pos_input, UAVs_info[ID].vel_cur);
+	}
 	// ROS_INFO("Sent");
 }
 
+void QNode::move_uavs_traj(int ID, const outdoor_gcs::TrajectoryPoint &ref) {
+	float pos[3] = {ref.position_ref[0], ref.position_ref[1], ref.position_ref[2]};
+	if (!Fence_Command(ID, pos)){ return; }
+	pub_move_flag[ID] = true;
+	streamer.Reset(ID); // already a smooth, time-parameterized reference
+    Command_List[ID].header.stamp = ros::Time::now();
+    Command_List[ID].Mode = Trajectory_Tracking;
+	Command_List[ID].Reference_State = ref;
+	if (pos[0] != ref.position_ref[0] || pos[1] != ref.position_ref[1] || pos[2] != ref.position_ref[2]){
+		for (int i = 0; i < 3; i++) { // clamped: stop on the fence
+			Command_List[ID].Reference_State.position_ref[i] = pos[i];
+			Command_List[ID].Reference_State.velocity_ref[i] = 0;
+			Command_List[ID].Reference_State.acceleration_ref[i] = 0;
+		}
+	}
+	Command_List[ID].Reference_State.header.stamp = Command_List[ID].header.stamp;
+    Command_List[ID].Reference_State.yaw_ref = 0;
+    Command_List[ID].Command_ID = comid++;
+}
+
+
+bool QNode::Fence_Command(int ID, float pos[3]){
+	return Fence_Command(ID, UAVs_info[ID].pos_cur, pos);
+}
+
+bool QNode::Fence_Command(int ID, const float from[3], float pos[3]){
+	// Runs in the ros and the stream thread, and in the GUI thread for the single uav (ID -1, logged
+	// as uav0); the fence is read-only once loaded
+	if (!geofence.Loaded()){ return true; }
+	Fence_Result result = geofence.Check(from, pos, geofence_clamp);
+	if (result == Fence_Clamped){
+		if (ID >= 0){ fence_clamped[ID]++; }
+		GCS_LOG(Log_Warn, "geofence: uav%d clamped to (%.2f, %.2f, %.2f)", ID+1, pos[0], pos[1], pos[2]);
+		ROS_WARN_THROTTLE(1.0, "Geofence: command of uav%d clamped to (%.1f, %.1f, %.1f)", ID+1, pos[0], pos[1], pos[2]);
+	} else if (result == Fence_Rejected){
+		if (ID >= 0){ fence_rejected[ID]++; }
+		GCS_LOG(Log_Warn, "geofence: uav%d command to (%.2f, %.2f, %.2f) rejected", ID+1, pos[0], pos[1], pos[2]);
+		ROS_WARN_THROTTLE(1.0, "Geofence: command of uav%d rejected", ID+1);
+		return false;
+	}
+	return true;
+}
+
+bool QNode::Fence_Setpoint(float pos[3]){
+	float from[3] = {float(uav_gpsL.pose.pose.position.x), float(uav_gpsL.pose.pose.position.y), float(uav_gpsL.pose.pose.position.z)};
+	return Fence_Command(-1, from, pos);
+}
+
+void QNode::Build_Snapshot(const ros::Time &t){
+	ros::WallTime start = ros::WallTime::now();
+	std::lock_guard<std::mutex> lock(snap_mutex);
+	snap.resize(DroneNumber);
+	snap.stamp = t;
+	snap.max_skew = 0;
+	stamped_state latest;
+	for (const auto &ind : avail_uavind){
+		snap.valid[ind] = history[ind].Latest(latest);
+		if (!snap.valid[ind]){ // no stamped odometry yet
+			snap.skew[ind] = 0;
+			for (int i = 0; i < 3; i++) {
+				snap.pos[ind][i] = UAVs_info[ind].pos_cur[i];
+				snap.vel[ind][i] = UAVs_info[ind].vel_cur[i];
+			}
+			continue;
+		}
+		snap.skew[ind] = (t - latest.stamp).toSec();
+		snap.max_skew = std::max(snap.max_skew, std::fabs(snap.skew[ind]));
+		// Interpolate inside the history, extrapolate past its newest sample
+		if (t > latest.stamp && predict_state && predictor[ind].Predict(t, snap.pos[ind].data(), snap.vel[ind].data())){
+			continue;
+		}
+		history[ind].Sample(t, snap.pos[ind].data(), snap.vel[ind].data());
+	}
+	snap.build_us = (ros::WallTime::now() - start).toSec()*1e6;
+}
+
+ros::Time QNode::Snapshot_Time(){
+	// Planners work on the fleet at the time the command gets executed, or without prediction at
+	// the newest time every uav with fresh odometry has it for; a stalled uav would drag the others back
+	ros::Time now = ros::Time::now();
+	if (predict_state){
+		return now + ros::Duration(cmd_latency);
+	}
+	ros::Time common, newest;
+	stamped_state latest;
+	for (const auto &ind : avail_uavind){
+		if (!history[ind].Latest(latest)){ continue; }
+		if (latest.stamp > newest){ newest = latest.stamp; }
+		if ((now - latest.stamp).toSec() > snapshot_stale){ continue; }
+		if (common.isZero() || latest.stamp < common){ common = latest.stamp; }
+	}
+	if (!common.isZero()){ return common; }
+	return newest.isZero() ? now : newest; // every uav stale
+}
 
 void QNode::UAVS_Do_Plan(){
+	Build_Snapshot(Snapshot_Time());
+	ros::Time now = ros::Time::now();
+	std::vector<int> hosts;
 	for (const auto &host_ind : avail_uavind){
+		// With event planning the tick only covers uavs that no odometry replanned within a period
+		if (event_planning && (now - last_plan[host_ind]).toSec() < 1.0/freq){ continue; }
+		hosts.push_back(host_ind);
+	}
+	Step_Global_Paths();
+	ros::WallTime start = ros::WallTime::now();
+	Plan_Hosts(hosts);
+	plan_time.hosts = hosts.size();
+	plan_time.threads = plan_pool ? plan_pool->Size() : 1;
+	plan_time.time_us = (ros::WallTime::now() - start).toSec()*1e6;
+	GCS_LOG(Log_Debug, "plan tick: %d uavs on %d threads, %.0f us", plan_time.hosts, plan_time.threads, plan_time.time_us);
+	for (const auto &host_ind : hosts){
+		Apply_Plan(host_ind);
+	}
+}
 
-		float dist[3];
-		dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
-		dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
-		dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
-		if (sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
-			UAVs_info[host_ind].arrive = true;
-		} else{ UAVs_info[host_ind].arrive = false; }
+void QNode::Plan_Event(int ind){
+	// Fresh odometry of ind: replan it and its neighbours and send the commands right away
+	ros::Time now = ros::Time::now();
+	std::vector<int> hosts;
+	for (const auto &host_ind : avail_uavind){
+		if (!Move[host_ind]){ continue; }
+		if (host_ind != ind){
+			float dist_v[3] = {	UAVs_info[host_ind].pos_cur[0]-UAVs_info[ind].pos_cur[0],
+								UAVs_info[host_ind].pos_cur[1]-UAVs_info[ind].pos_cur[1],
+								UAVs_info[host_ind].pos_cur[2]-UAVs_info[ind].pos_cur[2]};
+			if (std::sqrt(dist_v[0]*dist_v[0] + dist_v[1]*dist_v[1] + dist_v[2]*dist_v[2]) > flock_param[3]){ continue; }
+		}
+		if ((now - last_plan[host_ind]).toSec() < 1.0/event_rate){ continue; } // rate limit per uav
+		hosts.push_back(host_ind);
+	}
+	if (hosts.empty()){ return; }
+	GCS_LOG(Log_Debug, "plan event: odometry of uav%d, %d uavs", ind+1, int(hosts.size()));
+	Build_Snapshot(Snapshot_Time());
+	Plan_Hosts(hosts);
+	// Only the commands just planned: the rest of the fleet goes out on its own events or the tick
+	pub_stat stat;
+	outdoor_gcs::FleetCommand fleet;
+	for (const auto &host_ind : hosts){
+		Apply_Plan(host_ind);
+		if (pub_move_flag[host_ind]){ Pub_Move(host_ind, fleet, stat); }
+	}
+	Pub_Fleet(fleet, stat);
+	m_command_bytes->Add(stat.bytes);
+}
 
+void QNode::For_Hosts(const std::vector<int> &hosts, const std::function<void(int)> &f){
+	if (plan_pool){
+		plan_pool->Parallel_For(hosts.size(), [&hosts, &f](int k){ f(hosts[k]); });
+	} else{
+		for (const auto &host_ind : hosts){
+			f(host_ind);
+		}
+	}
+}
+
+template <class Planner>
+void QNode::Run_Planner(Planner planner, const std::vector<int> &hosts, bool keep_height){
+	planner.Set_Obstacles(obstacle_field.Built() ? &obstacle_field : nullptr, obstacle_gain, obstacle_range);
+	For_Hosts(hosts, [this, &planner, keep_height](int host_ind){
+		float *pos_nxt = UAVs_info[host_ind].pos_nxt;
+		planner.Plan(snap, fleet, host_ind, UAVs_info[host_ind].pos_des, pos_nxt);
+		if (keep_height){
+			pos_nxt[2] = UAVs_info[host_ind].pos_des[2];
+		}
+		Set_Plan_Output(host_ind, pos_nxt);
+	});
+}
+
+void QNode::Plan_Hosts(const std::vector<int> &hosts){
+	// Hosts only read the snapshot and write their own slots; Apply_Plan then sends the outputs
+	// in host order, so command ids do not depend on the thread count.
+	// The planner of every host is picked here once for the whole tick.
+	fleet.assign(avail_uavind.begin(), avail_uavind.end());
+	std::vector<int> groups[12], plugin_hosts, others;
+	for (const auto &host_ind : hosts){
+		Plan_Begin(host_ind);
 		if (!Move[host_ind]){ continue; }
-		else{
-			if (Plan_Dim[host_ind] == 0){
-				move_uavs(host_ind, UAVs_info[host_ind].pos_des);
-			}
-			else if (Plan_Dim[host_ind] == 2){ // 2D Flock
-				float force[2];
-				force[0] = -flock_param[0]*(UAVs_info[host_ind].vel_cur[0])-flock_param[1]*(UAVs_info[host_ind].pos_cur[0]-UAVs_info[host_ind].pos_des[0]);
-				force[1] = -flock_param[0]*(UAVs_info[host_ind].vel_cur[1])-flock_param[1]*(UAVs_info[host_ind].pos_cur[1]-UAVs_info[host_ind].pos_des[1]);
-				for (const auto &other_ind : avail_uavind){
-					float dist_v[2] = {	UAVs_info[host_ind].pos_cur[0]-UAVs_info[other_ind].pos_cur[0],
-										UAVs_info[host_ind].pos_cur[1]-UAVs_info[other_ind].pos_cur[1]};
-					float dist = std::pow(std::pow(dist_v[0],2) + std::pow(dist_v[1], 2), 0.5);
-					if (host_ind != other_ind && dist < flock_param[3]){
-						float ForceComponent = flock_param[2]*std::pow(dist - flock_param[3], 2);
-						force[0] += ForceComponent*(dist_v[0]/dist);
-						force[1] += ForceComponent*(dist_v[1]/dist);
-					}
-				}
-				for (int i = 0; i < 2; i++) {
-					force[i] = std::min(std::max(force[i], -flock_param[4]), flock_param[4]);
-					float vel = std::min(std::max(UAVs_info[host_ind].vel_cur[i] + force[i]*dt, -flock_param[5]), flock_param[5]);
-					UAVs_info[host_ind].pos_nxt[i] = UAVs_info[host_ind].pos_cur[i] + vel*dt;
-					// std::cout << pos_input[i] << std::endl;
-					// std::cout << UAVs_info[host_ind].pos_des[i] << std::endl;
-				}
-				UAVs_info[host_ind].pos_nxt[2] = UAVs_info[host_ind].pos_des[2];
-				move_uavs(host_ind, UAVs_info[host_ind].pos_nxt);
-			}
-			else if (Plan_Dim[host_ind] == 3){ // 3D Flock
-				float force[3];
-				force[0] = -flock_param[0]*(UAVs_info[host_ind].vel_cur[0])-flock_param[1]*(UAVs_info[host_ind].pos_cur[0]-UAVs_info[host_ind].pos_des[0]);
-				force[1] = -flock_param[0]*(UAVs_info[host_ind].vel_cur[1])-flock_param[1]*(UAVs_info[host_ind].pos_cur[1]-UAVs_info[host_ind].pos_des[1]);
-				force[2] = -flock_param[0]*(UAVs_info[host_ind].vel_cur[2])-flock_param[1]*(UAVs_info[host_ind].pos_cur[2]-UAVs_info[host_ind].pos_des[2]);
-				for (const auto &other_ind : avail_uavind){
-					float dist_v[3] = {	UAVs_info[host_ind].pos_cur[0]-UAVs_info[other_ind].pos_cur[0],
-										UAVs_info[host_ind].pos_cur[1]-UAVs_info[other_ind].pos_cur[1],
-										UAVs_info[host_ind].pos_cur[2]-UAVs_info[other_ind].pos_cur[2]};
-					float dist = std::pow(std::pow(dist_v[0],2) + std::pow(dist_v[1], 2) + std::pow(dist_v[2], 2), 0.5);
-					if (host_ind != other_ind && dist < flock_param[3]){
-						float ForceComponent = flock_param[2]*std::pow(dist - flock_param[3], 2);
-						force[0] += ForceComponent*(dist_v[0]/dist);
-						force[1] += ForceComponent*(dist_v[1]/dist);
-						force[2] += ForceComponent*(dist_v[2]/dist);
-					}
-				}
-				for (int i = 0; i < 3; i++) {
-					force[i] = std::min(std::max(force[i], -flock_param[4]), flock_param[4]);
-					float vel = std::min(std::max(UAVs_info[host_ind].vel_cur[i] + force[i]*dt, -flock_param[5]), flock_param[5]);
-					UAVs_info[host_ind].pos_nxt[i] = UAVs_info[host_ind].pos_cur[i] + vel*dt;
-					// std::cout << pos_input[i] << std::endl;
-					// std::cout << UAVs_info[host_ind].pos_des[i] << std::endl;
-				}
-				move_uavs(host_ind, UAVs_info[host_ind].pos_nxt);
-			}
-			else if (pathplan){ //2D & 3D ORCA & DW Flock
-				if (UAVs_info[host_ind].pos_nxt[0]!=0 && UAVs_info[host_ind].pos_nxt[1]!=0 && UAVs_info[host_ind].pos_nxt[2]!=0){
-					move_uavs(host_ind, UAVs_info[host_ind].pos_nxt);
-				}
+		int dim = Plan_Dim[host_ind];
+		bool local = (dim == 2 || dim == 3) || (local_pathplan && dim >= 4 && dim <= 7);
+		if (local){
+			groups[dim].push_back(host_ind);
+		} else if (dim == 20){
+			plugin_hosts.push_back(host_ind);
+		} else{
+			others.push_back(host_ind);
+		}
+	}
+	Run_Planner(FlockPlanner<2>(flock_param, dt), groups[2], true);
+	Run_Planner(FlockPlanner<3>(flock_param, dt), groups[3], false);
+	Run_Planner(OrcaPlanner<2>(orca_param, dt), groups[4], true);
+	Run_Planner(OrcaPlanner<3>(orca_param, dt), groups[5], false);
+	Run_Planner(FlockPlanner<2>(flock_param, dt), groups[6], true); // 2D DW flock: no vertical axis to keep apart
+	Run_Planner(DownwashFlockPlanner<3>(flock_param, dt, downwash_scale), groups[7], false);
+	Run_Plugin(plugin_hosts);
+	For_Hosts(others, [this](int host_ind){ Plan_Host(host_ind); });
+}
+
+bool QNode::Load_Planner(const std::string &path){
+	// The new build is loaded beside the old one, which keeps planning if it fails
+	std::string error;
+	std::unique_ptr<PlannerLibrary> lib = PlannerLibrary::Load(path, error);
+	if (!lib){
+		ROS_ERROR("Planner plugin not loaded, %s", error.c_str());
+		return false;
+	}
+	size_t k = 0;
+	while (k < planner_libs.size() && planner_libs[k]->Name() != lib->Name()) { k++; }
+	if (k == planner_libs.size()){ // or a build of the same path that renamed its planner
+		k = 0;
+		while (k < planner_libs.size() && planner_libs[k]->Path() != path) { k++; }
+	}
+	if (k < planner_libs.size()){
+		ROS_INFO("Planner plugin %s reloaded from %s, replacing %s", lib->Name().c_str(), path.c_str(),
+				planner_libs[k]->Name().c_str());
+	} else{
+		ROS_INFO("Planner plugin %s loaded from %s", lib->Name().c_str(), path.c_str());
+		planner_libs.emplace_back();
+	}
+	Configure_Planner(*lib);
+	planner_libs[k] = std::move(lib); // the old image is closed here, the active index stays
+	Update_Plugin_Stats();
+	return true;
+}
+
+void QNode::Select_Planner(const std::string &name){
+	if (name.empty() || name == "none"){
+		active_planner = -1;
+		Update_Plugin_Stats();
+		for (const auto &it : avail_uavind){
+			if (Plan_Dim[it] == 20){ Plan_Dim[it] = 0; }
+		}
+		return;
+	}
+	std::string planner = name;
+	if (name.size() > 3 && name.compare(name.size()-3, 3, ".so") == 0){ // a path: load it first
+		if (!Load_Planner(name)){ return; }
+		for (const auto &lib : planner_libs){
+			if (lib->Path() == name){ planner = lib->Name(); }
+		}
+	}
+	for (size_t k = 0; k < planner_libs.size(); k++) {
+		if (planner_libs[k]->Name() == planner){
+			active_planner = k;
+			Update_Plugin_Stats();
+			Update_Planning_Dim(99, 20);
+			return;
+		}
+	}
+	ROS_WARN("Planner plugin %s is not loaded", planner.c_str());
+}
+
+void QNode::Configure_Planner(PlannerLibrary &lib){
+	std::map<std::string, float> params = planner_params;
+	const char *flock_names[6] = {"flock_c1", "flock_c2", "flock_rho", "flock_r_alpha", "flock_max_acc", "flock_max_vel"};
+	const char *orca_names[4] = {"orca_tau", "orca_pref_v", "orca_r", "orca_neighbor_dist"};
+	for (int i = 0; i < 6; i++) { params[flock_names[i]] = flock_param[i]; }
+	for (int i = 0; i < 4; i++) { params[orca_names[i]] = orca_param[i]; }
+	params["downwash_scale"] = downwash_scale;
+	lib.Configure(params);
+}
+
+void QNode::Run_Plugin(const std::vector<int> &hosts){
+	if (hosts.empty() || active_planner < 0){ return; }
+	PlannerLibrary &lib = *planner_libs[active_planner];
+	if (planner_config.exchange(false)){
+		for (auto &l : planner_libs){ Configure_Planner(*l); }
+	}
+	std::vector<float> pos(3*DroneNumber, 0), vel(3*DroneNumber, 0), goal(3*DroneNumber, 0);
+	for (const auto &ind : fleet){
+		for (int i = 0; i < 3; i++) {
+			pos[3*ind+i] = snap.pos[ind][i];
+			vel[3*ind+i] = snap.vel[ind][i];
+			goal[3*ind+i] = UAVs_info[ind].pos_des[i];
+		}
+	}
+	planner_input in;
+	in.stamp = snap.stamp.toSec();
+	in.dt = dt;
+	in.budget = 1.0/freq;
+	in.size = DroneNumber;
+	in.fleet = fleet.data();
+	in.num_fleet = fleet.size();
+	in.hosts = hosts.data();
+	in.num_hosts = hosts.size();
+	in.pos = reinterpret_cast<const float (*)[3]>(pos.data());
+	in.vel = reinterpret_cast<const float (*)[3]>(vel.data());
+	in.goal = reinterpret_cast<const float (*)[3]>(goal.data());
+	std::vector<planner_command> out(hosts.size());
+	lib.Plan(in, out.data());
+	if (plugin_stats_wanted.exchange(false)){
+		Update_Plugin_Stats();
+	}
+
+	for (size_t k = 0; k < hosts.size(); k++) {
+		int host_ind = hosts[k];
+		if (out[k].type == 1){
+			for (int i = 0; i < 3; i++) { UAVs_info[host_ind].pos_nxt[i] = out[k].pos[i]; }
+			Set_Plan_Output(host_ind, UAVs_info[host_ind].pos_nxt);
+		} else if (out[k].type == 2){
+			outdoor_gcs::TrajectoryPoint ref;
+			ref.time_from_start = 0;
+			ref.Sub_mode = 0;
+			for (int i = 0; i < 3; i++) {
+				ref.position_ref[i] = out[k].pos[i];
+				ref.velocity_ref[i] = out[k].vel[i];
+				ref.acceleration_ref[i] = out[k].acc[i];
+				UAVs_info[host_ind].pos_nxt[i] = out[k].pos[i];
 			}
-			else if (Plan_Dim[host_ind] == 10){ //Square path
-				if (sc_time == 0){
-					// Setting based on the location
-					if (path_i >= 4){ path_i = 0; }
-					UAVs_info[host_ind].pos_des[0] = sq_corners[host_ind][path_i][0];
-					UAVs_info[host_ind].pos_des[1] = sq_corners[host_ind][path_i][1];
-					UAVs_info[host_ind].pos_des[2] = centers[host_ind][2];
-					move_uavs(host_ind, UAVs_info[host_ind].pos_des);
-
-					float dist[3];
-					dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
-					dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
-					dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
-					if (sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
-					// if (ros::Time::now() - last_change >= ros::Duration(sc_time/4)){
-						path_i += 1;
-						// last_change = ros::Time::now();
-					}
-				} else{
-					// Setting based on given time
-					if (path_i >= sc_time*freq){ path_i = 0; }
-					int turn = std::floor(path_i/(sc_time*freq/4.0)); // (sc_time*freq)/4 amount of i for one side
-					UAVs_info[host_ind].pos_des[0] = sq_corners[host_ind][turn][0]+(sq_corners[host_ind][turn+1][0] - sq_corners[host_ind][turn][0])*(path_i%int(sc_time*freq/4.0))/(sc_time*freq/4.0);
-					UAVs_info[host_ind].pos_des[1] = sq_corners[host_ind][turn][1]+(sq_corners[host_ind][turn+1][1] - sq_corners[host_ind][turn][1])*(path_i%int(sc_time*freq/4.0))/(sc_time*freq/4.0);
-					UAVs_info[host_ind].pos_des[2] = centers[host_ind][2];
-					move_uavs(host_ind, UAVs_info[host_ind].pos_des);
-
-					float dist[3];
-					dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
-					dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
-					dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
-					if (!start_path && sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
-						start_path = true;
-					}
-					if (start_path){
-						path_i += 1;
-					}
-				}
+			Set_Plan_Output(host_ind, ref);
+		}
+	}
+}
+
+void QNode::Update_Plugin_Stats(){
+	std::vector<outdoor_gcs::plugin_stat> stats;
+	for (const auto &lib : planner_libs){
+		stats.push_back(lib->GetStat());
+	}
+	std::lock_guard<std::mutex> lock(plugin_mutex);
+	plugin_stats.swap(stats);
+	plugin_active = active_planner;
+}
+
+void QNode::planner_select_callback(const std_msgs::String::ConstPtr &msg){
+	Select_Planner(msg->data);
+}
+
+void QNode::Plan_Begin(int host_ind){
+	stamped_state latest;
+	last_plan[host_ind] = ros::Time::now();
+	plan_odom[host_ind] = history[host_ind].Latest(latest) ? latest.stamp : ros::Time();
+	plan_output[host_ind].type = 0;
+
+	float dist[3];
+	dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
+	dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
+	dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
+	if (sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
+		UAVs_info[host_ind].arrive = true;
+	} else{ UAVs_info[host_ind].arrive = false; }
+	if (global_active[host_ind]){ UAVs_info[host_ind].arrive = false; } // at a cell of its global path
+}
+
+void QNode::Plan_Host(int host_ind){
+	// Planners without a template: direct moves, the external path planner and timed paths
+	if (Plan_Dim[host_ind] == 0){
+		Set_Plan_Output(host_ind, UAVs_info[host_ind].pos_des);
+	}
+	else if (pathplan){ //2D & 3D ORCA & DW Flock
+		if (UAVs_info[host_ind].pos_nxt[0]!=0 && UAVs_info[host_ind].pos_nxt[1]!=0 && UAVs_info[host_ind].pos_nxt[2]!=0){
+			Set_Plan_Output(host_ind, UAVs_info[host_ind].pos_nxt);
+		}
+	}
+	else if (Plan_Dim[host_ind] == 10 || Plan_Dim[host_ind] == 11){ // Square & circle path
+		std::lock_guard<std::mutex> lock(sc_mutex[host_ind]);
+		if (sc_time == 0){
+			// Setting based on the location
+			if (sc_waypoints[host_ind].empty()){ return; }
+			if (path_i[host_ind] >= int(sc_waypoints[host_ind].size())){ path_i[host_ind] = 0; }
+			const waypoint &wp = sc_waypoints[host_ind][path_i[host_ind]];
+			UAVs_info[host_ind].pos_des[0] = wp[0];
+			UAVs_info[host_ind].pos_des[1] = wp[1];
+			UAVs_info[host_ind].pos_des[2] = wp[2];
+			Set_Plan_Output(host_ind, UAVs_info[host_ind].pos_des);
+
+			float dist[3];
+			dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
+			dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
+			dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
+			if (sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
+				path_i[host_ind] += 1;
 			}
-			else if (Plan_Dim[host_ind] == 11){ // circle path
-				if (sc_time == 0){
-					// Setting based on the location (set 36 points! 1 per 10 degree.)
-					if (path_i >= 36){ path_i = 0; }
-					float theta = 2*M_PI*10*path_i/360;
-					UAVs_info[host_ind].pos_des[0] = (sc_size/2)*cos(theta)+centers[host_ind][0];
-					UAVs_info[host_ind].pos_des[1] = (sc_size/2)*sin(theta)+centers[host_ind][0];
-					UAVs_info[host_ind].pos_des[2] = centers[host_ind][2];
-					move_uavs(host_ind, UAVs_info[host_ind].pos_des);
-
-					float dist[3];
-					dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
-					dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
-					dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
-					if (sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
-						path_i += 1;
-					}
-				} else{
-					// Setting based on given time
-					if (path_i >= sc_time*freq){ path_i = 0; }
-					float theta = 2*M_PI*path_i/(sc_time*freq);
-					UAVs_info[host_ind].pos_des[0] = (sc_size/2)*cos(theta)+centers[host_ind][0];
-					UAVs_info[host_ind].pos_des[1] = (sc_size/2)*sin(theta)+centers[host_ind][0];
-					UAVs_info[host_ind].pos_des[2] = centers[host_ind][2];
-					move_uavs(host_ind, UAVs_info[host_ind].pos_des);
-
-					float dist[3];
-					dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
-					dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
-					dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
-					if (!start_path && sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
-						start_path = true;
-					}
-					if (start_path){
-						path_i += 1;
-					}
-				}
+		} else if (!start_path[host_ind]){
+			// Go to the start of the path first, the clock starts on arrival
+			if (sc_traj[host_ind].Empty()){ return; } // not built yet: hold the last setpoint
+			waypoint start = sc_traj[host_ind].Start();
+			UAVs_info[host_ind].pos_des[0] = start[0];
+			UAVs_info[host_ind].pos_des[1] = start[1];
+			UAVs_info[host_ind].pos_des[2] = start[2];
+			Set_Plan_Output(host_ind, UAVs_info[host_ind].pos_des);
+
+			float dist[3];
+			dist[0] = UAVs_info[host_ind].pos_des[0] - UAVs_info[host_ind].pos_cur[0];
+			dist[1] = UAVs_info[host_ind].pos_des[1] - UAVs_info[host_ind].pos_cur[1];
+			dist[2] = UAVs_info[host_ind].pos_des[2] - UAVs_info[host_ind].pos_cur[2];
+			if (sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2))<0.25){
+				start_path[host_ind] = true;
+				path_start[host_ind] = ros::Time::now();
 			}
+		} else{
+			// Setting based on given time, speed no longer depends on freq
+			outdoor_gcs::TrajectoryPoint ref;
+			if (!sc_traj[host_ind].Evaluate((ros::Time::now() - path_start[host_ind]).toSec(), ref)){ return; }
+			UAVs_info[host_ind].pos_des[0] = ref.position_ref[0];
+			UAVs_info[host_ind].pos_des[1] = ref.position_ref[1];
+			UAVs_info[host_ind].pos_des[2] = ref.position_ref[2];
+			Set_Plan_Output(host_ind, ref);
 		}
-	}	
+	}
+}
+
+void QNode::Set_Plan_Output(int host_ind, const float pos[3]){
+	plan_output[host_ind].type = 1;
+	for (int i = 0; i < 3; i++) {
+		plan_output[host_ind].pos[i] = pos[i];
+	}
+}
+
+void QNode::Set_Plan_Output(int host_ind, const outdoor_gcs::TrajectoryPoint &ref){
+	plan_output[host_ind].type = 2;
+	plan_output[host_ind].ref = ref;
+}
+
+void QNode::Apply_Plan(int host_ind){
+	if (plan_output[host_ind].type == 1){
+		move_uavs(host_ind, plan_output[host_ind].pos);
+	} else if (plan_output[host_ind].type == 2){
+		move_uavs_traj(host_ind, plan_output[host_ind].ref);
+	}
 }
 
 void QNode::Update_UAV_info(outdoor_gcs::uav_info UAV_input, int ind){
@@ -712,18 +1904,41 @@ void QNode::Update_RTCM(bool sent){
 void QNode::Update_Move(int i, bool move){
 	Move[i] = move;
 	UAVs_info[i].move = move;
+	if (!move){
+		streamer.Reset(i);
+	}
+}
+void QNode::Apply_Moves(){
+	std::vector<std::pair<int, bool> > moves;
+	{
+		std::lock_guard<std::mutex> lock(move_mutex);
+		moves.swap(move_queue);
+	}
+	for (const auto &m : moves){
+		Update_Move(m.first, m.second);
+	}
 }
 void QNode::Update_Planning_Dim(int host_ind, int i){
-	// 0 for no planning, 2/3 for 2D/3D flock, 4/5 for 2D/3D ORCA, 6/7 for 2D/3D DW Flock, 10 for square, 11 for circle
+	// 0 for no planning, 2/3 for 2D/3D flock, 4/5 for 2D/3D ORCA, 6/7 for 2D/3D DW Flock, 10 for square, 11 for circle,
+	// 20 for the active planner plugin
 	if (host_ind==99){
     	for (const auto &it : avail_uavind){
 			Plan_Dim[it] = i;
 		}
 	} else{ Plan_Dim[host_ind] = i;}
 	
-	start_path = false;
-	// start_path = true;
-	if (i==4 || i==5 || i==6 || i==7){
+	for (int it = 0; it < DroneNumber; it++) {
+		if (host_ind != 99 && it != host_ind){ continue; }
+		{
+			std::lock_guard<std::mutex> lock(sc_mutex[it]);
+			start_path[it] = false;
+			path_i[it] = 0;
+		}
+		if (i == 10 || i == 11){
+			Build_Path(it, i);
+		}
+	}
+	if ((i==4 || i==5 || i==6 || i==7) && !local_pathplan){
 		pathplan = true;
 		uavs_pathplan.start = true;
 	} else{
@@ -734,18 +1949,18 @@ void QNode::Update_PathPlan(){
 	uavs_pathplan.header.stamp = ros::Time::now();
 	for (const auto &it : avail_uavind){
 		uavs_pathplan.uavs_id[it] = true;
-		uavs_pathplan.cur_position[3*it+0] = UAVs_info[it].pos_cur[0];
-		uavs_pathplan.cur_position[3*it+1] = UAVs_info[it].pos_cur[1];
-		uavs_pathplan.cur_position[3*it+2] = UAVs_info[it].pos_cur[2];
+		uavs_pathplan.cur_position[3*it+0] = snap.pos[it][0];
+		uavs_pathplan.cur_position[3*it+1] = snap.pos[it][1];
+		uavs_pathplan.cur_position[3*it+2] = snap.pos[it][2];
 		uavs_pathplan.des_position[3*it+0] = UAVs_info[it].pos_des[0];
 		uavs_pathplan.des_position[3*it+1] = UAVs_info[it].pos_des[1];
 		uavs_pathplan.des_position[3*it+2] = UAVs_info[it].pos_des[2];
 		uavs_pathplan.nxt_position[3*it+0] = UAVs_info[it].pos_nxt[0];
 		uavs_pathplan.nxt_position[3*it+1] = UAVs_info[it].pos_nxt[1];
 		uavs_pathplan.nxt_position[3*it+2] = UAVs_info[it].pos_nxt[2];
-		uavs_pathplan.cur_velocity[3*it+0] = UAVs_info[it].vel_cur[0];
-		uavs_pathplan.cur_velocity[3*it+1] = UAVs_info[it].vel_cur[1];
-		uavs_pathplan.cur_velocity[3*it+2] = UAVs_info[it].vel_cur[2];
+		uavs_pathplan.cur_velocity[3*it+0] = snap.vel[it][0];
+		uavs_pathplan.cur_velocity[3*it+1] = snap.vel[it][1];
+		uavs_pathplan.cur_velocity[3*it+2] = snap.vel[it][2];
 		if (Plan_Dim[it] == 4){ // 2D ORCA, assume uavs at same height of 3.0
 			uavs_pathplan.cur_position[3*it+2] = 3.0;
 		}
@@ -768,6 +1983,7 @@ void QNode::Update_Flock_Param(float param[6]){
 			flock_param[i] = param[i];
 		}
 	}
+	planner_config = true;
 }
 void QNode::Update_ORCA_Param(float param[4]){
 	for (int i = 0; i < 4; i++) {
@@ -776,6 +1992,7 @@ void QNode::Update_ORCA_Param(float param[4]){
 			orca_param[i] = param[i];
 		}
 	}
+	planner_config = true;
 }
 void QNode::Update_PathPlan_Pos(int i, float pos_input[3], bool init_fin){ //True for init, false for final pos
 	if (init_fin){
@@ -799,6 +2016,216 @@ void QNode::Update_PathPlan_Des(int i, bool init_fin){ //True for init, false fo
 		UAVs_info[i].pos_des[2] = UAVs_info[i].pos_fin[2];
 	}
 }
+outdoor_gcs::assign_stat QNode::Assign_Goals(bool init_fin){
+	// Init / final positions are a formation of interchangeable uavs: every uav takes the goal
+	// that minimizes the total (sum) or the longest (max) travel of the fleet. Uavs that never
+	// sent odometry have no position to measure from and keep their own goal
+	std::lock_guard<std::mutex> lock(global_mutex);
+	goals_gen++;
+	global_step = -1;
+	for (int i = 0; i < DroneNumber; i++) {
+		global_path[i].clear();
+		global_active[i] = false;
+	}
+	outdoor_gcs::assign_stat stat;
+	stat.mode = goal_assignment;
+	std::vector<int> uavs;
+	for (const auto &it : avail_uavind){
+		if (!rx_odom[it].isZero()){
+			uavs.push_back(it);
+		} else{
+			Update_PathPlan_Des(it, init_fin);
+			stat.unknown++;
+		}
+	}
+	int n = uavs.size();
+	stat.num = n;
+	std::vector<std::array<float,3> > goals(n);
+	for (int k = 0; k < n; k++) {
+		const float *g = init_fin ? UAVs_info[uavs[k]].pos_ini : UAVs_info[uavs[k]].pos_fin;
+		goals[k] = {{g[0], g[1], g[2]}};
+	}
+	std::vector<double> cost(n*n);
+	for (int r = 0; r < n; r++) {
+		const float *p = UAVs_info[uavs[r]].pos_cur;
+		for (int c = 0; c < n; c++) {
+			cost[r*n+c] = std::sqrt(std::pow(goals[c][0]-p[0], 2) + std::pow(goals[c][1]-p[1], 2) + std::pow(goals[c][2]-p[2], 2));
+		}
+		stat.fixed_sum += cost[r*n+r];
+		stat.fixed_max = std::max(stat.fixed_max, float(cost[r*n+r]));
+	}
+
+	ros::WallTime start = ros::WallTime::now();
+	std::vector<int> assign(n);
+	if (goal_assignment == "sum"){
+		assign = Assign_Min_Sum(cost, n);
+	} else if (goal_assignment == "max"){
+		assign = Assign_Min_Max(cost, n);
+	} else{
+		for (int k = 0; k < n; k++) { assign[k] = k; }
+	}
+	stat.time_us = (ros::WallTime::now() - start).toSec()*1e6;
+
+	for (int r = 0; r < n; r++) {
+		int c = assign[r];
+		for (int i = 0; i < 3; i++) {
+			UAVs_info[uavs[r]].pos_des[i] = goals[c][i];
+		}
+		stat.sum += cost[r*n+c];
+		stat.max = std::max(stat.max, float(cost[r*n+c]));
+		if (c != r){ stat.changed++; }
+	}
+	return stat;
+}
+void QNode::Request_Global_Paths(){
+	if (occupancy.Loaded()){ global_request = true; } // taken by the next tick
+}
+
+void QNode::Start_Global_Paths(){
+	// Conflict-free grid paths from the current positions to pos_des. The paths are only apart
+	// step by step, so the fleet flies them in lockstep (Step_Global_Paths). CBS may take up to
+	// cbs_budget, so it runs on its own thread while the fleet holds where it is
+	global_plan plan;
+	plan.goals = goals_gen;
+	for (const auto &ind : avail_uavind){
+		plan.uavs.push_back(ind);
+		plan.start.push_back({{UAVs_info[ind].pos_cur[0], UAVs_info[ind].pos_cur[1], UAVs_info[ind].pos_cur[2]}});
+		plan.goal.push_back({{UAVs_info[ind].pos_des[0], UAVs_info[ind].pos_des[1], UAVs_info[ind].pos_des[2]}});
+		for (int i = 0; i < 3; i++) {
+			UAVs_info[ind].pos_des[i] = UAVs_info[ind].pos_cur[i];
+		}
+		global_active[ind] = true; // not arrived while holding
+	}
+	const OccupancyGrid &grid = occupancy; // loaded once in init, read only
+	float budget = cbs_budget, suboptimality = cbs_suboptimality;
+	global_job = std::async(std::launch::async, [plan, &grid, budget, suboptimality]() mutable {
+		std::vector<grid_cell> start(plan.uavs.size()), goal(plan.uavs.size());
+		for (size_t k = 0; k < plan.uavs.size(); k++) {
+			if (!grid.World_To_Cell(plan.start[k].data(), start[k].data()) ||
+					!grid.World_To_Cell(plan.goal[k].data(), goal[k].data())){
+				plan.stat.error = "uav" + std::to_string(plan.uavs[k]+1) + ": start or goal outside the map";
+				return plan;
+			}
+		}
+		CbsPlanner cbs(grid, budget, suboptimality);
+		std::vector<std::vector<grid_cell> > paths;
+		if (!cbs.Plan(start, goal, paths, plan.stat)){
+			if (plan.stat.agent >= 0){ plan.stat.error = "uav" + std::to_string(plan.uavs[plan.stat.agent]+1) + ": " + plan.stat.error; }
+			return plan;
+		}
+		plan.paths.resize(plan.uavs.size());
+		for (size_t k = 0; k < plan.uavs.size(); k++) {
+			for (const auto &cell : paths[k]){
+				waypoint wp;
+				grid.Cell_To_World(cell.data(), wp.data());
+				plan.paths[k].push_back(wp);
+			}
+			plan.paths[k].back() = plan.goal[k];
+		}
+		return plan;
+	});
+}
+
+void QNode::Apply_Global_Paths(const global_plan &plan){
+	char text[160];
+	if (!plan.stat.solved){
+		for (size_t k = 0; k < plan.uavs.size(); k++) { // the old behaviour: straight to the goals
+			for (int i = 0; i < 3; i++) {
+				UAVs_info[plan.uavs[k]].pos_des[i] = plan.goal[k][i];
+			}
+			global_active[plan.uavs[k]] = false;
+		}
+		std::snprintf(text, sizeof(text), "Global paths not planned, %s! Flying straight to the goals.", plan.stat.error.c_str());
+		ROS_WARN("%s", text);
+		events.Append(-1, Event_Warning, Event_General, text);
+		return;
+	}
+	for (size_t k = 0; k < plan.uavs.size(); k++) {
+		int ind = plan.uavs[k];
+		global_path[ind] = plan.paths[k];
+		global_active[ind] = global_path[ind].size() > 1;
+	}
+	global_step = 0;
+	std::snprintf(text, sizeof(text), "Global paths: %d uavs, %d steps, %d CBS nodes, %.1f ms",
+			plan.stat.agents, plan.stat.makespan, plan.stat.nodes, plan.stat.time_ms);
+	ROS_INFO("%s", text);
+	events.Append(-1, Event_Info, Event_General, text);
+}
+
+void QNode::Step_Global_Paths(){
+	std::lock_guard<std::mutex> lock(global_mutex);
+	if (global_job.valid() && global_job.wait_for(std::chrono::seconds(0)) == std::future_status::ready){
+		global_plan plan = global_job.get();
+		if (plan.goals == goals_gen){ Apply_Global_Paths(plan); } // else new goals were set meanwhile
+	}
+	if (!global_job.valid() && global_request.exchange(false)){
+		Start_Global_Paths();
+	}
+	if (global_step < 0){ return; }
+	// The fleet moves on to the next step once every moving uav reached its cell of this one
+	bool reached = true;
+	int last = 0;
+	for (const auto &ind : avail_uavind){
+		if (global_path[ind].empty()){ continue; }
+		int n = global_path[ind].size();
+		last = std::max(last, n-1);
+		if (!Move[ind]){ continue; }
+		const waypoint &wp = global_path[ind][std::min(global_step, n-1)];
+		float dist[3] = {wp[0] - UAVs_info[ind].pos_cur[0], wp[1] - UAVs_info[ind].pos_cur[1], wp[2] - UAVs_info[ind].pos_cur[2]};
+		if (sqrt(pow(dist[0],2)+pow(dist[1],2)+pow(dist[2],2)) >= 0.25){ reached = false; }
+	}
+	if (reached && global_step >= last){ // done, pos_des is left on the goals
+		global_step = -1;
+		for (int i = 0; i < DroneNumber; i++) {
+			global_path[i].clear();
+			global_active[i] = false;
+		}
+		return;
+	}
+	if (reached){ global_step++; }
+	for (const auto &ind : avail_uavind){
+		if (global_path[ind].empty()){ continue; }
+		int n = global_path[ind].size();
+		const waypoint &wp = global_path[ind][std::min(global_step, n-1)];
+		for (int i = 0; i < 3; i++) {
+			UAVs_info[ind].pos_des[i] = wp[i];
+		}
+		global_active[ind] = global_step < n-1;
+	}
+}
+
+void QNode::Check_Separation(){
+	std::vector<int> ids;
+	std::vector<std::array<float,3> > pos, vel;
+	stamped_state latest;
+	for (const auto &ind : avail_uavind){
+		if (!history[ind].Latest(latest)){ continue; } // no position yet
+		const outdoor_gcs::uav_info &uav = UAVs_info[ind];
+		std::array<float,3> v = {{uav.vel_cur[0], uav.vel_cur[1], uav.vel_cur[2]}};
+		if (separation_planned && Move[ind] && plan_output[ind].type != 0){
+			for (int i = 0; i < 3; i++) { v[i] = (uav.pos_nxt[i] - uav.pos_cur[i])/dt; }
+		}
+		ids.push_back(ind);
+		pos.push_back({{uav.pos_cur[0], uav.pos_cur[1], uav.pos_cur[2]}});
+		vel.push_back(v);
+	}
+	separation.Check(ids, pos, vel, sep_alerts, sep_stat);
+
+	// Log and report a pair when it enters the alert, once
+	std::set<std::pair<int,int> > now;
+	std::lock_guard<std::mutex> lock(sep_mutex);
+	for (const auto &alert : sep_alerts){
+		std::pair<int,int> pair(alert.a, alert.b);
+		now.insert(pair);
+		if (sep_active.count(pair)){ continue; }
+		ROS_WARN("Separation: uav%d & uav%d %.1f m apart, %.1f m in %.1f s", alert.a+1, alert.b+1, alert.dist, alert.d_cpa, alert.t_cpa);
+		GCS_LOG(Log_Warn, "separation: uav%d & uav%d %.2f m apart, %.2f m in %.2f s", alert.a+1, alert.b+1, alert.dist,
+				alert.d_cpa, alert.t_cpa);
+		sep_events.push_back(alert);
+	}
+	sep_active.swap(now);
+}
+
 void QNode::Update_px4_apm(bool TF){
 	px4_apm = TF;
 }
@@ -838,6 +2265,99 @@ float QNode::GetFlockParam(int i){
 float QNode::GetORCAParam(int i){
 	return orca_param[i];
 }
+outdoor_gcs::pub_stat QNode::GetCmdPubStat(){
+	return cmd_pub_stat;
+}
+bool QNode::GetFleetCommandMode(){
+	return fleet_cmd;
+}
+outdoor_gcs::stream_stat QNode::GetStreamStat(){
+	return streamer.GetStat();
+}
+float QNode::GetStreamRate(){
+	return stream_rate;
+}
+
+outdoor_gcs::FleetSnapshot QNode::GetSnapshot(){
+	std::lock_guard<std::mutex> lock(snap_mutex);
+	return snap;
+}
+
+bool QNode::GetEventPlanning(){
+	return event_planning;
+}
+
+const outdoor_gcs::LatencyHistogram &QNode::GetReactLatency(){
+	return react_latency;
+}
+
+outdoor_gcs::plan_stat QNode::GetPlanStat(){
+	return plan_time;
+}
+void QNode::GetFenceCount(int ind, int count[2]){
+	count[0] = fence_clamped[ind];
+	count[1] = fence_rejected[ind];
+}
+bool QNode::GetFenceLoaded(){
+	return geofence.Loaded();
+}
+bool QNode::GetFenceInside(const float p[3]){
+	return !geofence.Loaded() || geofence.Contains(p);
+}
+float QNode::GetSyncDelay(){
+	return sync_delay;
+}
+float QNode::GetTakeoffStagger(){
+	return takeoff_stagger;
+}
+int QNode::GetSchedulePending(){
+	return scheduler ? scheduler->Pending() : 0;
+}
+const outdoor_gcs::LatencyHistogram &QNode::GetScheduleSkew(){
+	return scheduler->Skew();
+}
+std::vector<outdoor_gcs::sched_record> QNode::GetScheduleRecent(){
+	return scheduler ? scheduler->Recent() : std::vector<sched_record>();
+}
+outdoor_gcs::mission_status QNode::GetMissionStatus(){
+	return mission.Status(ros::WallTime::now().toSec());
+}
+outdoor_gcs::EventLog &QNode::GetEventLog(){
+	return events;
+}
+outdoor_gcs::CommandTracer &QNode::GetCommandTracer(){
+	return tracer;
+}
+outdoor_gcs::clock_estimate QNode::GetClockEstimate(int ind){
+	return clock_sync.Estimate(ind);
+}
+bool QNode::GetClockSync(){
+	return clock_passive;
+}
+outdoor_gcs::readiness_report QNode::GetReadiness(){
+	std::lock_guard<std::mutex> lock(ready_mutex);
+	return ready_report;
+}
+outdoor_gcs::separation_stat QNode::GetSeparationStat(){
+	return sep_stat;
+}
+std::vector<outdoor_gcs::separation_alert> QNode::GetSeparationEvents(){
+	std::lock_guard<std::mutex> lock(sep_mutex);
+	std::vector<outdoor_gcs::separation_alert> events;
+	events.swap(sep_events);
+	return events;
+}
+
+std::vector<outdoor_gcs::plugin_stat> QNode::GetPluginStats(){
+	plugin_stats_wanted = true; // refreshed by the next plan, at the rate the GUI reads them
+	std::lock_guard<std::mutex> lock(plugin_mutex);
+	return plugin_stats;
+}
+
+int QNode::GetActivePlanner(){
+	std::lock_guard<std::mutex> lock(plugin_mutex);
+	return plugin_active;
+}
 
 
 QStringList QNode::lsAllTopics(){
@@ -0,0 +1,89 @@
+/**
+ * @file /src/readiness.cpp
+ *
+ * @brief Pre-flight readiness of a vehicle against configurable criteria.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cstdio>
+#include "../include/outdoor_gcs/readiness.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const char *fix_name(int fix_type){
+	static const char *names[] = {"no GPS", "no fix", "2D", "3D", "DGPS", "RTK float", "RTK fixed", "static", "PPP"};
+	return fix_type >= 0 && fix_type <= 8 ? names[fix_type] : "unknown";
+}
+
+void add(std::string &reason, const char *text){
+	if (!reason.empty()){ reason += ", "; }
+	reason += text;
+}
+
+void add(std::string &reason, const char *format, double a, double b){
+	char text[64];
+	std::snprintf(text, sizeof(text), format, a, b);
+	add(reason, text);
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+unsigned Check_Readiness(const readiness_criteria &criteria, const readiness_input &in, std::string &reason){
+	unsigned failed = 0;
+	reason.clear();
+	if (!in.connected){
+		failed |= Ready_Connected;
+		add(reason, "not connected");
+	}
+	if (criteria.max_age > 0 && (in.age < 0 || in.age > criteria.max_age)){
+		failed |= Ready_Telemetry;
+		if (in.age < 0){ add(reason, "no telemetry"); }
+		else{ add(reason, "telemetry %.1f s old > %.1f", in.age, criteria.max_age); }
+	}
+	if (criteria.min_fix > 0 && in.fix_type < criteria.min_fix){
+		failed |= Ready_Fix;
+		if (!reason.empty()){ reason += ", "; }
+		reason += std::string("fix ") + fix_name(in.fix_type) + " < " + fix_name(criteria.min_fix);
+	}
+	if (criteria.min_satellites > 0 && in.satellites < criteria.min_satellites){
+		failed |= Ready_Satellites;
+		if (in.satellites < 0){ add(reason, "satellites unknown"); }
+		else{ add(reason, "%.0f sats < %.0f", in.satellites, criteria.min_satellites); }
+	}
+	if (criteria.max_hdop > 0 && (in.hdop < 0 || in.hdop > criteria.max_hdop)){
+		failed |= Ready_Hdop;
+		if (in.hdop < 0){ add(reason, "HDOP unknown"); }
+		else{ add(reason, "HDOP %.2f > %.2f", in.hdop, criteria.max_hdop); }
+	}
+	if (criteria.max_h_acc > 0 && (in.h_acc < 0 || in.h_acc > criteria.max_h_acc)){
+		failed |= Ready_HAcc;
+		if (in.h_acc < 0){ add(reason, "h_acc unknown"); }
+		else{ add(reason, "h_acc %.2f m > %.2f", in.h_acc, criteria.max_h_acc); }
+	}
+	if (criteria.home && !in.home){
+		failed |= Ready_Home;
+		add(reason, "home not set");
+	}
+	return failed;
+}
+
+}  // namespace outdoor_gcs
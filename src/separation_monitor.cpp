@@ -0,0 +1,103 @@
+/**
+ * @file /src/separation_monitor.cpp
+ *
+ * @brief Separation monitor: current distance and closest point of approach
+ * of every pair of vehicles, alerts below a threshold.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "../include/outdoor_gcs/separation_monitor.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+void SeparationMonitor::Configure(float threshold_in, float horizon_in){
+	threshold = threshold_in;
+	horizon = horizon_in;
+}
+
+void SeparationMonitor::Check(const std::vector<int> &ids, const std::vector<std::array<float,3> > &pos,
+		const std::vector<std::array<float,3> > &vel, std::vector<separation_alert> &alerts, separation_stat &stat){
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	alerts.clear();
+	stat = separation_stat();
+	int n = ids.size();
+	stat.num = n;
+
+	// Box swept over the horizon, half the threshold on each side
+	boxes.resize(n);
+	for (int k = 0; k < n; k++) {
+		for (int i = 0; i < 3; i++) {
+			float end = pos[k][i] + vel[k][i]*horizon;
+			boxes[k].lo[i] = std::min(pos[k][i], end) - 0.5f*threshold;
+			boxes[k].hi[i] = std::max(pos[k][i], end) + 0.5f*threshold;
+		}
+		boxes[k].k = k;
+	}
+	std::sort(boxes.begin(), boxes.end(), [](const box &l, const box &r){ return l.lo[0] < r.lo[0]; });
+
+	active.clear();
+	for (int j = 0; j < n; j++) {
+		const box &bj = boxes[j];
+		// Drop the boxes that end before this one starts on x
+		size_t keep = 0;
+		for (size_t m = 0; m < active.size(); m++) {
+			if (boxes[active[m]].hi[0] >= bj.lo[0]){ active[keep++] = active[m]; }
+		}
+		active.resize(keep);
+		for (const auto &m : active){
+			const box &bm = boxes[m];
+			if (bm.hi[1] < bj.lo[1] || bj.hi[1] < bm.lo[1] || bm.hi[2] < bj.lo[2] || bj.hi[2] < bm.lo[2]){ continue; }
+			stat.candidates++;
+			// Closest point of approach of the relative motion, within the horizon
+			int a = bm.k, b = bj.k;
+			float p[3], v[3], pv = 0, vv = 0, pp = 0;
+			for (int i = 0; i < 3; i++) {
+				p[i] = pos[b][i] - pos[a][i];
+				v[i] = vel[b][i] - vel[a][i];
+				pv += p[i]*v[i];
+				vv += v[i]*v[i];
+				pp += p[i]*p[i];
+			}
+			float t = vv > 0 ? std::min(std::max(-pv/vv, 0.0f), horizon) : 0;
+			float cpa2 = 0;
+			for (int i = 0; i < 3; i++) {
+				cpa2 += (p[i] + v[i]*t)*(p[i] + v[i]*t);
+			}
+			float dist = std::sqrt(pp), cpa = std::sqrt(cpa2);
+			// Every pair within the threshold is a candidate, farther ones may have been swept away
+			if (dist < threshold && (stat.min_dist < 0 || dist < stat.min_dist)){ stat.min_dist = dist; }
+			if (cpa < threshold && (stat.min_cpa < 0 || cpa < stat.min_cpa)){ stat.min_cpa = cpa; }
+			if (cpa < threshold){
+				separation_alert alert;
+				alert.a = std::min(ids[a], ids[b]);
+				alert.b = std::max(ids[a], ids[b]);
+				alert.dist = dist;
+				alert.t_cpa = t;
+				alert.d_cpa = cpa;
+				alerts.push_back(alert);
+			}
+		}
+		active.push_back(j);
+	}
+	std::sort(alerts.begin(), alerts.end(), [](const separation_alert &l, const separation_alert &r){ return l.d_cpa < r.d_cpa; });
+	stat.alerts = alerts.size();
+	stat.time_us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,126 @@
+/**
+ * @file /src/setpoint_streamer.cpp
+ *
+ * @brief High-rate setpoint streaming between planner outputs.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "../include/outdoor_gcs/setpoint_streamer.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+SetpointStreamer::SetpointStreamer(int size) :
+	refs(size)
+	{}
+
+void SetpointStreamer::Update_Reference(int ind, const ros::Time &stamp, const float pos[3], const float vel[3]){
+	std::lock_guard<std::mutex> lock(ref_mutex);
+	ref_pair &r = refs[ind];
+	if (r.num > 0 && stamp <= r.stamp[1]){ return; } // same or older planner tick
+	r.stamp[0] = r.stamp[1];
+	for (int i = 0; i < 3; i++) {
+		r.pos[0][i] = r.pos[1][i];
+		r.vel[0][i] = r.vel[1][i];
+		r.pos[1][i] = pos[i];
+		r.vel[1][i] = vel[i];
+	}
+	r.stamp[1] = stamp;
+	r.num = std::min(r.num+1, 2);
+}
+
+void SetpointStreamer::Reset(int ind){
+	std::lock_guard<std::mutex> lock(ref_mutex);
+	refs[ind].num = 0;
+}
+
+bool SetpointStreamer::Active(int ind){
+	std::lock_guard<std::mutex> lock(ref_mutex);
+	return refs[ind].num > 0;
+}
+
+bool SetpointStreamer::Sample(int ind, const ros::Time &t, outdoor_gcs::TrajectoryPoint &ref){
+	ref_pair r;
+	{
+		std::lock_guard<std::mutex> lock(ref_mutex);
+		r = refs[ind];
+	}
+	if (r.num == 0){ return false; }
+
+	ref.header.stamp = t;
+	ref.Sub_mode = 0;
+	ref.yaw_ref = 0;
+	if (r.num == 1){ // nothing to interpolate from yet, hold the only output
+		for (int i = 0; i < 3; i++) {
+			ref.position_ref[i] = r.pos[1][i];
+			ref.velocity_ref[i] = 0;
+			ref.acceleration_ref[i] = 0;
+		}
+		return true;
+	}
+
+	// Segment runs from the previous output to the latest one and lasts one planner period
+	float T = (r.stamp[1] - r.stamp[0]).toSec();
+	if (T <= 0){ T = 1e-3; }
+	float s = (t - r.stamp[1]).toSec()/T;
+	bool hold = s >= 1.0;
+	s = std::min(std::max(s, 0.0f), 1.0f);
+	ref.time_from_start = s*T;
+
+	if (!cubic){
+		for (int i = 0; i < 3; i++) {
+			ref.position_ref[i] = r.pos[0][i] + s*(r.pos[1][i] - r.pos[0][i]);
+			ref.velocity_ref[i] = hold ? 0 : (r.pos[1][i] - r.pos[0][i])/T;
+			ref.acceleration_ref[i] = 0;
+		}
+		return true;
+	}
+
+	// Cubic Hermite basis and its derivatives w.r.t. s
+	float s2 = s*s, s3 = s2*s;
+	float h00 = 2*s3 - 3*s2 + 1, h10 = s3 - 2*s2 + s, h01 = -2*s3 + 3*s2, h11 = s3 - s2;
+	float d00 = 6*s2 - 6*s, d10 = 3*s2 - 4*s + 1, d01 = -6*s2 + 6*s, d11 = 3*s2 - 2*s;
+	float dd00 = 12*s - 6, dd10 = 6*s - 4, dd01 = -12*s + 6, dd11 = 6*s - 2;
+	for (int i = 0; i < 3; i++) {
+		float p0 = r.pos[0][i], p1 = r.pos[1][i];
+		float m0 = r.vel[0][i]*T, m1 = r.vel[1][i]*T;
+		ref.position_ref[i] = h00*p0 + h10*m0 + h01*p1 + h11*m1;
+		ref.velocity_ref[i] = hold ? 0 : (d00*p0 + d10*m0 + d01*p1 + d11*m1)/T;
+		ref.acceleration_ref[i] = hold ? 0 : (dd00*p0 + dd10*m0 + dd01*p1 + dd11*m1)/(T*T);
+	}
+	return true;
+}
+
+void SetpointStreamer::Record_Tick(const ros::WallTime &now, float expected_period){
+	std::lock_guard<std::mutex> lock(stat_mutex);
+	stat.period_ms = expected_period*1e3;
+	if (!last_tick.isZero()){
+		float jitter_us = std::fabs((now - last_tick).toSec() - expected_period)*1e6;
+		jitter_sum += jitter_us;
+		stat.ticks++;
+		stat.jitter_mean_us = jitter_sum/stat.ticks;
+		stat.jitter_max_us = std::max(stat.jitter_max_us, jitter_us);
+	}
+	last_tick = now;
+}
+
+outdoor_gcs::stream_stat SetpointStreamer::GetStat(){
+	std::lock_guard<std::mutex> lock(stat_mutex);
+	return stat;
+}
+
+}  // namespace outdoor_gcs
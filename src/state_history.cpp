@@ -0,0 +1,92 @@
+/**
+ * @file /src/state_history.cpp
+ *
+ * @brief Stamped state history per uav and time-aligned fleet snapshots.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include "../include/outdoor_gcs/state_history.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+StateHistory::StateHistory() :
+	head(0)
+{
+	for (int i = 0; i < Capacity; i++) {
+		slots[i].seq.store(0, std::memory_order_relaxed);
+	}
+}
+
+void StateHistory::Push(const stamped_state &s){
+	uint32_t h = head.load(std::memory_order_relaxed);
+	slot &sl = slots[h % Capacity];
+	uint32_t seq = sl.seq.load(std::memory_order_relaxed);
+	sl.seq.store(seq+1, std::memory_order_relaxed); // odd: being written
+	std::atomic_thread_fence(std::memory_order_release);
+	sl.state = s;
+	sl.seq.store(seq+2, std::memory_order_release);
+	head.store(h+1, std::memory_order_release);
+}
+
+bool StateHistory::read(uint32_t index, stamped_state &s) const {
+	const slot &sl = slots[index % Capacity];
+	uint32_t before = sl.seq.load(std::memory_order_acquire);
+	if (before & 1){ return false; }
+	s = sl.state;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return sl.seq.load(std::memory_order_relaxed) == before;
+}
+
+bool StateHistory::Latest(stamped_state &s) const {
+	uint32_t h = head.load(std::memory_order_acquire);
+	for (uint32_t k = 1; k <= h && k < Capacity; k++) {
+		if (read(h-k, s)){ return true; }
+	}
+	return false;
+}
+
+bool StateHistory::Sample(const ros::Time &t, float pos[3], float vel[3]) const {
+	uint32_t h = head.load(std::memory_order_acquire);
+	stamped_state newer, older;
+	bool have_newer = false;
+	// Walk from newest to oldest, the oldest slot is left alone as the writer may be on it
+	for (uint32_t k = 1; k <= h && k < Capacity; k++) {
+		if (!read(h-k, older)){ continue; }
+		if (older.stamp <= t){
+			if (!have_newer || newer.stamp <= older.stamp){ // t at or after the newest sample
+				newer = older;
+				have_newer = true;
+				break;
+			}
+			float w = (t - older.stamp).toSec()/(newer.stamp - older.stamp).toSec();
+			for (int i = 0; i < 3; i++) {
+				pos[i] = older.pos[i] + w*(newer.pos[i] - older.pos[i]);
+				vel[i] = older.vel[i] + w*(newer.vel[i] - older.vel[i]);
+			}
+			return true;
+		}
+		newer = older;
+		have_newer = true;
+	}
+	if (!have_newer){ return false; }
+	for (int i = 0; i < 3; i++) { // nearest sample
+		pos[i] = newer.pos[i];
+		vel[i] = newer.vel[i];
+	}
+	return true;
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,151 @@
+/**
+ * @file /src/state_predictor.cpp
+ *
+ * @brief Per-uav constant-acceleration Kalman filter for latency compensation.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "../include/outdoor_gcs/state_predictor.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+StatePredictor::StatePredictor() {
+	for (int k = 0; k < 3; k++) {
+		for (int i = 0; i < 3; i++) {
+			axis[k].x[i] = 0;
+			for (int j = 0; j < 3; j++) { axis[k].P[i][j] = 0; }
+		}
+	}
+}
+
+void StatePredictor::Configure(float q, float rp, float rv, float ra, float horizon){
+	q_jerk = q;
+	r_pos = rp*rp;
+	r_vel = rv*rv;
+	r_acc = ra*ra;
+	max_horizon = horizon;
+}
+
+void StatePredictor::propagate(axis_state &s, double dt) const {
+	if (dt <= 0){ return; }
+	double dt2 = dt*dt, dt3 = dt2*dt, dt4 = dt3*dt, dt5 = dt4*dt;
+	double F[3][3] = {{1, dt, dt2/2}, {0, 1, dt}, {0, 0, 1}};
+	double Q[3][3] = {{dt5/20, dt4/8, dt3/6}, {dt4/8, dt3/3, dt2/2}, {dt3/6, dt2/2, dt}};
+
+	double x[3];
+	for (int i = 0; i < 3; i++) {
+		x[i] = 0;
+		for (int j = 0; j < 3; j++) { x[i] += F[i][j]*s.x[j]; }
+	}
+	double FP[3][3], P[3][3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			FP[i][j] = 0;
+			for (int k = 0; k < 3; k++) { FP[i][j] += F[i][k]*s.P[k][j]; }
+		}
+	}
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			P[i][j] = q_jerk*Q[i][j];
+			for (int k = 0; k < 3; k++) { P[i][j] += FP[i][k]*F[j][k]; }
+		}
+	}
+	for (int i = 0; i < 3; i++) {
+		s.x[i] = x[i];
+		for (int j = 0; j < 3; j++) { s.P[i][j] = P[i][j]; }
+	}
+}
+
+void StatePredictor::correct(axis_state &s, int idx, double z, double r){
+	// Scalar measurement of state idx
+	double S = s.P[idx][idx] + r;
+	double K[3];
+	for (int i = 0; i < 3; i++) { K[i] = s.P[i][idx]/S; }
+	double y = z - s.x[idx];
+	for (int i = 0; i < 3; i++) { s.x[i] += K[i]*y; }
+	double Prow[3] = {s.P[idx][0], s.P[idx][1], s.P[idx][2]};
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) { s.P[i][j] -= K[i]*Prow[j]; }
+	}
+}
+
+bool StatePredictor::advance(const ros::Time &t){
+	// Measurements slightly older than the filter (e.g. imu after odometry) are fused at the
+	// filter time, anything older than that is dropped
+	double dt = (t - stamp).toSec();
+	if (dt < -0.02){ return false; }
+	if (dt > 0){
+		for (int k = 0; k < 3; k++) { propagate(axis[k], dt); }
+		stamp = t;
+	}
+	return true;
+}
+
+void StatePredictor::Update_Odometry(const ros::Time &t, const float pos[3], const float vel[3]){
+	if (!init || (t - stamp).toSec() > 1.0){ // (re)start after a telemetry gap
+		for (int k = 0; k < 3; k++) {
+			axis[k].x[0] = pos[k];
+			axis[k].x[1] = vel[k];
+			axis[k].x[2] = 0;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) { axis[k].P[i][j] = 0; }
+			}
+			axis[k].P[0][0] = r_pos;
+			axis[k].P[1][1] = r_vel;
+			axis[k].P[2][2] = r_acc;
+		}
+		stamp = t;
+		init = true;
+		return;
+	}
+	if (!advance(t)){ return; }
+	for (int k = 0; k < 3; k++) {
+		correct(axis[k], 0, pos[k], r_pos);
+		correct(axis[k], 1, vel[k], r_vel);
+	}
+}
+
+void StatePredictor::Update_Acceleration(const ros::Time &t, const float acc[3]){
+	if (!init){ return; } // position first
+	if (!advance(t)){ return; }
+	for (int k = 0; k < 3; k++) {
+		correct(axis[k], 2, acc[k], r_acc);
+	}
+}
+
+bool StatePredictor::Predict(const ros::Time &t, float pos[3], float vel[3]) const {
+	if (!init){ return false; }
+	double dt = std::min(std::max((t - stamp).toSec(), 0.0), max_horizon);
+	double dt2 = dt*dt;
+	for (int k = 0; k < 3; k++) {
+		const axis_state &s = axis[k];
+		pos[k] = s.x[0] + s.x[1]*dt + s.x[2]*dt2/2;
+		vel[k] = s.x[1] + s.x[2]*dt;
+	}
+	return true;
+}
+
+bool StatePredictor::Initialized() const {
+	return init;
+}
+
+ros::Time StatePredictor::Stamp() const {
+	return stamp;
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,136 @@
+/**
+ * @file /src/thread_pool.cpp
+ *
+ * @brief Work-stealing thread pool for per-uav computations.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include "../include/outdoor_gcs/thread_pool.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+ThreadPool::ThreadPool(int size) :
+	queued(0)
+{
+	size = std::max(size, 1);
+	for (int i = 0; i < size; i++) {
+		queues.push_back(std::unique_ptr<task_queue>(new task_queue));
+	}
+	for (int i = 0; i < size-1; i++) {
+		threads.push_back(std::thread(&ThreadPool::worker, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(wake_mutex);
+		stop = true;
+	}
+	wake.notify_all();
+	for (auto &t : threads) {
+		t.join();
+	}
+}
+
+int ThreadPool::Size() const {
+	return queues.size();
+}
+
+bool ThreadPool::pop(int self, task &t){
+	{
+		std::lock_guard<std::mutex> lock(queues[self]->mutex);
+		if (!queues[self]->tasks.empty()){
+			t = std::move(queues[self]->tasks.back());
+			queues[self]->tasks.pop_back();
+			queued--;
+			return true;
+		}
+	}
+	for (size_t k = 1; k < queues.size(); k++) {
+		task_queue &victim = *queues[(self+k) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty()){
+			t = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			queued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::worker(int self){
+	while (true) {
+		task t;
+		if (pop(self, t)){
+			t();
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(wake_mutex);
+		wake.wait(lock, [this]{ return stop || queued > 0; });
+		if (stop){ return; }
+	}
+}
+
+void ThreadPool::Parallel_For(int n, const std::function<void(int)> &f, int grain){
+	if (n <= 0){ return; }
+	grain = std::max(grain, 1);
+	if (threads.empty() || n <= grain){
+		for (int i = 0; i < n; i++) { f(i); }
+		return;
+	}
+
+	// Shared by the chunks of this call, lives until all of them are done
+	struct job
+	{
+		std::atomic<int> left;
+		std::mutex mutex;
+		std::condition_variable done;
+	};
+	std::shared_ptr<job> j(new job);
+	int chunks = (n + grain - 1)/grain;
+	j->left = chunks;
+	for (int c = 0; c < chunks; c++) {
+		int begin = c*grain, end = std::min(n, begin + grain);
+		task t = [j, &f, begin, end]{
+			for (int i = begin; i < end; i++) { f(i); }
+			if (--j->left == 0){
+				std::lock_guard<std::mutex> lock(j->mutex);
+				j->done.notify_all();
+			}
+		};
+		task_queue &q = *queues[c % queues.size()];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		q.tasks.push_back(std::move(t));
+		queued++;
+	}
+	{
+		std::lock_guard<std::mutex> lock(wake_mutex);
+	}
+	wake.notify_all();
+
+	// Help until nothing is left to take, then wait for chunks still running elsewhere
+	int self = queues.size()-1;
+	task t;
+	while (j->left > 0 && pop(self, t)) {
+		t();
+	}
+	std::unique_lock<std::mutex> lock(j->mutex);
+	j->done.wait(lock, [&j]{ return j->left == 0; });
+}
+
+}  // namespace outdoor_gcs
@@ -0,0 +1,318 @@
+/**
+ * @file /src/trajectory.cpp
+ *
+ * @brief Precomputed time-parameterized trajectories.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "../include/outdoor_gcs/trajectory.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+namespace outdoor_gcs {
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+// Number of samples so that both ends of [0, period] land exactly on a sample
+int sample_count(float period, float dt){
+	return std::max(2, int(std::ceil(period/dt)) + 1);
+}
+
+float seg_length(const waypoint &a, const waypoint &b){
+	return std::sqrt(std::pow(b[0]-a[0],2) + std::pow(b[1]-a[1],2) + std::pow(b[2]-a[2],2));
+}
+
+// d^j/dtau^j of tau^i
+double dpow(int i, int j, double tau){
+	if (j > i){ return 0.0; }
+	double coef = 1.0;
+	for (int k = 0; k < j; k++) { coef *= (i-k); }
+	return coef*std::pow(tau, i-j);
+}
+
+// Solves A x = B in place (B holds 3 right-hand sides), Gaussian elimination with partial pivoting
+bool solve(std::vector<double> &A, std::vector<double> &B, int n){
+	for (int c = 0; c < n; c++) {
+		int piv = c;
+		for (int r = c+1; r < n; r++) {
+			if (std::fabs(A[r*n+c]) > std::fabs(A[piv*n+c])){ piv = r; }
+		}
+		if (std::fabs(A[piv*n+c]) < 1e-12){ return false; }
+		if (piv != c){
+			for (int k = 0; k < n; k++) { std::swap(A[c*n+k], A[piv*n+k]); }
+			for (int k = 0; k < 3; k++) { std::swap(B[c*3+k], B[piv*3+k]); }
+		}
+		for (int r = c+1; r < n; r++) {
+			double f = A[r*n+c]/A[c*n+c];
+			if (f == 0.0){ continue; }
+			for (int k = c; k < n; k++) { A[r*n+k] -= f*A[c*n+k]; }
+			for (int k = 0; k < 3; k++) { B[r*3+k] -= f*B[c*3+k]; }
+		}
+	}
+	for (int c = n-1; c >= 0; c--) {
+		for (int k = 0; k < 3; k++) {
+			double v = B[c*3+k];
+			for (int j = c+1; j < n; j++) { v -= A[c*n+j]*B[j*3+k]; }
+			B[c*3+k] = v/A[c*n+c];
+		}
+	}
+	return true;
+}
+
+}
+
+/*****************************************************************************
+** Implementation
+*****************************************************************************/
+
+TrajectoryTable::TrajectoryTable() :
+	dt(0.01),
+	loop(false)
+	{}
+
+bool TrajectoryTable::Empty() const {
+	return samples.empty();
+}
+
+float TrajectoryTable::Duration() const {
+	return samples.size() < 2 ? 0.0 : dt*(samples.size()-1);
+}
+
+waypoint TrajectoryTable::Start() const {
+	waypoint p = {{0, 0, 0}};
+	if (!samples.empty()){
+		p[0] = samples[0].pos[0];
+		p[1] = samples[0].pos[1];
+		p[2] = samples[0].pos[2];
+	}
+	return p;
+}
+
+bool TrajectoryTable::Evaluate(float t, outdoor_gcs::TrajectoryPoint &ref) const {
+	if (samples.empty()){ return false; }
+	float duration = Duration();
+	if (loop && duration > 0){
+		t = std::fmod(t, duration);
+		if (t < 0){ t += duration; }
+	} else{
+		t = std::min(std::max(t, 0.0f), duration);
+	}
+	int last = samples.size()-1;
+	float f = (last > 0) ? t/dt : 0.0;
+	int idx = std::min(int(f), std::max(last-1, 0));
+	float w = std::min(std::max(f - idx, 0.0f), 1.0f);
+	const traj_sample &a = samples[idx];
+	const traj_sample &b = samples[std::min(idx+1, last)];
+
+	ref.time_from_start = t;
+	ref.Sub_mode = 0;
+	for (int i = 0; i < 3; i++) {
+		ref.position_ref[i] = a.pos[i] + w*(b.pos[i] - a.pos[i]);
+		ref.velocity_ref[i] = a.vel[i] + w*(b.vel[i] - a.vel[i]);
+		ref.acceleration_ref[i] = a.acc[i] + w*(b.acc[i] - a.acc[i]);
+	}
+	// A non-looping trajectory rests at its end
+	if (!loop && t >= duration){
+		for (int i = 0; i < 3; i++) {
+			ref.velocity_ref[i] = 0;
+			ref.acceleration_ref[i] = 0;
+		}
+	}
+	return true;
+}
+
+TrajectoryTable TrajectoryTable::Polyline(const std::vector<waypoint> &wps, float period, bool loop, float dt){
+	TrajectoryTable traj;
+	traj.loop = loop;
+	if (wps.empty()){ return traj; }
+
+	std::vector<waypoint> pts = wps;
+	if (loop){ pts.push_back(wps[0]); }
+	std::vector<float> cum(pts.size(), 0.0);
+	for (size_t k = 1; k < pts.size(); k++) {
+		cum[k] = cum[k-1] + seg_length(pts[k-1], pts[k]);
+	}
+	float total = cum.back();
+
+	int n = sample_count(period, dt);
+	traj.dt = period/(n-1);
+	traj.samples.resize(n);
+	float speed = (period > 0) ? total/period : 0.0;
+	size_t seg = 0;
+	for (int s = 0; s < n; s++) {
+		float arc = std::min(speed*s*traj.dt, total);
+		while (seg+2 < pts.size() && arc > cum[seg+1]){ seg++; }
+		traj_sample &out = traj.samples[s];
+		if (pts.size() == 1 || total <= 0){
+			for (int i = 0; i < 3; i++) {
+				out.pos[i] = pts[0][i];
+				out.vel[i] = 0;
+				out.acc[i] = 0;
+			}
+			continue;
+		}
+		float len = cum[seg+1] - cum[seg];
+		float w = (len > 0) ? (arc - cum[seg])/len : 0.0;
+		for (int i = 0; i < 3; i++) {
+			out.pos[i] = pts[seg][i] + w*(pts[seg+1][i] - pts[seg][i]);
+			out.vel[i] = (len > 0) ? speed*(pts[seg+1][i] - pts[seg][i])/len : 0.0;
+			out.acc[i] = 0;
+		}
+	}
+	return traj;
+}
+
+TrajectoryTable TrajectoryTable::Circle(const waypoint &center, float radius, float period, float dt){
+	TrajectoryTable traj;
+	traj.loop = true;
+	int n = sample_count(period, dt);
+	traj.dt = period/(n-1);
+	traj.samples.resize(n);
+	float w = (period > 0) ? 2*M_PI/period : 0.0;
+	for (int s = 0; s < n; s++) {
+		float theta = w*s*traj.dt;
+		float c = std::cos(theta), sn = std::sin(theta);
+		traj_sample &out = traj.samples[s];
+		out.pos[0] = center[0] + radius*c;
+		out.pos[1] = center[1] + radius*sn;
+		out.pos[2] = center[2];
+		out.vel[0] = -radius*w*sn;
+		out.vel[1] = radius*w*c;
+		out.vel[2] = 0;
+		out.acc[0] = -radius*w*w*c;
+		out.acc[1] = -radius*w*w*sn;
+		out.acc[2] = 0;
+	}
+	return traj;
+}
+
+TrajectoryTable TrajectoryTable::Lemniscate(const waypoint &center, float size, float period, float dt){
+	TrajectoryTable traj;
+	traj.loop = true;
+	int n = sample_count(period, dt);
+	traj.dt = period/(n-1);
+	traj.samples.resize(n);
+	float a = size/2;
+	float w = (period > 0) ? 2*M_PI/period : 0.0;
+	for (int s = 0; s < n; s++) {
+		// x = a sin(th), y = a sin(th) cos(th) = a/2 sin(2 th)
+		float theta = w*s*traj.dt;
+		traj_sample &out = traj.samples[s];
+		out.pos[0] = center[0] + a*std::sin(theta);
+		out.pos[1] = center[1] + a/2*std::sin(2*theta);
+		out.pos[2] = center[2];
+		out.vel[0] = a*w*std::cos(theta);
+		out.vel[1] = a*w*std::cos(2*theta);
+		out.vel[2] = 0;
+		out.acc[0] = -a*w*w*std::sin(theta);
+		out.acc[1] = -2*a*w*w*std::sin(2*theta);
+		out.acc[2] = 0;
+	}
+	return traj;
+}
+
+TrajectoryTable TrajectoryTable::MinJerk(const std::vector<waypoint> &wps, float period, bool loop, float dt){
+	return MinDerivative(3, wps, period, loop, dt);
+}
+
+TrajectoryTable TrajectoryTable::MinSnap(const std::vector<waypoint> &wps, float period, bool loop, float dt){
+	return MinDerivative(4, wps, period, loop, dt);
+}
+
+TrajectoryTable TrajectoryTable::MinDerivative(int r, const std::vector<waypoint> &wps, float period, bool loop, float dt){
+	// Minimizing the r-th derivative gives a degree 2r-1 piecewise polynomial, continuous up to
+	// derivative 2r-2 at every interior waypoint. Segment times are proportional to their length.
+	if (wps.size() < 2){ return Polyline(wps, period, loop, dt); }
+	std::vector<waypoint> pts = wps;
+	if (loop){ pts.push_back(wps[0]); }
+	int M = pts.size()-1;
+	int nc = 2*r;
+	int N = nc*M;
+
+	std::vector<double> T(M), t0(M+1, 0.0);
+	double total = 0;
+	for (int k = 0; k < M; k++) {
+		T[k] = std::max(seg_length(pts[k], pts[k+1]), 1e-3f);
+		total += T[k];
+	}
+	for (int k = 0; k < M; k++) {
+		T[k] *= period/total;
+		t0[k+1] = t0[k] + T[k];
+	}
+
+	std::vector<double> A(N*N, 0.0), B(N*3, 0.0);
+	int row = 0;
+	for (int k = 0; k < M; k++) { // positions at both ends of every segment
+		for (int i = 0; i < nc; i++) {
+			A[row*N + k*nc+i] = dpow(i, 0, 0.0);
+			A[(row+1)*N + k*nc+i] = dpow(i, 0, 1.0);
+		}
+		for (int d = 0; d < 3; d++) {
+			B[row*3+d] = pts[k][d];
+			B[(row+1)*3+d] = pts[k+1][d];
+		}
+		row += 2;
+	}
+	int joints = loop ? M : M-1;
+	for (int k = 0; k < joints; k++) { // derivative continuity at joints (and across the loop seam)
+		int a = k, b = (k+1) % M;
+		for (int j = 1; j <= 2*r-2; j++) {
+			for (int i = 0; i < nc; i++) {
+				A[row*N + a*nc+i] += dpow(i, j, 1.0)/std::pow(T[a], j);
+				A[row*N + b*nc+i] -= dpow(i, j, 0.0)/std::pow(T[b], j);
+			}
+			row++;
+		}
+	}
+	if (!loop){ // rest at both ends
+		for (int j = 1; j <= r-1; j++) {
+			for (int i = 0; i < nc; i++) {
+				A[row*N + i] = dpow(i, j, 0.0);
+				A[(row+1)*N + (M-1)*nc+i] = dpow(i, j, 1.0);
+			}
+			row += 2;
+		}
+	}
+	if (!solve(A, B, N)){ return Polyline(wps, period, loop, dt); }
+
+	TrajectoryTable traj;
+	traj.loop = loop;
+	int n = sample_count(period, dt);
+	traj.dt = period/(n-1);
+	traj.samples.resize(n);
+	int seg = 0;
+	for (int s = 0; s < n; s++) {
+		double t = std::min(double(s*traj.dt), t0[M]);
+		while (seg < M-1 && t > t0[seg+1]){ seg++; }
+		double tau = (t - t0[seg])/T[seg];
+		traj_sample &out = traj.samples[s];
+		for (int d = 0; d < 3; d++) {
+			double p = 0, v = 0, acc = 0;
+			for (int i = 0; i < nc; i++) {
+				double c = B[(seg*nc+i)*3+d];
+				p += c*dpow(i, 0, tau);
+				v += c*dpow(i, 1, tau);
+				acc += c*dpow(i, 2, tau);
+			}
+			out.pos[d] = p;
+			out.vel[d] = v/T[seg];
+			out.acc[d] = acc/(T[seg]*T[seg]);
+		}
+	}
+	return traj;
+}
+
+}  // namespace outdoor_gcs
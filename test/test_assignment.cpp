@@ -0,0 +1,110 @@
+/**
+ * @file /test/test_assignment.cpp
+ *
+ * @brief Goal assignment against brute force over every permutation.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "../include/outdoor_gcs/assignment.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+double total(const std::vector<double> &cost, int n, const std::vector<int> &assign){
+	double sum = 0;
+	for (int r = 0; r < n; r++) { sum += cost[r*n + assign[r]]; }
+	return sum;
+}
+
+double largest(const std::vector<double> &cost, int n, const std::vector<int> &assign){
+	double max = 0;
+	for (int r = 0; r < n; r++) { max = std::max(max, cost[r*n + assign[r]]); }
+	return max;
+}
+
+bool permutation(const std::vector<int> &assign, int n){
+	std::vector<int> sorted = assign;
+	std::sort(sorted.begin(), sorted.end());
+	for (int k = 0; k < n; k++) {
+		if (sorted[k] != k){ return false; }
+	}
+	return int(assign.size()) == n;
+}
+
+std::vector<double> random_cost(std::mt19937 &rng, int n){
+	std::uniform_int_distribution<int> value(0, 20); // small range: many ties
+	std::vector<double> cost(n*n);
+	for (auto &c : cost){ c = value(rng); }
+	return cost;
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(Assignment, Empty){
+	EXPECT_TRUE(Assign_Min_Sum(std::vector<double>(), 0).empty());
+	EXPECT_TRUE(Assign_Min_Max(std::vector<double>(), 0).empty());
+}
+
+TEST(Assignment, SwapsCrossedGoals){
+	// uav 0 sits on goal 1 and uav 1 on goal 0
+	std::vector<double> cost = {10, 0,
+	                            0, 10};
+	EXPECT_EQ(Assign_Min_Sum(cost, 2), std::vector<int>({1, 0}));
+	EXPECT_EQ(Assign_Min_Max(cost, 2), std::vector<int>({1, 0}));
+}
+
+TEST(Assignment, MinSumMatchesBruteForce){
+	std::mt19937 rng(1);
+	for (int trial = 0; trial < 200; trial++) {
+		int n = 1 + trial % 6;
+		std::vector<double> cost = random_cost(rng, n);
+		std::vector<int> perm(n);
+		for (int k = 0; k < n; k++) { perm[k] = k; }
+		double best = total(cost, n, perm);
+		while (std::next_permutation(perm.begin(), perm.end())) {
+			best = std::min(best, total(cost, n, perm));
+		}
+		std::vector<int> assign = Assign_Min_Sum(cost, n);
+		ASSERT_TRUE(permutation(assign, n));
+		EXPECT_DOUBLE_EQ(total(cost, n, assign), best) << "trial " << trial;
+	}
+}
+
+TEST(Assignment, MinMaxMatchesBruteForce){
+	std::mt19937 rng(2);
+	for (int trial = 0; trial < 200; trial++) {
+		int n = 1 + trial % 6;
+		std::vector<double> cost = random_cost(rng, n);
+		std::vector<int> perm(n);
+		for (int k = 0; k < n; k++) { perm[k] = k; }
+		double best_max = largest(cost, n, perm), best_sum = total(cost, n, perm);
+		while (std::next_permutation(perm.begin(), perm.end())) {
+			double m = largest(cost, n, perm), s = total(cost, n, perm);
+			if (m < best_max || (m == best_max && s < best_sum)){
+				best_max = m;
+				best_sum = s;
+			}
+		}
+		std::vector<int> assign = Assign_Min_Max(cost, n);
+		ASSERT_TRUE(permutation(assign, n));
+		EXPECT_DOUBLE_EQ(largest(cost, n, assign), best_max) << "trial " << trial;
+		EXPECT_DOUBLE_EQ(total(cost, n, assign), best_sum) << "trial " << trial; // the tie break
+	}
+}
@@ -0,0 +1,270 @@
+/**
+ * @file /test/test_binlog.cpp
+ *
+ * @brief Entries written with GCS_LOG read back from the file as logged.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/outdoor_gcs/binlog.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+	struct log_format
+	{
+		int level, line;
+		std::string file, format;
+	};
+
+	struct log_value
+	{
+		int tag;
+		int64_t i;
+		uint64_t u;
+		double d;
+		std::string s;
+	};
+
+	struct log_entry
+	{
+		uint16_t id, thread;
+		int64_t time;
+		std::vector<log_value> args;
+	};
+
+	struct log_file
+	{
+		bool ok = false;
+		std::map<uint16_t, log_format> formats;
+		std::vector<log_entry> entries;
+	};
+
+	template <class T>
+	bool read(std::istream &in, T &value){
+		return bool(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+	}
+
+	bool read_text(std::istream &in, std::string &text){
+		uint16_t n;
+		if (!read(in, n)){ return false; }
+		text.resize(n);
+		return n == 0 || bool(in.read(&text[0], n));
+	}
+
+	// The layout of binlog.hpp, strictly: anything left over or unknown fails the read
+	bool parse_args(const std::string &payload, std::vector<log_value> &args){
+		size_t p = 0;
+		while (p < payload.size()) {
+			log_value v = {payload[p++], 0, 0, 0, ""};
+			size_t size = v.tag == Log_String ? 2 : 8;
+			if (p + size > payload.size()){ return false; }
+			if (v.tag == Log_Int){ std::memcpy(&v.i, &payload[p], 8); }
+			else if (v.tag == Log_Uint){ std::memcpy(&v.u, &payload[p], 8); }
+			else if (v.tag == Log_Double){ std::memcpy(&v.d, &payload[p], 8); }
+			else if (v.tag == Log_String){
+				uint16_t n;
+				std::memcpy(&n, &payload[p], 2);
+				if (p + 2 + n > payload.size()){ return false; }
+				v.s = payload.substr(p + 2, n);
+				size += n;
+			} else{
+				return false;
+			}
+			p += size;
+			args.push_back(v);
+		}
+		return true;
+	}
+
+	log_file read_log(const std::string &path){
+		log_file log;
+		std::ifstream in(path.c_str(), std::ios::binary);
+		char magic[sizeof(Log_Magic)];
+		uint32_t version;
+		if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, Log_Magic, sizeof(magic)) != 0 ||
+				!read(in, version) || version != Log_Version){
+			return log;
+		}
+		uint8_t type;
+		while (read(in, type)) {
+			if (type == Log_Format_Record){
+				uint16_t id, line;
+				uint8_t level;
+				log_format f;
+				if (!read(in, id) || !read(in, level) || !read(in, line) || !read_text(in, f.file) || !read_text(in, f.format)){
+					return log;
+				}
+				f.level = level;
+				f.line = line;
+				log.formats[id] = f;
+			} else if (type == Log_Entry_Record){
+				log_entry e;
+				std::string payload;
+				if (!read(in, e.id) || !read(in, e.thread) || !read(in, e.time) || !read_text(in, payload) ||
+						!parse_args(payload, e.args) || !log.formats.count(e.id)){ // formats go ahead of their entries
+					return log;
+				}
+				log.entries.push_back(e);
+			} else{
+				return log;
+			}
+		}
+		log.ok = true;
+		return log;
+	}
+
+	std::string log_path(const std::string &name){
+		return ::testing::TempDir() + name;
+	}
+
+	enum Test_Mode
+	{
+		Mode_Auto,
+		Mode_Manual,
+	};
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(BinLog, NothingWrittenWhenClosed){
+	ASSERT_FALSE(BinLog::Enabled());
+	int evaluated = 0;
+	GCS_LOG(Log_Info, "never %d", ++evaluated);
+	EXPECT_EQ(evaluated, 0); // the arguments are not even evaluated
+}
+
+TEST(BinLog, RoundTrip){
+	std::string path = log_path("binlog_round_trip.blog"), error;
+	ASSERT_TRUE(BinLog::Open(path, error)) << error;
+	EXPECT_FALSE(BinLog::Open(path, error));
+	int64_t before = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	std::string name = "uav 3";
+	int line = __LINE__ + 1;
+	GCS_LOG(Log_Warn, "%s: %d %u %lld %.3f %c %d", name, -42, 7u, -1099511627776LL, 0.125f, 'x', Mode_Manual);
+	GCS_LOG(Log_Debug, "no arguments");
+	GCS_LOG(Log_Error, "%s %llu %f", "literal", uint64_t(-1), -1e300);
+	BinLog::Close();
+	EXPECT_FALSE(BinLog::Enabled());
+
+	log_file log = read_log(path);
+	ASSERT_TRUE(log.ok);
+	ASSERT_EQ(log.entries.size(), 3u);
+	ASSERT_EQ(log.formats.size(), 3u);
+
+	const log_entry &a = log.entries[0];
+	const log_format &fa = log.formats[a.id];
+	EXPECT_EQ(fa.level, Log_Warn);
+	EXPECT_EQ(fa.line, line);
+	EXPECT_EQ(fa.file, "test_binlog.cpp"); // the base name only
+	EXPECT_EQ(fa.format, "%s: %d %u %lld %.3f %c %d");
+	EXPECT_GE(a.time, before);
+	ASSERT_EQ(a.args.size(), 7u);
+	EXPECT_EQ(a.args[0].tag, Log_String);
+	EXPECT_EQ(a.args[0].s, "uav 3");
+	EXPECT_EQ(a.args[1].tag, Log_Int);
+	EXPECT_EQ(a.args[1].i, -42);
+	EXPECT_EQ(a.args[2].tag, Log_Uint);
+	EXPECT_EQ(a.args[2].u, 7u);
+	EXPECT_EQ(a.args[3].i, -1099511627776LL);
+	EXPECT_EQ(a.args[4].tag, Log_Double);
+	EXPECT_EQ(a.args[4].d, 0.125);
+	EXPECT_EQ(a.args[5].tag, Log_Int); // char is integral
+	EXPECT_EQ(a.args[5].i, 'x');
+	EXPECT_EQ(a.args[6].tag, Log_Int);
+	EXPECT_EQ(a.args[6].i, Mode_Manual);
+
+	const log_entry &b = log.entries[1];
+	EXPECT_EQ(log.formats[b.id].level, Log_Debug);
+	EXPECT_TRUE(b.args.empty());
+	EXPECT_GE(b.time, a.time);
+
+	const log_entry &c = log.entries[2];
+	ASSERT_EQ(c.args.size(), 3u);
+	EXPECT_EQ(c.args[0].s, "literal");
+	EXPECT_EQ(c.args[1].u, uint64_t(-1));
+	EXPECT_EQ(c.args[2].d, -1e300);
+	EXPECT_EQ(a.thread, c.thread);
+}
+
+TEST(BinLog, LongStringCut){
+	std::string path = log_path("binlog_long.blog"), error;
+	ASSERT_TRUE(BinLog::Open(path, error)) << error;
+	std::string text(1000, 'a');
+	GCS_LOG(Log_Info, "%d %s %d", 1, text, 2);
+	BinLog::Close();
+
+	log_file log = read_log(path);
+	ASSERT_TRUE(log.ok);
+	ASSERT_EQ(log.entries.size(), 1u);
+	const log_entry &e = log.entries[0];
+	ASSERT_EQ(e.args.size(), 2u); // the argument after a full payload is lost
+	EXPECT_EQ(e.args[0].i, 1);
+	EXPECT_EQ(e.args[1].s, std::string(BinLog::Max_Payload - 9 - 3, 'a'));
+}
+
+TEST(BinLog, ThreadsKeepTheirOrder){
+	// Every thread's entries arrive in order; none is lost but those counted as dropped
+	std::string path = log_path("binlog_threads.blog"), error;
+	uint64_t dropped = BinLog::Dropped();
+	ASSERT_TRUE(BinLog::Open(path, error)) << error;
+	const int Threads = 4, Entries = 2000;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < Threads; t++) {
+		threads.emplace_back([t](){
+			for (int k = 0; k < Entries; k++) {
+				GCS_LOG(Log_Info, "thread %d entry %d", t, k);
+				if (k % 100 == 0){ std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+			}
+		});
+	}
+	for (auto &t : threads){ t.join(); }
+	BinLog::Close();
+	dropped = BinLog::Dropped() - dropped;
+
+	log_file log = read_log(path);
+	ASSERT_TRUE(log.ok);
+	EXPECT_EQ(log.entries.size() + dropped, uint64_t(Threads*Entries));
+	std::map<int64_t, int64_t> last; // per logged thread, its last entry
+	std::map<int64_t, uint16_t> queue; // per logged thread, the queue it wrote to
+	for (const auto &e : log.entries){
+		ASSERT_EQ(e.args.size(), 2u);
+		int64_t t = e.args[0].i, k = e.args[1].i;
+		if (last.count(t)){
+			EXPECT_GT(k, last[t]);
+			EXPECT_EQ(e.thread, queue[t]);
+		}
+		last[t] = k;
+		queue[t] = e.thread;
+	}
+	EXPECT_EQ(last.size(), size_t(Threads));
+}
+
+TEST(BinLog, OpenFails){
+	std::string error;
+	EXPECT_FALSE(BinLog::Open("/nonexistent/dir/x.blog", error));
+	EXPECT_FALSE(error.empty());
+	EXPECT_FALSE(BinLog::Enabled());
+}
@@ -0,0 +1,188 @@
+/**
+ * @file /test/test_cbs_planner.cpp
+ *
+ * @brief Conflict-based search on small occupancy grids.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "../include/outdoor_gcs/cbs_planner.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+// rows[y][x], '#' occupied, one layer
+std::string write_grid(const std::string &name, const std::vector<std::string> &rows){
+	std::string path = ::testing::TempDir() + name;
+	occupancy_header h;
+	std::memcpy(h.magic, "OGCSGRID", 8);
+	h.version = 1;
+	h.nx = rows[0].size();
+	h.ny = rows.size();
+	h.nz = 1;
+	h.resolution = 1.0;
+	h.origin[0] = h.origin[1] = h.origin[2] = 0;
+	std::FILE *f = std::fopen(path.c_str(), "wb");
+	std::fwrite(&h, sizeof(h), 1, f);
+	for (const auto &row : rows){
+		for (char c : row){ std::fputc(c == '#', f); }
+	}
+	std::fclose(f);
+	return path;
+}
+
+grid_cell at(const std::vector<grid_cell> &path, size_t t){
+	return t < path.size() ? path[t] : path.back();
+}
+
+// Every step a face move or a wait on a free cell, no two uavs on one cell or swapping cells
+void expect_valid(const OccupancyGrid &grid, const std::vector<grid_cell> &start, const std::vector<grid_cell> &goal,
+		const std::vector<std::vector<grid_cell> > &paths){
+	ASSERT_EQ(paths.size(), start.size());
+	size_t steps = 0;
+	for (size_t a = 0; a < paths.size(); a++) {
+		ASSERT_FALSE(paths[a].empty());
+		EXPECT_EQ(paths[a].front(), start[a]);
+		EXPECT_EQ(paths[a].back(), goal[a]);
+		steps = std::max(steps, paths[a].size());
+		for (size_t t = 0; t < paths[a].size(); t++) {
+			const grid_cell &c = paths[a][t];
+			EXPECT_FALSE(grid.Blocked(c[0], c[1], c[2])) << "uav " << a << " step " << t;
+			if (t > 0){
+				const grid_cell &p = paths[a][t-1];
+				EXPECT_LE(std::abs(c[0]-p[0]) + std::abs(c[1]-p[1]) + std::abs(c[2]-p[2]), 1) << "uav " << a << " step " << t;
+			}
+		}
+	}
+	for (size_t t = 0; t < steps; t++) {
+		for (size_t a = 0; a < paths.size(); a++) {
+			for (size_t b = a+1; b < paths.size(); b++) {
+				EXPECT_NE(at(paths[a], t), at(paths[b], t)) << "uavs " << a << ", " << b << " meet at step " << t;
+				if (t > 0){
+					EXPECT_FALSE(at(paths[a], t) == at(paths[b], t-1) && at(paths[b], t) == at(paths[a], t-1))
+							<< "uavs " << a << ", " << b << " swap at step " << t;
+				}
+			}
+		}
+	}
+}
+
+bool passes(const std::vector<grid_cell> &path, const grid_cell &cell){
+	for (const auto &c : path){
+		if (c == cell){ return true; }
+	}
+	return false;
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(CbsPlanner, StraightLine){
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("cbs_free.grid", {"......"}), error)) << error;
+	CbsPlanner cbs(grid, 1.0);
+	std::vector<grid_cell> start = {{{0, 0, 0}}}, goal = {{{5, 0, 0}}};
+	std::vector<std::vector<grid_cell> > paths;
+	cbs_stat stat;
+	ASSERT_TRUE(cbs.Plan(start, goal, paths, stat)) << stat.error;
+	EXPECT_TRUE(stat.solved);
+	EXPECT_EQ(paths[0].size(), 6u);
+	EXPECT_EQ(stat.makespan, 5);
+	expect_valid(grid, start, goal, paths);
+}
+
+TEST(CbsPlanner, OneCellGap){
+	// Two uavs trade sides through the single free cell of a wall; one has to wait aside
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("cbs_gap.grid", {"..#..",
+	                                                  ".....",
+	                                                  "..#.."}), error)) << error;
+	CbsPlanner cbs(grid, 1.0);
+	std::vector<grid_cell> start = {{{0, 1, 0}}, {{4, 1, 0}}}, goal = {{{4, 1, 0}}, {{0, 1, 0}}};
+	std::vector<std::vector<grid_cell> > paths;
+	cbs_stat stat;
+	ASSERT_TRUE(cbs.Plan(start, goal, paths, stat)) << stat.error;
+	EXPECT_EQ(stat.agents, 2);
+	expect_valid(grid, start, goal, paths);
+	grid_cell gap = {{2, 1, 0}};
+	EXPECT_TRUE(passes(paths[0], gap));
+	EXPECT_TRUE(passes(paths[1], gap));
+	EXPECT_GT(stat.cost, 8); // longer than two straight runs of 4
+}
+
+TEST(CbsPlanner, OptimalCostWithoutSuboptimality){
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("cbs_open.grid", {".....",
+	                                                   ".....",
+	                                                   "....."}), error)) << error;
+	CbsPlanner cbs(grid, 1.0, 1.0);
+	// Crossing paths: one uav steps around the other for one extra move at most
+	std::vector<grid_cell> start = {{{0, 1, 0}}, {{2, 0, 0}}}, goal = {{{4, 1, 0}}, {{2, 2, 0}}};
+	std::vector<std::vector<grid_cell> > paths;
+	cbs_stat stat;
+	ASSERT_TRUE(cbs.Plan(start, goal, paths, stat)) << stat.error;
+	expect_valid(grid, start, goal, paths);
+	EXPECT_LE(stat.cost, 4 + 2 + 1);
+}
+
+TEST(CbsPlanner, SwapInCorridorFails){
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("cbs_corridor.grid", {"..."}), error)) << error;
+	CbsPlanner cbs(grid, 0.2);
+	std::vector<grid_cell> start = {{{0, 0, 0}}, {{2, 0, 0}}}, goal = {{{2, 0, 0}}, {{0, 0, 0}}};
+	std::vector<std::vector<grid_cell> > paths;
+	cbs_stat stat;
+	EXPECT_FALSE(cbs.Plan(start, goal, paths, stat));
+	EXPECT_FALSE(stat.solved);
+	EXPECT_FALSE(stat.error.empty());
+}
+
+TEST(CbsPlanner, UnreachableGoal){
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("cbs_wall.grid", {"..#..",
+	                                                   "..#..",
+	                                                   "..#.."}), error)) << error;
+	CbsPlanner cbs(grid, 1.0);
+	std::vector<grid_cell> start = {{{0, 0, 0}}, {{0, 2, 0}}}, goal = {{{1, 1, 0}}, {{4, 2, 0}}};
+	std::vector<std::vector<grid_cell> > paths;
+	cbs_stat stat;
+	EXPECT_FALSE(cbs.Plan(start, goal, paths, stat));
+	EXPECT_EQ(stat.agent, 1);
+	EXPECT_EQ(stat.error, "goal unreachable");
+}
+
+TEST(CbsPlanner, BlockedStart){
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("cbs_blocked.grid", {".#."}), error)) << error;
+	CbsPlanner cbs(grid, 1.0);
+	std::vector<grid_cell> start = {{{1, 0, 0}}}, goal = {{{2, 0, 0}}};
+	std::vector<std::vector<grid_cell> > paths;
+	cbs_stat stat;
+	EXPECT_FALSE(cbs.Plan(start, goal, paths, stat));
+	EXPECT_EQ(stat.agent, 0);
+	EXPECT_EQ(stat.error, "start or goal blocked");
+}
@@ -0,0 +1,149 @@
+/**
+ * @file /test/test_clock_sync.cpp
+ *
+ * @brief Offset and drift recovered from simulated vehicle clocks and links.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/outdoor_gcs/clock_sync.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+// Vehicle clock against the GCS one: started at another time and running fast by rate
+struct vehicle_clock
+{
+	double start, rate;
+	double at(double gcs) const { return gcs*(1 + rate) - start; }
+	double offset(double gcs) const { return gcs - at(gcs); }
+};
+
+// One request / response over a link of latency up and down; the vehicle answers after turnaround
+void exchange(ClockSync &sync, int uav, const vehicle_clock &clock, double t0, double up, double down,
+		double turnaround = 0.001){
+	double t1 = clock.at(t0 + up), t2 = clock.at(t0 + up + turnaround);
+	sync.Add_Exchange(uav, t0, t1, t2, t0 + up + turnaround + down);
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(ClockSync, NoSamples){
+	ClockSync sync(2);
+	EXPECT_EQ(sync.Estimate(0).source, Clock_None);
+	EXPECT_EQ(sync.To_GCS(1, 123.25), 123.25);
+}
+
+TEST(ClockSync, SymmetricExchangeIsExact){
+	ClockSync sync(2);
+	vehicle_clock clock = {2.5, 0};
+	exchange(sync, 1, clock, 1000, 0.04, 0.04);
+	clock_estimate e = sync.Estimate(1);
+	EXPECT_EQ(e.source, Clock_Exchange);
+	EXPECT_NEAR(e.offset, 2.5, 1e-9);
+	EXPECT_NEAR(e.delay, 0.08, 1e-9);
+	EXPECT_EQ(e.samples, 1);
+	EXPECT_NEAR(sync.To_GCS(1, clock.at(1010)), 1010, 1e-9);
+	EXPECT_EQ(sync.Estimate(0).source, Clock_None); // the other lanes are untouched
+}
+
+TEST(ClockSync, ShortestRoundTripOfASecondWins){
+	ClockSync sync(1);
+	vehicle_clock clock = {-7, 0};
+	exchange(sync, 0, clock, 1000.1, 0.2, 0.01); // congested uplink, offset off by 95 ms
+	exchange(sync, 0, clock, 1000.5, 0.01, 0.01);
+	exchange(sync, 0, clock, 1000.6, 0.01, 0.3);
+	clock_estimate e = sync.Estimate(0);
+	EXPECT_EQ(e.samples, 1);
+	EXPECT_NEAR(e.delay, 0.02, 1e-9);
+	EXPECT_NEAR(e.offset, -7, 1e-9);
+}
+
+TEST(ClockSync, BogusExchangeIgnored){
+	ClockSync sync(1);
+	sync.Add_Exchange(0, 1000, 5, 6, 1000.5); // longer on the vehicle than the round trip
+	EXPECT_EQ(sync.Estimate(0).source, Clock_None);
+}
+
+TEST(ClockSync, DriftThroughCongestion){
+	// 50 ppm fast, four exchanges a second, most of them delayed on one leg by up to 200 ms
+	ClockSync sync(1);
+	sync.Configure(60);
+	vehicle_clock clock = {30, 50e-6};
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<double> jitter(0, 0.2);
+	std::uniform_int_distribution<int> leg(0, 3);
+	double t = 1000;
+	for (; t < 1040; t += 0.25) {
+		int which = leg(rng);
+		exchange(sync, 0, clock, t, 0.01 + (which == 1 ? jitter(rng) : 0), 0.01 + (which == 2 ? jitter(rng) : 0));
+	}
+	clock_estimate e = sync.Estimate(0);
+	EXPECT_EQ(e.source, Clock_Exchange);
+	EXPECT_NEAR(e.drift, -50e-6, 5e-6);
+	EXPECT_NEAR(e.offset, clock.offset(e.t_ref), 1e-4);
+	for (double g : {t, t + 5.0, t + 30.0}){ // and ahead of the samples
+		EXPECT_NEAR(sync.To_GCS(0, clock.at(g)), g, 5e-4) << "at " << g;
+	}
+}
+
+TEST(ClockSync, PassiveKeepsTheLowestLatency){
+	// Stamps arrive 30 to 130 ms late: the offset carries the 30 ms that are always there
+	ClockSync sync(1);
+	sync.Configure(60);
+	vehicle_clock clock = {-4, 200e-6};
+	std::mt19937 rng(3);
+	std::exponential_distribution<double> latency(1/0.02);
+	for (double t = 1000; t < 1060; t += 0.02) {
+		sync.Add_Passive(0, clock.at(t), t + 0.03 + std::min(latency(rng), 0.1));
+	}
+	clock_estimate e = sync.Estimate(0);
+	EXPECT_EQ(e.source, Clock_Passive);
+	EXPECT_EQ(e.delay, -1);
+	EXPECT_NEAR(e.drift, -200e-6, 20e-6); // the envelope is rougher than round trips
+	EXPECT_NEAR(e.offset - clock.offset(e.t_ref), 0.03, 2e-3);
+}
+
+TEST(ClockSync, PassiveOutOfOrder){
+	ClockSync sync(1);
+	sync.Add_Passive(0, 99.5, 1000.6); // offset bound 901.1
+	sync.Add_Passive(0, 99.4, 1000.45); // earlier, and better
+	clock_estimate e = sync.Estimate(0);
+	EXPECT_EQ(e.samples, 1);
+	EXPECT_NEAR(e.offset, 901.05, 1e-9);
+	EXPECT_DOUBLE_EQ(e.t_ref, 1000.6); // the bin keeps its latest time
+}
+
+TEST(ClockSync, ExchangeOverPassiveUntilQuiet){
+	ClockSync sync(1);
+	sync.Configure(10);
+	vehicle_clock clock = {1, 0};
+	exchange(sync, 0, clock, 1000, 0.01, 0.01);
+	sync.Add_Passive(0, clock.at(1000.5), 1000.55);
+	EXPECT_EQ(sync.Estimate(0).source, Clock_Exchange);
+	double t = 1001.5;
+	for (; t < 1010; t += 1) { // the responder stops, the stream goes on
+		sync.Add_Passive(0, clock.at(t), t + 0.05);
+		EXPECT_EQ(sync.Estimate(0).source, Clock_Exchange) << "at " << t;
+	}
+	sync.Add_Passive(0, clock.at(t), t + 0.05);
+	clock_estimate e = sync.Estimate(0);
+	EXPECT_EQ(e.source, Clock_Passive);
+	EXPECT_LE(e.samples, 11); // no more than the window
+	EXPECT_NEAR(e.offset, 1.05, 1e-9);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file /test/test_command_scheduler.cpp
+ *
+ * @brief Release times of the timer wheel, cancelling and lane isolation.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../include/outdoor_gcs/command_scheduler.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const double Max_Skew = 0.02; // [s] generous for a loaded test machine, the wheel tick is 1 ms
+
+void sleep_for(double seconds){
+	std::this_thread::sleep_for(std::chrono::microseconds(int64_t(seconds*1e6)));
+}
+
+struct release
+{
+	int tag;
+	double at, started;
+};
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(CommandScheduler, ReleasesOnTimeAcrossLevels){
+	// 0.05 s stays on the first level (256 ms), the others cascade down from the second
+	CommandScheduler scheduler(2);
+	std::mutex mutex;
+	std::vector<release> done;
+	double now = CommandScheduler::Wall_Now();
+	double offsets[] = {0.05, 0.2, 0.3, 0.6, 1.1};
+	for (int k = 0; k < 5; k++) {
+		double at = now + offsets[k];
+		scheduler.Schedule(at, k % 2, "cmd", [&mutex, &done, k, at](){
+			std::lock_guard<std::mutex> lock(mutex);
+			done.push_back({k, at, CommandScheduler::Wall_Now()});
+		});
+	}
+	EXPECT_EQ(scheduler.Pending(), 5);
+	sleep_for(1.3);
+	EXPECT_EQ(scheduler.Pending(), 0);
+	std::lock_guard<std::mutex> lock(mutex);
+	ASSERT_EQ(done.size(), 5u);
+	for (size_t k = 0; k < done.size(); k++) {
+		EXPECT_EQ(done[k].tag, int(k)); // in time order
+		EXPECT_GE(done[k].started, done[k].at - 0.001) << "early, command " << k;
+		EXPECT_LT(done[k].started - done[k].at, Max_Skew) << "late, command " << k;
+	}
+	std::vector<sched_record> recent = scheduler.Recent();
+	ASSERT_EQ(recent.size(), 5u);
+	for (const auto &r : recent){
+		EXPECT_LT(std::fabs(r.skew_ms), Max_Skew*1e3);
+	}
+	EXPECT_EQ(scheduler.Skew().Count(), 5u);
+	EXPECT_LT(scheduler.Skew().Max(), Max_Skew);
+}
+
+TEST(CommandScheduler, PastTimeRunsNow){
+	CommandScheduler scheduler(1);
+	std::atomic<double> started{0};
+	double at = CommandScheduler::Wall_Now() - 5;
+	double now = CommandScheduler::Wall_Now();
+	scheduler.Schedule(at, 0, "late", [&started](){ started = CommandScheduler::Wall_Now(); });
+	sleep_for(0.1);
+	ASSERT_GT(started.load(), 0);
+	EXPECT_LT(started.load() - now, Max_Skew);
+}
+
+TEST(CommandScheduler, Cancel){
+	CommandScheduler scheduler(1);
+	std::atomic<int> runs{0};
+	double at = CommandScheduler::Wall_Now() + 0.1;
+	uint64_t a = scheduler.Schedule(at, 0, "a", [&runs](){ runs++; });
+	scheduler.Schedule(at, 0, "b", [&runs](){ runs += 10; });
+	scheduler.Schedule(at + 0.5, 0, "c", [&runs](){ runs += 100; });
+	EXPECT_TRUE(scheduler.Cancel(a));
+	EXPECT_FALSE(scheduler.Cancel(a));
+	EXPECT_EQ(scheduler.Pending(), 2);
+	sleep_for(0.2);
+	EXPECT_EQ(runs.load(), 10);
+	EXPECT_EQ(scheduler.Cancel_All(), 1);
+	sleep_for(0.5);
+	EXPECT_EQ(runs.load(), 10);
+	EXPECT_EQ(scheduler.Pending(), 0);
+}
+
+TEST(CommandScheduler, BlockedLaneDelaysNoOther){
+	// A slow service call on lane 0 must not hold back the release on lane 1
+	CommandScheduler scheduler(2);
+	std::atomic<double> started{0};
+	double now = CommandScheduler::Wall_Now();
+	scheduler.Schedule(now + 0.02, 0, "slow", [](){ sleep_for(0.4); });
+	double at = now + 0.1;
+	scheduler.Schedule(at, 1, "fast", [&started](){ started = CommandScheduler::Wall_Now(); });
+	sleep_for(0.2);
+	ASSERT_GT(started.load(), 0);
+	EXPECT_LT(started.load() - at, Max_Skew);
+	sleep_for(0.3); // let the slow one finish before the lanes are joined
+}
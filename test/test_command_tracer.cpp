@@ -0,0 +1,177 @@
+/**
+ * @file /test/test_command_tracer.cpp
+ *
+ * @brief Matching of echoed Command_IDs: executed, superseded, dropped, out
+ * of order and unmatched commands.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../include/outdoor_gcs/command_tracer.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(CommandTracer, EchoClosesOlderCommands){
+	CommandTracer tracer(2);
+	tracer.Sent(1, 10, 100.0);
+	tracer.Sent(1, 11, 100.05);
+	tracer.Sent(1, 12, 100.1);
+	tracer.Echoed(1, 11, 100.09);
+	trace_stat stat = tracer.Stat(1);
+	EXPECT_EQ(stat.sent, 3u);
+	EXPECT_EQ(stat.executed, 1u);
+	EXPECT_EQ(stat.superseded, 1u); // 10, never echoed
+	EXPECT_NEAR(stat.last_ms, 40, 1e-3);
+	EXPECT_EQ(tracer.Latency(1).Count(), 1u);
+
+	tracer.Echoed(1, 11, 100.2); // logged again while executing it
+	tracer.Echoed(1, 10, 100.2); // behind the last echo
+	stat = tracer.Stat(1);
+	EXPECT_EQ(stat.executed, 1u);
+	EXPECT_EQ(stat.out_of_order, 1u);
+	EXPECT_EQ(stat.unmatched, 0u);
+
+	tracer.Echoed(1, 12, 100.3);
+	stat = tracer.Stat(1);
+	EXPECT_EQ(stat.executed, 2u);
+	EXPECT_NEAR(stat.last_ms, 200, 1e-3);
+	EXPECT_EQ(tracer.Stat(0).sent, 0u); // lanes are separate
+}
+
+TEST(CommandTracer, Unmatched){
+	CommandTracer tracer(1);
+	tracer.Sent(0, 5, 1.0);
+	tracer.Echoed(0, 900, 1.1); // another GCS or a restarted one
+	tracer.Echoed(0, 900, 1.2);
+	tracer.Echoed(0, 900, 1.3);
+	EXPECT_EQ(tracer.Stat(0).unmatched, 1u); // once while it repeats
+	tracer.Echoed(0, 901, 1.4);
+	EXPECT_EQ(tracer.Stat(0).unmatched, 2u);
+	tracer.Echoed(0, 5, 1.5); // still open: matched
+	EXPECT_EQ(tracer.Stat(0).executed, 1u);
+}
+
+TEST(CommandTracer, DroppedAfterTimeout){
+	CommandTracer tracer(2);
+	tracer.Configure(0.5);
+	tracer.Sent(0, 1, 10.0);
+	tracer.Sent(0, 2, 10.3);
+	tracer.Sent(1, 3, 10.1);
+	EXPECT_EQ(tracer.Check(10.45), 0);
+	EXPECT_EQ(tracer.Check(10.55), 1); // uav 0's first
+	EXPECT_EQ(tracer.Check(10.65), 1); // uav 1's
+	EXPECT_EQ(tracer.Stat(0).dropped, 1u);
+	EXPECT_EQ(tracer.Stat(1).dropped, 1u);
+	tracer.Echoed(0, 1, 10.7); // too late, no longer waited on
+	EXPECT_EQ(tracer.Stat(0).unmatched, 1u);
+	tracer.Echoed(0, 2, 10.7);
+	EXPECT_EQ(tracer.Stat(0).executed, 1u);
+	EXPECT_EQ(tracer.Check(100), 0);
+}
+
+TEST(CommandTracer, Window){
+	CommandTracer tracer(1);
+	const uint32_t n = CommandTracer::Window + 88;
+	for (uint32_t id = 1; id <= n; id++) { tracer.Sent(0, id, 1.0); }
+	EXPECT_EQ(tracer.Stat(0).dropped, 88u);
+	tracer.Echoed(0, 88, 1.1); // pushed out of the window
+	EXPECT_EQ(tracer.Stat(0).unmatched, 1u);
+	tracer.Echoed(0, n, 1.1);
+	trace_stat stat = tracer.Stat(0);
+	EXPECT_EQ(stat.executed, 1u);
+	EXPECT_EQ(stat.superseded, CommandTracer::Window - 1);
+}
+
+TEST(CommandTracer, LateSendInsertedInOrder){
+	// The stream thread and the loop draw from one counter: id 6 may be recorded after 7
+	CommandTracer tracer(1);
+	tracer.Sent(0, 5, 1.0);
+	tracer.Sent(0, 7, 1.02);
+	tracer.Sent(0, 6, 1.03);
+	tracer.Echoed(0, 6, 1.1);
+	trace_stat stat = tracer.Stat(0);
+	EXPECT_EQ(stat.executed, 1u);
+	EXPECT_EQ(stat.superseded, 1u); // 5 only, 7 is newer and still open
+	EXPECT_NEAR(stat.last_ms, 70, 1e-3);
+	tracer.Echoed(0, 7, 1.2);
+	stat = tracer.Stat(0);
+	EXPECT_EQ(stat.executed, 2u);
+	EXPECT_EQ(stat.out_of_order, 0u);
+}
+
+TEST(CommandTracer, IdsWrap){
+	CommandTracer tracer(1);
+	tracer.Sent(0, 0xfffffffeu, 1.0);
+	tracer.Sent(0, 0xffffffffu, 1.0);
+	tracer.Sent(0, 0, 1.0);
+	tracer.Sent(0, 1, 1.0);
+	tracer.Echoed(0, 0, 1.1);
+	EXPECT_EQ(tracer.Stat(0).superseded, 2u);
+	tracer.Echoed(0, 0xffffffffu, 1.2); // before 0 across the wrap
+	EXPECT_EQ(tracer.Stat(0).out_of_order, 1u);
+	tracer.Echoed(0, 1, 1.3);
+	EXPECT_EQ(tracer.Stat(0).executed, 2u);
+}
+
+TEST(CommandTracer, StreamAgainstSlowerLog){
+	// 20 Hz commands, the vehicle logs the one it executes at 10 Hz 30 ms later, and goes quiet for 2 s
+	CommandTracer tracer(1);
+	tracer.Configure(1.0);
+	uint32_t id = 0, executing = 0;
+	int dropped = 0;
+	for (int tick = 0; tick < 400; tick++) { // 20 s
+		double t = tick*0.05;
+		tracer.Sent(0, ++id, t);
+		if (tick % 2 == 0){
+			executing = id;
+		} else if (!(t >= 8 && t < 10)){
+			tracer.Echoed(0, executing, t + 0.03);
+		}
+		dropped += tracer.Check(t);
+	}
+	trace_stat stat = tracer.Stat(0);
+	EXPECT_EQ(stat.sent, 400u);
+	EXPECT_EQ(stat.out_of_order, 0u);
+	EXPECT_EQ(stat.unmatched, 0u);
+	EXPECT_NEAR(stat.last_ms, 80, 1e-3); // executing the one before the last
+	EXPECT_NEAR(double(stat.dropped), 20, 2); // the first second of the outage
+	EXPECT_EQ(stat.dropped, uint64_t(dropped));
+	EXPECT_EQ(stat.executed, 200u - 20);
+	dropped += tracer.Check(1e9);
+	stat = tracer.Stat(0);
+	EXPECT_EQ(stat.sent, stat.executed + stat.superseded + stat.dropped); // every command accounted once
+}
+
+TEST(CommandTracer, ConcurrentSenders){
+	CommandTracer tracer(1);
+	std::atomic<uint32_t> ids{1};
+	std::atomic<bool> stop{false};
+	const int Per_Thread = 20000;
+	auto send = [&tracer, &ids](){
+		for (int k = 0; k < Per_Thread; k++) { tracer.Sent(0, ids++, 1.0); }
+	};
+	std::thread echo([&tracer, &ids, &stop](){
+		while (!stop) { tracer.Echoed(0, ids.load() - 1, 1.0); }
+	});
+	std::thread a(send), b(send);
+	a.join();
+	b.join();
+	stop = true;
+	echo.join();
+	tracer.Check(1e9);
+	trace_stat stat = tracer.Stat(0);
+	EXPECT_EQ(stat.sent, 2u*Per_Thread);
+	EXPECT_EQ(stat.sent, stat.executed + stat.superseded + stat.dropped);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file /test/test_distance_field.cpp
+ *
+ * @brief Distance field of random grids against a brute-force EDT.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include "../include/outdoor_gcs/distance_field.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+struct test_grid
+{
+	int nx, ny, nz;
+	float resolution;
+	float origin[3];
+	std::vector<uint8_t> cells; // x fastest, then y, then z
+};
+
+std::string write_grid(const std::string &name, const test_grid &g){
+	std::string path = ::testing::TempDir() + name;
+	occupancy_header h;
+	std::memcpy(h.magic, "OGCSGRID", 8);
+	h.version = 1;
+	h.nx = g.nx;
+	h.ny = g.ny;
+	h.nz = g.nz;
+	h.resolution = g.resolution;
+	std::memcpy(h.origin, g.origin, sizeof(h.origin));
+	std::FILE *f = std::fopen(path.c_str(), "wb");
+	std::fwrite(&h, sizeof(h), 1, f);
+	std::fwrite(g.cells.data(), 1, g.cells.size(), f);
+	std::fclose(f);
+	return path;
+}
+
+// Signed distance of a cell center: to the nearest occupied center outside, to the nearest free one inside
+float brute_force(const test_grid &g, int x, int y, int z){
+	bool occ = g.cells[(z*g.ny + y)*g.nx + x] != 0;
+	float best = 1e30f;
+	for (int k = 0; k < g.nz; k++) {
+		for (int j = 0; j < g.ny; j++) {
+			for (int i = 0; i < g.nx; i++) {
+				if ((g.cells[(k*g.ny + j)*g.nx + i] != 0) == occ){ continue; }
+				best = std::min(best, std::sqrt(float((i-x)*(i-x) + (j-y)*(j-y) + (k-z)*(k-z))));
+			}
+		}
+	}
+	return occ ? -(best - 0.5f)*g.resolution : (best - 0.5f)*g.resolution;
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(DistanceField, MatchesBruteForce){
+	// Sizes off the 8-cell blocks, so partial blocks are read as well
+	test_grid g = {13, 10, 9, 0.5f, {-3.0f, 2.0f, 0.5f}, {}};
+	std::mt19937 rng(3);
+	std::bernoulli_distribution occupied(0.08);
+	g.cells.resize(g.nx*g.ny*g.nz);
+	for (auto &c : g.cells){ c = occupied(rng); }
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("edt_random.grid", g), error)) << error;
+	DistanceField field;
+	ASSERT_TRUE(field.Build(grid));
+	for (int z = 0; z < g.nz; z++) {
+		for (int y = 0; y < g.ny; y++) {
+			for (int x = 0; x < g.nx; x++) {
+				float pos[3] = {g.origin[0] + (x + 0.5f)*g.resolution, g.origin[1] + (y + 0.5f)*g.resolution,
+						g.origin[2] + (z + 0.5f)*g.resolution};
+				float dist, grad[3];
+				ASSERT_TRUE(field.Sample(pos, dist, grad));
+				EXPECT_NEAR(dist, brute_force(g, x, y, z), 1e-4) << x << " " << y << " " << z;
+			}
+		}
+	}
+}
+
+TEST(DistanceField, GradientPointsAway){
+	test_grid g = {9, 9, 9, 1.0f, {0, 0, 0}, std::vector<uint8_t>(9*9*9, 0)};
+	g.cells[(4*9 + 4)*9 + 4] = 1; // one obstacle in the middle
+	OccupancyGrid grid;
+	std::string error;
+	ASSERT_TRUE(grid.Load(write_grid("edt_point.grid", g), error)) << error;
+	DistanceField field;
+	ASSERT_TRUE(field.Build(grid));
+	float dist, grad[3];
+	float east[3] = {7.5f, 4.5f, 4.5f}, below[3] = {4.5f, 4.5f, 1.5f};
+	ASSERT_TRUE(field.Sample(east, dist, grad));
+	EXPECT_NEAR(dist, 2.5f, 1e-5);
+	EXPECT_NEAR(grad[0], 1, 0.02);
+	EXPECT_NEAR(grad[1], 0, 0.02);
+	EXPECT_NEAR(grad[2], 0, 0.02);
+	ASSERT_TRUE(field.Sample(below, dist, grad));
+	EXPECT_NEAR(grad[2], -1, 0.02);
+	float inside[3] = {4.5f, 4.5f, 4.5f};
+	ASSERT_TRUE(field.Sample(inside, dist, grad));
+	EXPECT_NEAR(dist, -0.5f, 1e-5);
+}
+
+TEST(DistanceField, OutsideAndEmpty){
+	test_grid g = {4, 4, 2, 1.0f, {0, 0, 0}, std::vector<uint8_t>(4*4*2, 0)};
+	OccupancyGrid empty;
+	std::string error;
+	ASSERT_TRUE(empty.Load(write_grid("edt_empty.grid", g), error)) << error;
+	DistanceField field;
+	EXPECT_FALSE(field.Build(empty)); // no obstacles, no field
+	EXPECT_FALSE(field.Built());
+
+	g.cells[0] = 1;
+	OccupancyGrid grid;
+	ASSERT_TRUE(grid.Load(write_grid("edt_corner.grid", g), error)) << error;
+	ASSERT_TRUE(field.Build(grid));
+	float dist, grad[3];
+	float outside[3] = {-0.1f, 1, 1}, above[3] = {1, 1, 2.1f};
+	EXPECT_FALSE(field.Sample(outside, dist, grad));
+	EXPECT_FALSE(field.Sample(above, dist, grad));
+}
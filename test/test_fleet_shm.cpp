@@ -0,0 +1,154 @@
+/**
+ * @file /test/test_fleet_shm.cpp
+ *
+ * @brief Seqlock of the fleet segment: a reader never keeps a torn frame.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "../include/outdoor_gcs/fleet_shm.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+std::string shm_name(const std::string &test){
+	return "/outdoor_gcs_test_" + test + "_" + std::to_string(::getpid());
+}
+
+// Every field follows from the tick, so a frame mixing two writes shows
+void fill(fleet_frame &f, uint64_t tick){
+	std::memset(&f, 0, sizeof(f));
+	f.tick = tick;
+	f.stamp = int64_t(tick)*1000;
+	f.count = uint32_t(tick % Fleet_Shm_Capacity) + 1;
+	for (int k = 0; k < Fleet_Shm_Capacity; k++) {
+		f.id[k] = int32_t(tick + k);
+		f.health[k] = uint32_t(tick);
+		f.age[k] = float(tick % 1000);
+		for (int i = 0; i < 3; i++) {
+			f.pos[i][k] = f.vel[i][k] = f.des[i][k] = f.nxt[i][k] = float(tick % 100000);
+		}
+		std::snprintf(f.mode[k], sizeof(f.mode[k]), "M%llu", (unsigned long long)(tick % 1000000));
+	}
+}
+
+bool consistent(const fleet_frame &f){
+	fleet_frame expect;
+	fill(expect, f.tick);
+	return std::memcmp(&f, &expect, sizeof(f)) == 0;
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(FleetShm, WriteRead){
+	std::string name = shm_name("rw"), error;
+	FleetShmWriter writer;
+	ASSERT_TRUE(writer.Open(name, false, error)) << error;
+	FleetShmReader reader;
+	ASSERT_TRUE(reader.Open(name, error)) << error;
+	uint32_t seq = reader.Sequence();
+	fill(writer.Begin(), 7);
+	EXPECT_EQ(reader.Sequence() & 1, 1u);
+	fleet_frame out;
+	EXPECT_FALSE(reader.Read(out, 10)); // busy while the writer holds it
+	writer.End();
+	EXPECT_EQ(reader.Sequence(), seq + 2);
+	ASSERT_TRUE(reader.Read(out));
+	EXPECT_EQ(out.tick, 7u);
+	EXPECT_TRUE(consistent(out));
+}
+
+TEST(FleetShm, ExistingSegment){
+	std::string name = shm_name("exist"), error;
+	FleetShmWriter first;
+	ASSERT_TRUE(first.Open(name, false, error)) << error;
+	fill(first.Begin(), 3);
+	first.End();
+	FleetShmWriter second;
+	EXPECT_FALSE(second.Open(name, false, error));
+	EXPECT_NE(error.find("fleet_shm_reuse"), std::string::npos);
+	FleetShmReader old;
+	ASSERT_TRUE(old.Open(name, error)) << error;
+	ASSERT_TRUE(second.Open(name, true, error)) << error;
+	fill(second.Begin(), 9);
+	second.End();
+	fleet_frame out;
+	ASSERT_TRUE(old.Read(out)); // still mapping the replaced segment
+	EXPECT_EQ(out.tick, 3u);
+	FleetShmReader fresh;
+	ASSERT_TRUE(fresh.Open(name, error)) << error;
+	ASSERT_TRUE(fresh.Read(out));
+	EXPECT_EQ(out.tick, 9u);
+}
+
+TEST(FleetShm, ReaderWithoutWriter){
+	FleetShmReader reader;
+	std::string error;
+	EXPECT_FALSE(reader.Open(shm_name("none"), error));
+	EXPECT_FALSE(error.empty());
+}
+
+TEST(FleetShm, NoTornFrames){
+	// The writer rewrites the frame flat out; every copy a reader keeps must be one whole frame
+	std::string name = shm_name("torn"), error;
+	FleetShmWriter writer;
+	ASSERT_TRUE(writer.Open(name, false, error)) << error;
+	fill(writer.Begin(), 1);
+	writer.End();
+	FleetShmReader reader;
+	ASSERT_TRUE(reader.Open(name, error)) << error;
+
+	const uint64_t Frames = 200000;
+	std::atomic<bool> done{false};
+	std::thread writing([&writer, &done, Frames](){
+		for (uint64_t tick = 2; tick <= Frames; tick++) {
+			fleet_frame &f = writer.Begin();
+			fill(f, tick);
+			if (tick % 64 == 0){
+				// Half written, so that a reader on the same core also finds the frame busy
+				f.id[0] = -1;
+				std::this_thread::yield();
+				f.id[0] = int32_t(tick);
+			}
+			writer.End();
+		}
+		done = true;
+	});
+	uint64_t reads = 0, torn = 0, last = 0, backwards = 0;
+	fleet_frame out;
+	while (!done) {
+		if (!reader.Read(out)){ continue; }
+		reads++;
+		if (!consistent(out)){ torn++; }
+		if (reads % 16 == 0){ std::this_thread::yield(); }
+		if (out.tick < last){ backwards++; }
+		last = out.tick;
+	}
+	writing.join();
+	EXPECT_EQ(torn, 0u);
+	EXPECT_EQ(backwards, 0u);
+	EXPECT_GT(reads, 0u);
+	ASSERT_TRUE(reader.Read(out));
+	EXPECT_EQ(out.tick, Frames);
+	EXPECT_TRUE(consistent(out));
+}
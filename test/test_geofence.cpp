@@ -0,0 +1,318 @@
+/**
+ * @file /test/test_geofence.cpp
+ *
+ * @brief Grid lookups of the geofence against a plain even-odd test of
+ * every polygon, and clamping of commands onto the fence.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include "../include/outdoor_gcs/geofence.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+struct test_polygon
+{
+	bool include;
+	float z_min, z_max;
+	std::vector<float> x, y;
+};
+
+struct test_fence
+{
+	float z_min = -1e9, z_max = 1e9;
+	std::vector<test_polygon> polygons;
+};
+
+std::string write_fence(const std::string &name, const test_fence &fence, bool altitude){
+	std::string path = ::testing::TempDir() + name;
+	std::ofstream out(path.c_str());
+	out << "# " << name << "\n";
+	if (altitude){ out << "altitude " << fence.z_min << " " << fence.z_max << "\n"; }
+	out.precision(9);
+	for (const auto &poly : fence.polygons){
+		out << (poly.include ? "include" : "exclude");
+		if (poly.z_min > -1e9f){ out << " " << poly.z_min << " " << poly.z_max; }
+		out << "\n";
+		for (size_t k = 0; k < poly.x.size(); k++) { out << poly.x[k] << " " << poly.y[k] << "\n"; }
+		out << "end\n";
+	}
+	return path;
+}
+
+// Ray to +x, even-odd: the definition the grid lookup has to agree with
+bool inside_polygon(const test_polygon &poly, float x, float y){
+	bool inside = false;
+	size_t n = poly.x.size();
+	for (size_t k = 0; k < n; k++) {
+		float ax = poly.x[k], ay = poly.y[k], bx = poly.x[(k+1)%n], by = poly.y[(k+1)%n];
+		if ((ay > y) != (by > y) && x < ax + (y - ay)*(bx - ax)/(by - ay)){ inside = !inside; }
+	}
+	return inside;
+}
+
+bool brute_contains(const test_fence &fence, const float p[3]){
+	if (p[2] < fence.z_min || p[2] > fence.z_max){ return false; }
+	bool any_include = false, included = false;
+	for (const auto &poly : fence.polygons){
+		any_include = any_include || poly.include;
+		if (p[2] < poly.z_min || p[2] > poly.z_max || !inside_polygon(poly, p[0], p[1])){ continue; }
+		if (!poly.include){ return false; }
+		included = true;
+	}
+	return included || !any_include;
+}
+
+// Distance in the plane to the nearest polygon edge; closer points are left out of the comparison
+float edge_distance(const test_fence &fence, float x, float y){
+	float best = 1e30f;
+	for (const auto &poly : fence.polygons){
+		size_t n = poly.x.size();
+		for (size_t k = 0; k < n; k++) {
+			float ax = poly.x[k], ay = poly.y[k], bx = poly.x[(k+1)%n], by = poly.y[(k+1)%n];
+			float dx = bx - ax, dy = by - ay, l2 = dx*dx + dy*dy;
+			float t = l2 > 0 ? std::min(std::max(((x - ax)*dx + (y - ay)*dy)/l2, 0.0f), 1.0f) : 0;
+			best = std::min(best, std::hypot(x - ax - t*dx, y - ay - t*dy));
+		}
+	}
+	return best;
+}
+
+test_polygon make_polygon(bool include, std::vector<float> xy, float z_min = -1e9f, float z_max = 1e9f){
+	test_polygon poly = {include, z_min, z_max, {}, {}};
+	for (size_t k = 0; k + 1 < xy.size(); k += 2) {
+		poly.x.push_back(xy[k]);
+		poly.y.push_back(xy[k+1]);
+	}
+	return poly;
+}
+
+// A field with a concave boundary, a no-fly square up to 30 m, a round no-fly zone and a second field
+test_fence field(){
+	test_fence fence;
+	fence.z_min = 0;
+	fence.z_max = 120;
+	fence.polygons.push_back(make_polygon(true, {0, 0, 100, 0, 100, 40, 60, 40, 60, 100, 0, 100}));
+	fence.polygons.push_back(make_polygon(false, {10, 60, 30, 60, 30, 80, 10, 80}, 0, 30));
+	test_polygon round = {false, -1e9f, 1e9f, {}, {}};
+	for (int k = 0; k < 200; k++) {
+		round.x.push_back(30 + 12*std::cos(2*M_PI*k/200));
+		round.y.push_back(25 + 12*std::sin(2*M_PI*k/200));
+	}
+	fence.polygons.push_back(round);
+	fence.polygons.push_back(make_polygon(true, {200, -20, 260, 10, 230, 90}, 10, 60));
+	return fence;
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(Geofence, MatchesEvenOdd){
+	test_fence fence = field();
+	Geofence geofence;
+	std::string error;
+	ASSERT_TRUE(geofence.Load(write_fence("fence_field.txt", fence, true), error)) << error;
+	EXPECT_EQ(geofence.Polygons(), 4);
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<float> x(-50, 300), y(-50, 150), z(-10, 130);
+	int compared = 0, inside = 0;
+	for (int k = 0; k < 200000; k++) {
+		float p[3] = {x(rng), y(rng), z(rng)};
+		if (edge_distance(fence, p[0], p[1]) < 1e-3f){ continue; }
+		bool expect = brute_contains(fence, p);
+		ASSERT_EQ(geofence.Contains(p), expect) << p[0] << " " << p[1] << " " << p[2];
+		compared++;
+		inside += expect;
+	}
+	EXPECT_GT(compared, 199000);
+	EXPECT_GT(inside, 20000);
+}
+
+TEST(Geofence, CellEdges){
+	// Queries exactly on the grid lines and corners, laid out as build_grid does
+	test_fence fence = field();
+	Geofence geofence;
+	std::string error;
+	ASSERT_TRUE(geofence.Load(write_fence("fence_cells.txt", fence, true), error)) << error;
+	float x0 = -20.6f, x1 = 280, y0 = -20, y1 = 100; // beyond the bounding box of the vertices
+	int compared = 0;
+	for (float gx : {16.0f, 32.0f, 48.0f, 59.0f, 64.0f, 128.0f, 256.0f}){
+		for (int i = 0; i <= gx; i++) {
+			for (int j = 0; j <= gx; j++) {
+				float p[3] = {x0 + i*(x1 - x0)/gx, y0 + j*(y1 - y0)/gx, 20};
+				if (edge_distance(fence, p[0], p[1]) < 1e-3f){ continue; }
+				ASSERT_EQ(geofence.Contains(p), brute_contains(fence, p)) << p[0] << " " << p[1];
+				compared++;
+			}
+		}
+	}
+	// and on the cell lines of the grid itself: the box grown by 1 %, near 4 cells per edge
+	float bx0 = -20, bx1 = 260, by0 = -20, by1 = 100;
+	float w = (bx1 - bx0)*1.02f, h = (by1 - by0)*1.02f, cx0 = bx0 - 0.01f*(bx1 - bx0), cy0 = by0 - 0.01f*(by1 - by0);
+	int edges = 6 + 4 + 200 + 3;
+	int gx = std::lround(std::sqrt(4.0f*edges*w/h)), gy = std::lround(4.0f*edges/gx);
+	for (int i = 0; i <= gx; i++) {
+		for (int j = 0; j <= gy; j++) {
+			for (float dz : {5.0f, 40.0f}){
+				float p[3] = {cx0 + i*(w/gx), cy0 + j*(h/gy), dz};
+				if (edge_distance(fence, p[0], p[1]) < 1e-3f){ continue; }
+				ASSERT_EQ(geofence.Contains(p), brute_contains(fence, p)) << p[0] << " " << p[1] << " " << p[2];
+				compared++;
+			}
+		}
+	}
+	EXPECT_GT(compared, 80000);
+}
+
+TEST(Geofence, AltitudeBands){
+	test_fence fence = field();
+	Geofence geofence;
+	std::string error;
+	ASSERT_TRUE(geofence.Load(write_fence("fence_bands.txt", fence, true), error)) << error;
+	float low[3] = {20, 70, 20}, high[3] = {20, 70, 50}; // over the no-fly square, which ends at 30 m
+	EXPECT_FALSE(geofence.Contains(low));
+	EXPECT_TRUE(geofence.Contains(high));
+	float round_high[3] = {30, 25, 100}; // the round zone has no band
+	EXPECT_FALSE(geofence.Contains(round_high));
+	float field2_low[3] = {230, 30, 5}, field2[3] = {230, 30, 30}, field2_high[3] = {230, 30, 70};
+	EXPECT_FALSE(geofence.Contains(field2_low));
+	EXPECT_TRUE(geofence.Contains(field2));
+	EXPECT_FALSE(geofence.Contains(field2_high));
+	float ceiling[3] = {80, 20, 121}, floor[3] = {80, 20, -0.5f}, top[3] = {80, 20, 120};
+	EXPECT_FALSE(geofence.Contains(ceiling));
+	EXPECT_FALSE(geofence.Contains(floor));
+	EXPECT_TRUE(geofence.Contains(top)); // the band is closed
+}
+
+TEST(Geofence, OutsideTheGrid){
+	Geofence geofence;
+	std::string error;
+	test_fence fence = field();
+	ASSERT_TRUE(geofence.Load(write_fence("fence_grid.txt", fence, true), error)) << error;
+	float far[3] = {-1000, 5000, 20};
+	EXPECT_FALSE(geofence.Contains(far)); // beyond every inclusion polygon
+
+	test_fence no_fly; // only exclusions: everything else is allowed
+	no_fly.polygons.push_back(make_polygon(false, {0, 0, 10, 0, 10, 10, 0, 10}));
+	ASSERT_TRUE(geofence.Load(write_fence("fence_no_fly.txt", no_fly, false), error)) << error;
+	EXPECT_TRUE(geofence.Contains(far));
+	float in[3] = {5, 5, 1e6f}, beside[3] = {10.5f, 5, 0};
+	EXPECT_FALSE(geofence.Contains(in));
+	EXPECT_TRUE(geofence.Contains(beside));
+}
+
+TEST(Geofence, Clamp){
+	test_fence fence = field();
+	Geofence geofence;
+	std::string error;
+	ASSERT_TRUE(geofence.Load(write_fence("fence_clamp.txt", fence, true), error)) << error;
+	std::mt19937 rng(9);
+	std::uniform_real_distribution<float> x(-50, 300), y(-50, 150), z(-10, 130);
+	int clamped = 0;
+	for (int k = 0; k < 20000; k++) {
+		float from[3] = {x(rng), y(rng), z(rng)}, target[3] = {x(rng), y(rng), z(rng)}, original[3];
+		std::copy(target, target + 3, original);
+		bool from_inside = geofence.Contains(from), target_inside = geofence.Contains(target);
+		Fence_Result result = geofence.Check(from, target, true);
+		if (target_inside){
+			EXPECT_EQ(result, Fence_Inside);
+			EXPECT_TRUE(std::equal(target, target + 3, original));
+			continue;
+		}
+		if (!from_inside){
+			EXPECT_EQ(result, Fence_Rejected);
+			continue;
+		}
+		ASSERT_EQ(result, Fence_Clamped);
+		clamped++;
+		EXPECT_TRUE(geofence.Contains(target)) << "clamped onto " << target[0] << " " << target[1] << " " << target[2];
+		// On the segment, and no more than a centimetre (plus a step) short of where it first leaves the fence
+		float len = 0, along = 0;
+		for (int i = 0; i < 3; i++) {
+			len += (original[i] - from[i])*(original[i] - from[i]);
+			along += (target[i] - from[i])*(original[i] - from[i]);
+		}
+		len = std::sqrt(len);
+		along /= len;
+		float exit = len;
+		for (float s = 0; s <= len; s += 0.005f) {
+			float p[3];
+			for (int i = 0; i < 3; i++) { p[i] = from[i] + s/len*(original[i] - from[i]); }
+			if (!geofence.Contains(p)){
+				exit = s;
+				break;
+			}
+		}
+		EXPECT_LE(along, exit + 0.005f);
+		EXPECT_GE(along, exit - std::max(0.02f, len*std::pow(2.0f, -20.0f)) - 0.005f);
+	}
+	EXPECT_GT(clamped, 1000);
+}
+
+TEST(Geofence, Reject){
+	test_fence fence = field();
+	Geofence geofence;
+	std::string error;
+	ASSERT_TRUE(geofence.Load(write_fence("fence_reject.txt", fence, true), error)) << error;
+	float from[3] = {80, 20, 10}, target[3] = {150, 20, 10};
+	float outside[3] = {-30, 20, 10};
+	ASSERT_TRUE(geofence.Contains(from));
+	float kept[3] = {150, 20, 10};
+	EXPECT_EQ(geofence.Check(from, kept, false), Fence_Rejected); // no clamp asked
+	EXPECT_EQ(kept[0], 150);
+	EXPECT_EQ(geofence.Check(outside, target, true), Fence_Rejected); // from outside: nothing to pull back to
+	EXPECT_EQ(target[0], 150);
+	float same[3] = {150, 20, 10};
+	float at[3] = {150, 20, 10};
+	EXPECT_EQ(geofence.Check(at, same, true), Fence_Rejected);
+
+	Geofence none; // not loaded: everything passes
+	EXPECT_EQ(none.Check(outside, target, true), Fence_Inside);
+}
+
+TEST(Geofence, LoadErrors){
+	Geofence geofence;
+	std::string error;
+	std::string path = ::testing::TempDir() + "fence_bad.txt";
+	const char *bad[] = {
+		"include\n0 0\n1 0\nend\n", // two vertices
+		"include\n0 0\n1 0\n1 1\n", // no end
+		"include\n0 0\ninclude\n", // nested
+		"altitude 10 5\n",
+		"0 0\n", // vertex outside a polygon
+		"include\n0 0\n1 x\n1 1\nend\n",
+	};
+	for (const char *text : bad){
+		std::ofstream(path.c_str()) << text;
+		EXPECT_FALSE(geofence.Load(path, error)) << text;
+		EXPECT_FALSE(error.empty());
+		EXPECT_FALSE(geofence.Loaded());
+	}
+	std::ostringstream many;
+	for (int k = 0; k <= Geofence::Max_Polygons; k++) {
+		many << "exclude\n" << 2*k << " 0\n" << 2*k+1 << " 0\n" << 2*k << " 1\nend\n";
+	}
+	std::ofstream(path.c_str()) << many.str();
+	EXPECT_FALSE(geofence.Load(path, error));
+	EXPECT_NE(error.find("more than"), std::string::npos);
+	EXPECT_FALSE(geofence.Load(::testing::TempDir() + "fence_none.txt", error));
+}
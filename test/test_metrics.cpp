@@ -0,0 +1,276 @@
+/**
+ * @file /test/test_metrics.cpp
+ *
+ * @brief Prometheus text, the scrape endpoint, and snapshot files as
+ * written by the registry and read back by metrics_dump.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <netinet/in.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "../include/outdoor_gcs/metrics.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+std::vector<std::string> lines_of(const std::string &text){
+	std::vector<std::string> lines;
+	std::istringstream in(text);
+	std::string line;
+	while (std::getline(in, line)) { lines.push_back(line); }
+	return lines;
+}
+
+bool has_line(const std::string &text, const std::string &line){
+	std::vector<std::string> lines = lines_of(text);
+	return std::find(lines.begin(), lines.end(), line) != lines.end();
+}
+
+// The whole answer to one request on 127.0.0.1:port, empty if it could not connect
+std::string http_get(int port, const std::string &path){
+	int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+	sockaddr_in addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	std::string answer;
+	if (::connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0){
+		std::string request = "GET " + path + " HTTP/1.0\r\nHost: localhost\r\n\r\n";
+		if (::send(fd, request.data(), request.size(), 0) == ssize_t(request.size())){
+			char buf[4096];
+			ssize_t n;
+			while ((n = ::recv(fd, buf, sizeof(buf), 0)) > 0) { answer.append(buf, n); }
+		}
+	}
+	::close(fd);
+	return answer;
+}
+
+#ifdef METRICS_DUMP
+// Output of a metrics_dump run
+std::string run(const std::string &command){
+	std::string out;
+	std::FILE *pipe = ::popen(command.c_str(), "r");
+	if (!pipe){ return out; }
+	char buf[512];
+	size_t n;
+	while ((n = std::fread(buf, 1, sizeof(buf), pipe)) > 0) { out.append(buf, n); }
+	::pclose(pipe);
+	return out;
+}
+#endif
+
+template <class T>
+bool read(std::istream &in, T &value){
+	return bool(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(Metrics, Text){
+	MetricsRegistry registry;
+	MetricCounter *odom1 = registry.Counter("gcs_odom_total", "uav=\"1\"", "Odometry messages");
+	MetricCounter *odom2 = registry.Counter("gcs_odom_total", "uav=\"2\"", "ignored, the first help stays");
+	MetricGauge *loop = registry.Gauge("gcs_loop_hz", "", "Loop rate");
+	MetricGauge *unknown = registry.Gauge("gcs_offset_seconds", "uav=\"1\"", "Clock offset");
+	LatencyHistogram *plan = registry.Histogram("gcs_plan_seconds", "planner=\"flock\"", "Plan time");
+	LatencyHistogram external;
+	registry.Histogram("gcs_cbs_seconds", "", "CBS time", &external);
+	EXPECT_EQ(registry.Series(), 6);
+
+	odom1->Add(3);
+	odom1->Add();
+	odom2->Set(10);
+	loop->Set(3.75);
+	unknown->Set(NAN);
+	double samples[] = {0.0015, 0.003, 10};
+	for (double s : samples){ plan->Add(s); }
+	external.Add(0.002);
+
+	std::string text = registry.Text();
+	std::vector<std::string> lines = lines_of(text);
+	EXPECT_EQ(lines[0], "# HELP gcs_odom_total Odometry messages");
+	EXPECT_EQ(lines[1], "# TYPE gcs_odom_total counter");
+	EXPECT_EQ(lines[2], "gcs_odom_total{uav=\"1\"} 4");
+	EXPECT_EQ(lines[3], "gcs_odom_total{uav=\"2\"} 10"); // series of a name stay under one HELP
+	EXPECT_EQ(lines[4], "# HELP gcs_loop_hz Loop rate");
+	EXPECT_EQ(lines[5], "# TYPE gcs_loop_hz gauge");
+	EXPECT_EQ(lines[6], "gcs_loop_hz 3.75");
+	EXPECT_TRUE(has_line(text, "gcs_offset_seconds{uav=\"1\"} NaN"));
+	EXPECT_TRUE(has_line(text, "# TYPE gcs_plan_seconds histogram"));
+	EXPECT_TRUE(has_line(text, "gcs_plan_seconds_bucket{planner=\"flock\",le=\"+Inf\"} 3"));
+	EXPECT_TRUE(has_line(text, "gcs_plan_seconds_count{planner=\"flock\"} 3"));
+	EXPECT_TRUE(has_line(text, "gcs_plan_seconds_sum{planner=\"flock\"} 10.0045"));
+	EXPECT_TRUE(has_line(text, "gcs_cbs_seconds_bucket{le=\"+Inf\"} 1"));
+	EXPECT_TRUE(has_line(text, "gcs_cbs_seconds_count 1"));
+
+	// Cumulative buckets: each le holds the samples at or below it
+	const std::string prefix = "gcs_plan_seconds_bucket{planner=\"flock\",le=\"";
+	int buckets = 0;
+	for (const auto &line : lines){
+		if (line.compare(0, prefix.size(), prefix) != 0 || line.find("+Inf") != std::string::npos){ continue; }
+		size_t end = line.find('"', prefix.size());
+		double le = std::atof(line.substr(prefix.size(), end - prefix.size()).c_str());
+		uint64_t below = 0;
+		for (double s : samples){ below += s <= le; }
+		EXPECT_EQ(line.substr(end + 3), std::to_string(below)) << line;
+		buckets++;
+	}
+	EXPECT_EQ(buckets, 22); // octaves from 32 us to 67 s
+}
+
+TEST(Metrics, Endpoint){
+	MetricsRegistry registry;
+	MetricCounter *ticks = registry.Counter("gcs_ticks_total", "", "Loop ticks");
+	ticks->Add(5);
+	std::string error;
+	int port = 0;
+	for (int p = 39000 + ::getpid() % 1000; !port && p < 41000; p += 97) { // a free one
+		if (registry.Open(p, "", 1, error)){ port = p; }
+	}
+	ASSERT_NE(port, 0) << error;
+	EXPECT_TRUE(registry.Opened());
+	EXPECT_FALSE(registry.Open(port, "", 1, error));
+
+	std::string answer = http_get(port, "/metrics");
+	EXPECT_EQ(answer.compare(0, 15, "HTTP/1.0 200 OK"), 0) << answer;
+	size_t body = answer.find("\r\n\r\n");
+	ASSERT_NE(body, std::string::npos);
+	EXPECT_EQ(answer.substr(body + 4), registry.Text());
+	EXPECT_NE(answer.find("Content-Length: " + std::to_string(registry.Text().size()) + "\r\n"), std::string::npos);
+	ticks->Add();
+	answer = http_get(port, "/");
+	EXPECT_TRUE(has_line(answer.substr(answer.find("\r\n\r\n") + 4), "gcs_ticks_total 6"));
+	EXPECT_EQ(http_get(port, "/other").compare(0, 22, "HTTP/1.0 404 Not Found"), 0);
+}
+
+TEST(Metrics, OpenFails){
+	MetricsRegistry registry;
+	registry.Counter("gcs_ticks_total", "", "Loop ticks");
+	std::string error;
+	EXPECT_FALSE(registry.Open(0, "/nonexistent/dir/run.metrics", 1, error));
+	EXPECT_FALSE(error.empty());
+	EXPECT_FALSE(registry.Opened());
+	EXPECT_TRUE(registry.Open(0, "", 1, error)); // nothing to serve, nothing started
+	EXPECT_FALSE(registry.Opened());
+}
+
+TEST(Metrics, Snapshots){
+	std::string path = ::testing::TempDir() + "metrics_snapshots.metrics", error;
+	{
+		MetricsRegistry registry;
+		MetricCounter *ticks = registry.Counter("gcs_ticks_total", "", "Loop ticks");
+		MetricGauge *loop = registry.Gauge("gcs_loop_hz", "", "Loop rate");
+		LatencyHistogram *plan = registry.Histogram("gcs_plan_seconds", "planner=\"flock\"", "Plan time");
+		ASSERT_TRUE(registry.Open(0, path, 0.05, error)) << error;
+		for (int k = 0; k < 10; k++) {
+			ticks->Add();
+			loop->Set(k);
+			plan->Add(0.001*(k+1));
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+	} // the last record at the end of the run
+
+	std::ifstream in(path.c_str(), std::ios::binary);
+	char magic[sizeof(Metrics_Magic)];
+	uint32_t version, n;
+	ASSERT_TRUE(in.read(magic, sizeof(magic)) && read(in, version) && read(in, n));
+	EXPECT_EQ(std::memcmp(magic, Metrics_Magic, sizeof(magic)), 0);
+	EXPECT_EQ(version, Metrics_Version);
+	ASSERT_EQ(n, 3u);
+	const char *names[] = {"gcs_ticks_total", "gcs_loop_hz", "gcs_plan_seconds{planner=\"flock\"}"};
+	const uint8_t types[] = {Metric_Counter, Metric_Gauge, Metric_Histogram};
+	for (uint32_t k = 0; k < n; k++) {
+		uint8_t type;
+		uint16_t length;
+		ASSERT_TRUE(read(in, type) && read(in, length));
+		std::string name(length, ' ');
+		ASSERT_TRUE(in.read(&name[0], length));
+		EXPECT_EQ(type, types[k]);
+		EXPECT_EQ(name, names[k]);
+	}
+	int records = 0;
+	double t, last_t = 0;
+	uint64_t ticks = 0, count = 0;
+	double loop = 0, sum = 0, p50 = 0, p99 = 0, max = 0;
+	while (read(in, t)) {
+		ASSERT_TRUE(read(in, ticks) && read(in, loop) && read(in, count) && read(in, sum) && read(in, p50) &&
+				read(in, p99) && read(in, max)); // whole records only
+		EXPECT_GE(t, last_t);
+		last_t = t;
+		records++;
+	}
+	EXPECT_GE(records, 3);
+	EXPECT_EQ(ticks, 10u);
+	EXPECT_EQ(loop, 9);
+	EXPECT_EQ(count, 10u);
+	EXPECT_NEAR(sum, 0.055, 1e-9);
+	EXPECT_NEAR(max, 0.010, 1e-9);
+	EXPECT_LE(p50, p99);
+	EXPECT_LE(p99, max);
+	EXPECT_GE(p50, 0.005);
+}
+
+#ifdef METRICS_DUMP
+TEST(Metrics, Dump){
+	std::string path = ::testing::TempDir() + "metrics_dump.metrics", other = ::testing::TempDir() + "metrics_dump_base.metrics";
+	std::string error;
+	for (const std::string &file : {path, other}){
+		MetricsRegistry registry;
+		MetricCounter *ticks = registry.Counter("gcs_ticks_total", "", "Loop ticks");
+		MetricGauge *loop = registry.Gauge("gcs_loop_hz", "", "Loop rate");
+		LatencyHistogram *plan = registry.Histogram("gcs_plan_seconds", "planner=\"flock\"", "Plan time");
+		ASSERT_TRUE(registry.Open(0, file, 10, error)) << error;
+		ticks->Add(file == path ? 7 : 3);
+		loop->Set(file == path ? 4 : 2.5);
+		plan->Add(0.002);
+		plan->Add(0.004);
+	}
+	std::string dump = METRICS_DUMP;
+	std::vector<std::string> lines = lines_of(run(dump + " " + path + " --last"));
+	ASSERT_EQ(lines.size(), 4u);
+	EXPECT_EQ(lines[0].compare(0, 2, "@ "), 0);
+	EXPECT_EQ(lines[1], "gcs_ticks_total 7");
+	EXPECT_EQ(lines[2], "gcs_loop_hz 4");
+	EXPECT_EQ(lines[3], "gcs_plan_seconds{planner=\"flock\"} n 2 mean 3.000 p50 2.048 p99 4.000 max 4.000 ms");
+
+	lines = lines_of(run(dump + " " + path + " --grep loop"));
+	ASSERT_EQ(lines.size(), 2u);
+	EXPECT_EQ(lines[1], "gcs_loop_hz 4");
+
+	lines = lines_of(run(dump + " " + path + " --compare " + other + " --grep loop"));
+	ASSERT_EQ(lines.size(), 2u);
+	EXPECT_EQ(lines[1], "gcs_loop_hz 4 | 2.5");
+
+	EXPECT_NE(std::system((dump + " /nonexistent.metrics 2>/dev/null").c_str()), 0);
+}
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file /test/test_separation_monitor.cpp
+ *
+ * @brief Alerts of the sweep-and-prune monitor against every pair checked.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include "../include/outdoor_gcs/separation_monitor.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+typedef std::vector<std::array<float,3> > vectors;
+
+// Every pair, CPA of the relative motion clamped to [0, horizon]
+void brute_force(float threshold, float horizon, const std::vector<int> &ids, const vectors &pos, const vectors &vel,
+		std::map<std::pair<int,int>, separation_alert> &alerts, float &min_dist, float &min_cpa){
+	alerts.clear();
+	min_dist = min_cpa = -1;
+	for (size_t a = 0; a < ids.size(); a++) {
+		for (size_t b = a+1; b < ids.size(); b++) {
+			float pv = 0, vv = 0, pp = 0;
+			for (int i = 0; i < 3; i++) {
+				float p = pos[b][i] - pos[a][i], v = vel[b][i] - vel[a][i];
+				pv += p*v;
+				vv += v*v;
+				pp += p*p;
+			}
+			float t = vv > 0 ? std::min(std::max(-pv/vv, 0.0f), horizon) : 0;
+			float cpa2 = 0;
+			for (int i = 0; i < 3; i++) {
+				float d = pos[b][i] - pos[a][i] + (vel[b][i] - vel[a][i])*t;
+				cpa2 += d*d;
+			}
+			float dist = std::sqrt(pp), cpa = std::sqrt(cpa2);
+			if (dist < threshold && (min_dist < 0 || dist < min_dist)){ min_dist = dist; }
+			if (cpa < threshold && (min_cpa < 0 || cpa < min_cpa)){ min_cpa = cpa; }
+			if (cpa < threshold){
+				separation_alert alert = {std::min(ids[a], ids[b]), std::max(ids[a], ids[b]), dist, t, cpa};
+				alerts[{alert.a, alert.b}] = alert;
+			}
+		}
+	}
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(SeparationMonitor, HeadOn){
+	SeparationMonitor monitor(2.0, 5.0);
+	std::vector<int> ids = {4, 1};
+	vectors pos = {{{0, 0, 10}}, {{20, 1, 10}}};
+	vectors vel = {{{2, 0, 0}}, {{-2, 0, 0}}};
+	std::vector<separation_alert> alerts;
+	separation_stat stat;
+	monitor.Check(ids, pos, vel, alerts, stat);
+	ASSERT_EQ(alerts.size(), 1u);
+	EXPECT_EQ(alerts[0].a, 1);
+	EXPECT_EQ(alerts[0].b, 4);
+	EXPECT_NEAR(alerts[0].t_cpa, 5, 1e-5);
+	EXPECT_NEAR(alerts[0].d_cpa, 1, 1e-5);
+	EXPECT_NEAR(alerts[0].dist, std::sqrt(401.0f), 1e-4);
+	EXPECT_EQ(stat.min_dist, -1); // 20 m apart now
+	EXPECT_NEAR(stat.min_cpa, 1, 1e-5);
+
+	vel[1][0] = -1.5f; // meets after the horizon
+	monitor.Check(ids, pos, vel, alerts, stat);
+	EXPECT_TRUE(alerts.empty());
+	EXPECT_EQ(stat.min_cpa, -1);
+}
+
+TEST(SeparationMonitor, Separating){
+	SeparationMonitor monitor(2.0, 5.0);
+	std::vector<separation_alert> alerts;
+	separation_stat stat;
+	monitor.Check({0, 1}, {{{0, 0, 0}}, {{1.5f, 0, 0}}}, {{{-1, 0, 0}}, {{1, 0, 0}}}, alerts, stat);
+	ASSERT_EQ(alerts.size(), 1u); // too close already
+	EXPECT_EQ(alerts[0].t_cpa, 0);
+	EXPECT_NEAR(alerts[0].d_cpa, 1.5f, 1e-6);
+	EXPECT_NEAR(stat.min_dist, 1.5f, 1e-6);
+}
+
+TEST(SeparationMonitor, RandomFleetsMatchAllPairs){
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> unit(-1, 1);
+	SeparationMonitor monitor;
+	std::vector<separation_alert> alerts;
+	separation_stat stat;
+	int compared = 0, quiet = 0;
+	for (int trial = 0; trial < 400; trial++) {
+		int n = 2 + trial % 60;
+		float spread = trial % 3 == 0 ? 10 : trial % 3 == 1 ? 50 : 300; // dense to spread out
+		float threshold = 1 + trial % 4, horizon = 1 + trial % 7;
+		monitor.Configure(threshold, horizon);
+		std::vector<int> ids(n);
+		vectors pos(n), vel(n);
+		for (int k = 0; k < n; k++) {
+			ids[k] = 3*k + 1; // not the indices
+			for (int i = 0; i < 3; i++) {
+				pos[k][i] = spread*unit(rng);
+				vel[k][i] = (i == 2 ? 1 : 5)*unit(rng);
+			}
+		}
+		monitor.Check(ids, pos, vel, alerts, stat);
+		std::map<std::pair<int,int>, separation_alert> expect;
+		float min_dist, min_cpa;
+		brute_force(threshold, horizon, ids, pos, vel, expect, min_dist, min_cpa);
+
+		EXPECT_EQ(stat.num, n);
+		EXPECT_LE(stat.candidates, n*(n-1)/2);
+		EXPECT_EQ(stat.alerts, int(alerts.size()));
+		ASSERT_EQ(alerts.size(), expect.size()) << "trial " << trial;
+		for (size_t k = 0; k < alerts.size(); k++) {
+			const separation_alert &got = alerts[k];
+			ASSERT_EQ(expect.count({got.a, got.b}), 1u) << "trial " << trial << " pair " << got.a << "-" << got.b;
+			const separation_alert &want = expect[{got.a, got.b}];
+			EXPECT_NEAR(got.dist, want.dist, 1e-4);
+			EXPECT_NEAR(got.t_cpa, want.t_cpa, 1e-4);
+			EXPECT_NEAR(got.d_cpa, want.d_cpa, 1e-4);
+			if (k > 0){ EXPECT_LE(alerts[k-1].d_cpa, got.d_cpa); } // closest first
+		}
+		EXPECT_NEAR(stat.min_dist, min_dist, 1e-4) << "trial " << trial;
+		EXPECT_NEAR(stat.min_cpa, min_cpa, 1e-4) << "trial " << trial;
+		compared += alerts.size();
+		quiet += alerts.empty();
+	}
+	EXPECT_GT(compared, 100); // both kinds of fleet were drawn
+	EXPECT_GT(quiet, 20);
+}
+
+TEST(SeparationMonitor, Empty){
+	SeparationMonitor monitor;
+	std::vector<separation_alert> alerts(3);
+	separation_stat stat;
+	monitor.Check({}, {}, {}, alerts, stat);
+	EXPECT_TRUE(alerts.empty());
+	EXPECT_EQ(stat.num, 0);
+	EXPECT_EQ(stat.min_dist, -1);
+}
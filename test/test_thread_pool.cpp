@@ -0,0 +1,161 @@
+/**
+ * @file /test/test_thread_pool.cpp
+ *
+ * @brief Work-stealing thread pool: Parallel_For gives the same result for
+ * every pool size and grain, and visits each index exactly once.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../include/outdoor_gcs/thread_pool.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+double work(int i){
+	double v = i;
+	for (int k = 0; k < 50; k++) { v = std::sin(v) + i*0.001; }
+	return v;
+}
+
+std::vector<int> pool_sizes(){
+	return {1, 2, std::max(4, (int)std::thread::hardware_concurrency())};
+}
+
+// Runs the range through the pool, checking every index is called exactly once
+std::vector<double> run(ThreadPool &pool, int n, int grain){
+	std::vector<double> out(n, -1);
+	std::unique_ptr<std::atomic<int>[]> calls(new std::atomic<int>[std::max(n, 1)]);
+	for (int i = 0; i < n; i++) { calls[i] = 0; }
+	pool.Parallel_For(n, [&](int i){
+		calls[i]++;
+		out[i] = work(i);
+	}, grain);
+	for (int i = 0; i < n; i++) {
+		EXPECT_EQ(calls[i], 1) << "index " << i << " of " << n << " grain " << grain;
+	}
+	return out;
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(ThreadPool, Size){
+	EXPECT_EQ(ThreadPool(0).Size(), 1);
+	EXPECT_EQ(ThreadPool(1).Size(), 1);
+	EXPECT_EQ(ThreadPool(5).Size(), 5);
+}
+
+TEST(ThreadPool, SameForEveryPoolSize){
+	std::vector<double> expected;
+	for (int i = 0; i < 1000; i++) { expected.push_back(work(i)); }
+	for (int size : pool_sizes()){
+		ThreadPool pool(size);
+		for (int n : {0, 1, 2, 3, 7, 64, 1000}){
+			for (int grain : {1, 3, 16, 64}){
+				std::vector<double> out = run(pool, n, grain);
+				for (int i = 0; i < n; i++) {
+					ASSERT_EQ(out[i], expected[i]) << "pool " << size << " n " << n << " grain " << grain;
+				}
+			}
+		}
+	}
+}
+
+TEST(ThreadPool, GrainLargerThanRange){
+	// One chunk covers it all: runs inline on the caller, in order
+	for (int size : pool_sizes()){
+		ThreadPool pool(size);
+		for (int n : {1, 5, 99}){
+			std::vector<int> order;
+			std::vector<std::thread::id> ids;
+			pool.Parallel_For(n, [&](int i){
+				order.push_back(i);
+				ids.push_back(std::this_thread::get_id());
+			}, n + 1);
+			ASSERT_EQ((int)order.size(), n);
+			for (int i = 0; i < n; i++) {
+				EXPECT_EQ(order[i], i);
+				EXPECT_EQ(ids[i], std::this_thread::get_id());
+			}
+		}
+	}
+}
+
+TEST(ThreadPool, GrainBelowOne){
+	ThreadPool pool(3);
+	for (int grain : {0, -4}){
+		std::vector<double> out = run(pool, 50, grain);
+		for (int i = 0; i < 50; i++) { EXPECT_EQ(out[i], work(i)); }
+	}
+}
+
+TEST(ThreadPool, RunsOnTheWorkers){
+	// Each call holds its chunk until all are running, which needs one thread per chunk
+	ThreadPool pool(4);
+	std::atomic<int> started(0);
+	std::atomic<bool> together(true);
+	pool.Parallel_For(4, [&](int){
+		started++;
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (started < 4) {
+			if (std::chrono::steady_clock::now() > deadline){
+				together = false;
+				return;
+			}
+			std::this_thread::yield();
+		}
+	});
+	EXPECT_EQ(started, 4);
+	EXPECT_TRUE(together);
+}
+
+TEST(ThreadPool, Repeated){
+	// Back to back calls with idle workers in between, a lost wakeup would hang here
+	ThreadPool pool(3);
+	for (int k = 0; k < 2000; k++) {
+		std::atomic<int> sum(0);
+		pool.Parallel_For(k % 7 + 2, [&](int i){ sum += i + 1; });
+		int n = k % 7 + 2;
+		ASSERT_EQ(sum, n*(n+1)/2) << "call " << k;
+	}
+}
+
+TEST(ThreadPool, ConcurrentCallers){
+	// Two threads share the pool, each waits for its own range only
+	ThreadPool pool(3);
+	std::vector<double> expected;
+	for (int i = 0; i < 300; i++) { expected.push_back(work(i)); }
+	std::atomic<int> wrong(0);
+	auto caller = [&]{
+		for (int k = 0; k < 50; k++) {
+			std::vector<double> out(300, -1);
+			pool.Parallel_For(300, [&](int i){ out[i] = work(i); }, 8);
+			if (out != expected){ wrong++; }
+		}
+	};
+	std::thread a(caller), b(caller);
+	a.join();
+	b.join();
+	EXPECT_EQ(wrong, 0);
+}
@@ -0,0 +1,213 @@
+/**
+ * @file /test/test_trajectory.cpp
+ *
+ * @brief Trajectory tables: minimum jerk / snap paths through their
+ * waypoints, smooth at the joints and at rest at the ends, and the lookup.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../include/outdoor_gcs/trajectory.hpp"
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+const float Dt = 0.001;
+
+TrajectoryPoint at(const TrajectoryTable &traj, float t){
+	TrajectoryPoint ref;
+	EXPECT_TRUE(traj.Evaluate(t, ref));
+	return ref;
+}
+
+// A square of 10 m sides and a climb: segment times follow the lengths, so the joints land on samples
+std::vector<waypoint> square(){
+	return {{{0, 0, 5}}, {{10, 0, 5}}, {{10, 10, 5}}, {{0, 10, 5}}, {{0, 0, 15}}};
+}
+
+std::vector<float> joint_times(const std::vector<waypoint> &wps, float period){
+	std::vector<float> lengths, times(1, 0.0f);
+	float total = 0;
+	for (size_t k = 1; k < wps.size(); k++) {
+		float l = std::sqrt(std::pow(wps[k][0] - wps[k-1][0], 2) + std::pow(wps[k][1] - wps[k-1][1], 2) +
+				std::pow(wps[k][2] - wps[k-1][2], 2));
+		lengths.push_back(l);
+		total += l;
+	}
+	for (float l : lengths){ times.push_back(times.back() + l/total*period); }
+	return times;
+}
+
+// Largest jump of position, velocity, acceleration and jerk (by differences) across t, against
+// the same measure a few steps away where the polynomial is smooth for sure
+void jumps(const TrajectoryTable &traj, float t, float out[4]){
+	TrajectoryPoint l2 = at(traj, t - 2*Dt), l1 = at(traj, t - Dt), r1 = at(traj, t + Dt), r2 = at(traj, t + 2*Dt);
+	for (int k = 0; k < 4; k++) { out[k] = 0; }
+	for (int i = 0; i < 3; i++) {
+		out[0] = std::max(out[0], std::fabs(r1.position_ref[i] - l1.position_ref[i]));
+		out[1] = std::max(out[1], std::fabs(r1.velocity_ref[i] - l1.velocity_ref[i]));
+		out[2] = std::max(out[2], std::fabs(r1.acceleration_ref[i] - l1.acceleration_ref[i]));
+		float jerk_l = (l1.acceleration_ref[i] - l2.acceleration_ref[i])/Dt, jerk_r = (r2.acceleration_ref[i] - r1.acceleration_ref[i])/Dt;
+		out[3] = std::max(out[3], std::fabs(jerk_r - jerk_l));
+	}
+}
+
+void expect_smooth_joints(const TrajectoryTable &traj, const std::vector<waypoint> &wps, float period, bool loop){
+	std::vector<float> times = joint_times(wps, period);
+	for (size_t k = 0; k < wps.size(); k++) { // through every waypoint, at its time
+		TrajectoryPoint p = at(traj, times[k]);
+		for (int i = 0; i < 3; i++) {
+			EXPECT_NEAR(p.position_ref[i], wps[k][i], 1e-3) << "waypoint " << k;
+		}
+	}
+	for (size_t k = 1; k + (loop ? 0 : 1) < times.size(); k++) {
+		float joint[4], away[4];
+		jumps(traj, times[k], joint);
+		jumps(traj, times[k] - 0.25f, away);
+		for (int d = 0; d < 4; d++) {
+			// A step in the d-th derivative would show as its size, here every one stays at the smooth level
+			EXPECT_LT(joint[d], 3*away[d] + (d == 3 ? 0.5f : 1e-3f)) << "derivative " << d << " at joint " << k;
+		}
+	}
+}
+
+}
+
+/*****************************************************************************
+** Tests
+*****************************************************************************/
+
+TEST(Trajectory, Empty){
+	TrajectoryTable traj;
+	TrajectoryPoint ref;
+	ref.position_ref[0] = 42;
+	EXPECT_TRUE(traj.Empty());
+	EXPECT_FALSE(traj.Evaluate(1.0, ref));
+	EXPECT_EQ(ref.position_ref[0], 42); // untouched
+	EXPECT_TRUE(TrajectoryTable::MinSnap({}, 10, false).Empty());
+}
+
+TEST(Trajectory, MinJerk){
+	std::vector<waypoint> wps = square();
+	float period = 20;
+	TrajectoryTable traj = TrajectoryTable::MinJerk(wps, period, false, Dt);
+	EXPECT_NEAR(traj.Duration(), period, 1e-3);
+	expect_smooth_joints(traj, wps, period, false);
+	for (float t : {0.0f, period}){ // at rest at both ends
+		TrajectoryPoint p = at(traj, t);
+		for (int i = 0; i < 3; i++) {
+			EXPECT_NEAR(p.velocity_ref[i], 0, 1e-3) << "t " << t;
+			EXPECT_NEAR(p.acceleration_ref[i], 0, 1e-3) << "t " << t;
+		}
+	}
+}
+
+TEST(Trajectory, MinSnap){
+	std::vector<waypoint> wps = square();
+	float period = 20;
+	TrajectoryTable traj = TrajectoryTable::MinSnap(wps, period, false, Dt);
+	expect_smooth_joints(traj, wps, period, false);
+	// rest up to the jerk: it leaves and arrives slower than min-jerk does
+	TrajectoryTable jerk = TrajectoryTable::MinJerk(wps, period, false, Dt);
+	for (float t : {0.0f, period}){
+		TrajectoryPoint p = at(traj, t), q = at(traj, t + (t > 0 ? -Dt : Dt));
+		for (int i = 0; i < 3; i++) {
+			EXPECT_NEAR(p.velocity_ref[i], 0, 1e-3);
+			EXPECT_NEAR(p.acceleration_ref[i], 0, 1e-3);
+			EXPECT_NEAR((q.acceleration_ref[i] - p.acceleration_ref[i])/Dt, 0, 0.05) << "jerk at " << t;
+		}
+	}
+	EXPECT_LT(std::fabs(at(traj, 0.2).velocity_ref[0]), std::fabs(at(jerk, 0.2).velocity_ref[0]));
+}
+
+TEST(Trajectory, Loop){
+	std::vector<waypoint> wps = {{{0, 0, 5}}, {{10, 0, 5}}, {{10, 10, 8}}, {{0, 10, 5}}};
+	float period = 16;
+	for (auto build : {&TrajectoryTable::MinJerk, &TrajectoryTable::MinSnap}){
+		TrajectoryTable traj = build(wps, period, true, Dt);
+		std::vector<waypoint> closed = wps;
+		closed.push_back(wps[0]);
+		expect_smooth_joints(traj, closed, period, true);
+		float seam[4], away[4];
+		jumps(traj, 0, seam); // across the wrap
+		jumps(traj, 0.25, away);
+		for (int d = 0; d < 4; d++) {
+			EXPECT_LT(seam[d], 3*away[d] + (d == 3 ? 0.5f : 1e-3f)) << "derivative " << d << " at the seam";
+		}
+		for (float t : {0.3f, 5.0f, 13.7f}){ // wraps at the period, both ways
+			TrajectoryPoint p = at(traj, t), q = at(traj, t + period), r = at(traj, t - 3*period);
+			for (int i = 0; i < 3; i++) {
+				EXPECT_NEAR(q.position_ref[i], p.position_ref[i], 1e-3);
+				EXPECT_NEAR(r.position_ref[i], p.position_ref[i], 1e-3);
+				EXPECT_NEAR(q.velocity_ref[i], p.velocity_ref[i], 1e-3);
+			}
+			EXPECT_NEAR(q.time_from_start, t, 1e-3);
+		}
+	}
+}
+
+TEST(Trajectory, EndsClampedWithoutLoop){
+	std::vector<waypoint> wps = square();
+	TrajectoryTable traj = TrajectoryTable::MinJerk(wps, 20, false, 0.01);
+	TrajectoryPoint before = at(traj, -5), after = at(traj, 35);
+	for (int i = 0; i < 3; i++) {
+		EXPECT_NEAR(before.position_ref[i], wps.front()[i], 1e-4);
+		EXPECT_NEAR(after.position_ref[i], wps.back()[i], 1e-4);
+		EXPECT_EQ(after.velocity_ref[i], 0);
+		EXPECT_EQ(after.acceleration_ref[i], 0);
+	}
+	EXPECT_NEAR(after.time_from_start, 20, 1e-3);
+	waypoint start = traj.Start();
+	EXPECT_EQ(start[2], 5);
+}
+
+TEST(Trajectory, DerivativesMatchTheTable){
+	// The stored velocity and acceleration are those of the stored path
+	std::vector<TrajectoryTable> tables = {
+		TrajectoryTable::MinJerk(square(), 20, false, Dt),
+		TrajectoryTable::MinSnap(square(), 20, false, Dt),
+		TrajectoryTable::Circle({{1, 2, 3}}, 4, 10, Dt),
+		TrajectoryTable::Lemniscate({{1, 2, 3}}, 8, 10, Dt),
+	};
+	for (size_t k = 0; k < tables.size(); k++) {
+		for (float t = 0.5f; t < 9.5f; t += 0.37f) {
+			TrajectoryPoint l = at(tables[k], t - Dt), c = at(tables[k], t), r = at(tables[k], t + Dt);
+			for (int i = 0; i < 3; i++) {
+				EXPECT_NEAR((r.position_ref[i] - l.position_ref[i])/(2*Dt), c.velocity_ref[i], 0.02) << "table " << k << " t " << t;
+				EXPECT_NEAR((r.velocity_ref[i] - l.velocity_ref[i])/(2*Dt), c.acceleration_ref[i], 0.05) << "table " << k << " t " << t;
+			}
+		}
+	}
+}
+
+TEST(Trajectory, Lemniscate){
+	TrajectoryTable traj = TrajectoryTable::Lemniscate({{5, -3, 10}}, 8, 12);
+	float x_min = 1e9, x_max = -1e9, y_min = 1e9, y_max = -1e9;
+	for (float t = 0; t < 12; t += 0.01f) {
+		TrajectoryPoint p = at(traj, t);
+		x_min = std::min(x_min, p.position_ref[0]);
+		x_max = std::max(x_max, p.position_ref[0]);
+		y_min = std::min(y_min, p.position_ref[1]);
+		y_max = std::max(y_max, p.position_ref[1]);
+		EXPECT_NEAR(p.position_ref[2], 10, 1e-6);
+	}
+	EXPECT_NEAR(x_max - x_min, 8, 1e-2); // the given width
+	EXPECT_NEAR(y_max - y_min, 4, 1e-2);
+	for (float t : {0.0f, 6.0f, 12.0f}){ // crosses its center twice a period
+		TrajectoryPoint p = at(traj, t);
+		EXPECT_NEAR(p.position_ref[0], 5, 1e-3);
+		EXPECT_NEAR(p.position_ref[1], -3, 1e-3);
+	}
+}
@@ -0,0 +1,95 @@
+/**
+ * @file /tools/fleet_shm_dump.cpp
+ *
+ * @brief Prints the fleet state the GCS exports in shared memory (~fleet_shm),
+ * as an example reader.
+ *
+ *   fleet_shm_dump /outdoor_gcs_fleet
+ *   fleet_shm_dump /outdoor_gcs_fleet --rate 20
+ *
+ * One block per new frame: tick, then a line per uav with the health
+ * flags, odometry age, position, velocity and next planned position.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../include/outdoor_gcs/fleet_shm.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+	std::string flags(uint32_t health){
+		const char *names = "CAMRYSF"; // Fleet_Health bits in order
+		std::string out;
+		for (int b = 0; names[b]; b++) {
+			out += (health & (1u << b)) ? names[b] : '-';
+		}
+		return out;
+	}
+
+	void usage(){
+		std::cerr << "usage: fleet_shm_dump <name> [--rate Hz] [--count N]\n"
+					 "  flags: Connected Armed Moving aRrived readY Separation Fresh" << std::endl;
+	}
+
+}
+
+/*****************************************************************************
+** Main
+*****************************************************************************/
+
+int main(int argc, char **argv){
+	if (argc < 2 || argv[1][0] == '-'){ usage(); return argc < 2; }
+	std::string name = argv[1];
+	double rate = 4;
+	long count = -1;
+	for (int a = 2; a+1 < argc; a += 2) {
+		std::string key = argv[a];
+		if (key == "--rate"){ rate = std::max(0.1, std::atof(argv[a+1])); }
+		else if (key == "--count"){ count = std::atol(argv[a+1]); }
+		else{ usage(); return 1; }
+	}
+
+	FleetShmReader reader;
+	std::string error;
+	if (!reader.Open(name, error)){
+		std::cerr << error << std::endl;
+		return 1;
+	}
+	uint32_t last = 0;
+	fleet_frame f;
+	while (count != 0) {
+		if (reader.Sequence() != last && reader.Read(f)){
+			last = reader.Sequence();
+			std::printf("tick %llu, %u uavs, t %.3f\n", (unsigned long long)f.tick, f.count, f.stamp*1e-9);
+			for (uint32_t k = 0; k < f.count; k++) {
+				std::printf("  uav%-2d %s %-10s %5.2fs  pos %7.2f %7.2f %6.2f  vel %6.2f %6.2f %6.2f  nxt %7.2f %7.2f %6.2f\n",
+						f.id[k]+1, flags(f.health[k]).c_str(), f.mode[k], f.age[k], f.pos[0][k], f.pos[1][k], f.pos[2][k],
+						f.vel[0][k], f.vel[1][k], f.vel[2][k], f.nxt[0][k], f.nxt[1][k], f.nxt[2][k]);
+			}
+			std::fflush(stdout);
+			if (count > 0){ count--; }
+		}
+		std::this_thread::sleep_for(std::chrono::duration<double>(1.0/rate));
+	}
+	return 0;
+}
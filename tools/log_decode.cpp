@@ -0,0 +1,269 @@
+/**
+ * @file /tools/log_decode.cpp
+ *
+ * @brief Prints a binary diagnostics log (~binlog_file of the GCS) as text.
+ *
+ *   log_decode gcs.blog
+ *   log_decode gcs.blog --level warn --grep separation
+ *
+ * One line per entry, in the order the writer drained them (per thread in
+ * time order): wall time, level, thread, source line, formatted text.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "../include/outdoor_gcs/binlog.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+	struct log_format
+	{
+		int level = Log_Info;
+		int line = 0;
+		std::string file;
+		std::string format;
+	};
+
+	struct log_value
+	{
+		int tag = 0;
+		int64_t i = 0;
+		uint64_t u = 0;
+		double d = 0;
+		std::string s;
+	};
+
+	const char *level_names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+	template <class T>
+	bool read(std::istream &in, T &value){
+		return bool(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+	}
+
+	bool read_text(std::istream &in, std::string &text){
+		uint16_t n;
+		if (!read(in, n)){ return false; }
+		text.resize(n);
+		return n == 0 || bool(in.read(&text[0], n));
+	}
+
+	bool parse_args(const std::string &payload, std::vector<log_value> &args){
+		size_t p = 0;
+		while (p < payload.size()) {
+			log_value v;
+			v.tag = payload[p++];
+			size_t size = v.tag == Log_String ? 2 : 8;
+			if (p + size > payload.size()){ return false; }
+			if (v.tag == Log_Int){ std::memcpy(&v.i, &payload[p], 8); }
+			else if (v.tag == Log_Uint){ std::memcpy(&v.u, &payload[p], 8); }
+			else if (v.tag == Log_Double){ std::memcpy(&v.d, &payload[p], 8); }
+			else if (v.tag == Log_String){
+				uint16_t n;
+				std::memcpy(&n, &payload[p], 2);
+				if (p + 2 + n > payload.size()){ return false; }
+				v.s = payload.substr(p + 2, n);
+				size += n;
+			} else{
+				return false;
+			}
+			p += size;
+			args.push_back(v);
+		}
+		return true;
+	}
+
+	// printf with the recorded arguments; each conversion is redone for the type that was logged
+	std::string render(const std::string &format, const std::vector<log_value> &args){
+		std::string out;
+		size_t next = 0;
+		char buf[512];
+		for (size_t p = 0; p < format.size(); p++) {
+			if (format[p] != '%'){
+				out += format[p];
+				continue;
+			}
+			if (p + 1 < format.size() && format[p+1] == '%'){
+				out += '%';
+				p++;
+				continue;
+			}
+			size_t q = p + 1;
+			std::string spec = "%";
+			while (q < format.size() && std::strchr("-+ #0123456789.", format[q])) { spec += format[q++]; }
+			while (q < format.size() && std::strchr("hlLqjzt", format[q])) { q++; }
+			if (q >= format.size()){ break; }
+			char conv = format[q];
+			p = q;
+			if (next >= args.size()){
+				out += "<?>";
+				continue;
+			}
+			const log_value &v = args[next++];
+			bool real = std::strchr("feEgGaA", conv) != nullptr;
+			if (v.tag == Log_String){
+				std::snprintf(buf, sizeof(buf), (spec + "s").c_str(), v.s.c_str());
+			} else if (v.tag == Log_Double){
+				std::snprintf(buf, sizeof(buf), (spec + (real ? conv : 'g')).c_str(), v.d);
+			} else if (real){
+				std::snprintf(buf, sizeof(buf), (spec + conv).c_str(), v.tag == Log_Int ? double(v.i) : double(v.u));
+			} else if (conv == 'c'){
+				std::snprintf(buf, sizeof(buf), (spec + 'c').c_str(), int(v.tag == Log_Int ? v.i : v.u));
+			} else if (std::strchr("uxXo", conv)){
+				std::snprintf(buf, sizeof(buf), (spec + "ll" + conv).c_str(),
+						(unsigned long long)(v.tag == Log_Int ? uint64_t(v.i) : v.u));
+			} else if (v.tag == Log_Int){
+				std::snprintf(buf, sizeof(buf), (spec + "lld").c_str(), (long long)v.i);
+			} else{
+				std::snprintf(buf, sizeof(buf), (spec + "llu").c_str(), (unsigned long long)v.u);
+			}
+			out += buf;
+		}
+		return out;
+	}
+
+	bool open_log(const std::string &path, std::ifstream &in){
+		in.open(path.c_str(), std::ios::binary);
+		if (!in){
+			std::cerr << "cannot read " << path << std::endl;
+			return false;
+		}
+		char magic[sizeof(Log_Magic)];
+		uint32_t version;
+		if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, Log_Magic, sizeof(magic)) != 0 || !read(in, version)){
+			std::cerr << path << ": not a GCS binary log" << std::endl;
+			return false;
+		}
+		if (version != Log_Version){
+			std::cerr << path << ": version " << version << ", expected " << Log_Version << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	void usage(){
+		std::cerr << "usage: log_decode file.blog [--level debug|info|warn|error] [--thread N] [--grep text]" << std::endl;
+	}
+
+}
+
+/*****************************************************************************
+** Main
+*****************************************************************************/
+
+int main(int argc, char **argv){
+	if (argc < 2 || argv[1][0] == '-'){ usage(); return argc < 2; }
+	std::string path = argv[1], grep;
+	int min_level = Log_Debug, thread = -1;
+	for (int a = 2; a < argc; a++) {
+		std::string key = argv[a];
+		if (a+1 >= argc){ usage(); return 1; }
+		std::string val = argv[++a];
+		if (key == "--level"){
+			min_level = -1;
+			for (int l = 0; l < 4; l++) {
+				if (strcasecmp(val.c_str(), level_names[l]) == 0){ min_level = l; }
+			}
+			if (min_level < 0){ usage(); return 1; }
+		}
+		else if (key == "--thread"){ thread = std::atoi(val.c_str()); }
+		else if (key == "--grep"){ grep = val; }
+		else{ usage(); return 1; }
+	}
+
+	// Formats first: the writer puts them ahead of their entries, but a cut file may not
+	std::map<uint16_t, log_format> formats;
+	std::ifstream in;
+	if (!open_log(path, in)){ return 1; }
+	uint8_t type;
+	bool cut = false;
+	while (read(in, type)) {
+		if (type == Log_Format_Record){
+			uint16_t id, line;
+			uint8_t level;
+			log_format f;
+			if (!read(in, id) || !read(in, level) || !read(in, line) || !read_text(in, f.file) || !read_text(in, f.format)){
+				cut = true;
+				break;
+			}
+			f.level = level;
+			f.line = line;
+			formats[id] = f;
+		} else if (type == Log_Entry_Record){
+			in.seekg(2 + 2 + 8, std::ios::cur);
+			uint16_t n;
+			if (!read(in, n)){ cut = true; break; }
+			in.seekg(n, std::ios::cur);
+		} else{
+			cut = true;
+			break;
+		}
+	}
+	in.close();
+
+	if (!open_log(path, in)){ return 1; }
+	uint64_t entries = 0, shown = 0;
+	while (read(in, type)) {
+		if (type == Log_Format_Record){
+			uint16_t id, line;
+			uint8_t level;
+			std::string file, format;
+			if (!read(in, id) || !read(in, level) || !read(in, line) || !read_text(in, file) || !read_text(in, format)){ break; }
+			continue;
+		}
+		if (type != Log_Entry_Record){ break; }
+		uint16_t id, tid;
+		int64_t time;
+		std::string payload;
+		if (!read(in, id) || !read(in, tid) || !read(in, time) || !read_text(in, payload)){ break; }
+		entries++;
+		auto it = formats.find(id);
+		std::vector<log_value> args;
+		std::string text;
+		int level = Log_Info;
+		std::string where = "?";
+		if (it == formats.end()){
+			text = "<unknown format " + std::to_string(id) + ">";
+		} else{
+			level = it->second.level;
+			where = it->second.file + ":" + std::to_string(it->second.line);
+			text = parse_args(payload, args) ? render(it->second.format, args) : "<bad arguments>";
+		}
+		if (level < min_level || (thread >= 0 && tid != thread) || (!grep.empty() && text.find(grep) == std::string::npos)){
+			continue;
+		}
+		time_t sec = time_t(time / 1000000000);
+		struct tm local;
+		localtime_r(&sec, &local);
+		char stamp[32];
+		std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+		std::printf("%s.%06d %-5s t%-2d %-24s %s\n", stamp, int(time % 1000000000 / 1000),
+				level_names[level & 3], tid, where.c_str(), text.c_str());
+		shown++;
+	}
+	std::cerr << shown << " of " << entries << " entries, " << formats.size() << " formats" <<
+			(cut ? " (file cut short)" : "") << std::endl;
+	return 0;
+}
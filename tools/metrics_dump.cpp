@@ -0,0 +1,187 @@
+/**
+ * @file /tools/metrics_dump.cpp
+ *
+ * @brief Prints the metrics snapshot file of the GCS (~metrics_file) as text,
+ * or compares two runs.
+ *
+ *   metrics_dump run.metrics
+ *   metrics_dump run.metrics --last --grep loop
+ *   metrics_dump run.metrics --compare before.metrics
+ *
+ * A block per snapshot: wall time, then a line per series. Histograms show
+ * count, mean, p50, p99 and max in ms. Comparing puts the last snapshot of
+ * both runs side by side, counters as rates over each run so runs of
+ * different length line up.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "../include/outdoor_gcs/metrics.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+	struct metric_value
+	{
+		uint64_t count = 0; // counter value, or histogram count
+		double value = 0; // gauge value, or histogram sum
+		double p50 = 0, p99 = 0, max = 0;
+	};
+
+	struct metric_run
+	{
+		std::vector<std::string> names;
+		std::vector<uint8_t> types;
+		std::vector<double> times;
+		std::vector<std::vector<metric_value> > records;
+	};
+
+	template <class T>
+	bool read(std::istream &in, T &value){
+		return bool(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+	}
+
+	bool load(const std::string &path, metric_run &run){
+		std::ifstream in(path.c_str(), std::ios::binary);
+		if (!in){
+			std::cerr << "cannot read " << path << std::endl;
+			return false;
+		}
+		char magic[sizeof(Metrics_Magic)];
+		uint32_t version, n;
+		if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, Metrics_Magic, sizeof(magic)) != 0 ||
+				!read(in, version) || !read(in, n)){
+			std::cerr << path << ": not a GCS metrics file" << std::endl;
+			return false;
+		}
+		if (version != Metrics_Version){
+			std::cerr << path << ": version " << version << ", expected " << Metrics_Version << std::endl;
+			return false;
+		}
+		for (uint32_t k = 0; k < n; k++) {
+			uint8_t type;
+			uint16_t length;
+			std::string name;
+			if (!read(in, type) || !read(in, length)){ break; }
+			name.resize(length);
+			if (length && !in.read(&name[0], length)){ break; }
+			run.types.push_back(type);
+			run.names.push_back(name);
+		}
+		if (run.names.size() != n){
+			std::cerr << path << ": series table cut" << std::endl;
+			return false;
+		}
+		double t;
+		while (read(in, t)) {
+			std::vector<metric_value> record(n);
+			bool whole = true;
+			for (uint32_t k = 0; k < n && whole; k++) {
+				metric_value &v = record[k];
+				if (run.types[k] == Metric_Counter){ whole = read(in, v.count); }
+				else if (run.types[k] == Metric_Gauge){ whole = read(in, v.value); }
+				else{ whole = read(in, v.count) && read(in, v.value) && read(in, v.p50) && read(in, v.p99) && read(in, v.max); }
+			}
+			if (!whole){ break; } // the record being written when the run stopped
+			run.times.push_back(t);
+			run.records.push_back(record);
+		}
+		return true;
+	}
+
+	std::string show(const metric_run &run, size_t k, const metric_value &v, double span){
+		char buf[160];
+		if (run.types[k] == Metric_Counter){
+			if (span > 0){ std::snprintf(buf, sizeof(buf), "%.3f/s", v.count/span); }
+			else{ std::snprintf(buf, sizeof(buf), "%llu", (unsigned long long)v.count); }
+		} else if (run.types[k] == Metric_Gauge){
+			std::snprintf(buf, sizeof(buf), "%.6g", v.value);
+		} else{
+			std::snprintf(buf, sizeof(buf), "n %llu mean %.3f p50 %.3f p99 %.3f max %.3f ms", (unsigned long long)v.count,
+					v.count ? v.value/v.count*1e3 : 0.0, v.p50*1e3, v.p99*1e3, v.max*1e3);
+		}
+		return buf;
+	}
+
+	void usage(){
+		std::cerr << "usage: metrics_dump file.metrics [--last] [--grep text] [--compare other.metrics]" << std::endl;
+	}
+
+}
+
+/*****************************************************************************
+** Main
+*****************************************************************************/
+
+int main(int argc, char **argv){
+	if (argc < 2 || argv[1][0] == '-'){ usage(); return argc < 2; }
+	std::string path = argv[1], grep, other;
+	bool last = false;
+	for (int a = 2; a < argc; a++) {
+		std::string key = argv[a];
+		if (key == "--last"){ last = true; continue; }
+		if (a+1 >= argc){ usage(); return 1; }
+		std::string val = argv[++a];
+		if (key == "--grep"){ grep = val; }
+		else if (key == "--compare"){ other = val; }
+		else{ usage(); return 1; }
+	}
+
+	metric_run run;
+	if (!load(path, run)){ return 1; }
+	if (run.records.empty()){
+		std::cerr << path << ": no snapshots" << std::endl;
+		return 1;
+	}
+	if (other.empty()){
+		for (size_t r = last ? run.records.size()-1 : 0; r < run.records.size(); r++) {
+			std::printf("@ %.3f\n", run.times[r]);
+			for (size_t k = 0; k < run.names.size(); k++) {
+				if (!grep.empty() && run.names[k].find(grep) == std::string::npos){ continue; }
+				std::printf("%s %s\n", run.names[k].c_str(), show(run, k, run.records[r][k], 0).c_str());
+			}
+		}
+		return 0;
+	}
+
+	metric_run base;
+	if (!load(other, base)){ return 1; }
+	if (base.records.empty()){
+		std::cerr << other << ": no snapshots" << std::endl;
+		return 1;
+	}
+	double span = run.times.back() - run.times.front(), base_span = base.times.back() - base.times.front();
+	std::map<std::string, size_t> base_of;
+	for (size_t k = 0; k < base.names.size(); k++) {
+		base_of[base.names[k]] = k;
+	}
+	std::printf("# %s (%.0f s) | %s (%.0f s)\n", path.c_str(), span, other.c_str(), base_span);
+	for (size_t k = 0; k < run.names.size(); k++) {
+		if (!grep.empty() && run.names[k].find(grep) == std::string::npos){ continue; }
+		auto it = base_of.find(run.names[k]);
+		std::string theirs = it == base_of.end() || base.types[it->second] != run.types[k] ? "-" :
+				show(base, it->second, base.records.back()[it->second], base_span);
+		std::printf("%s %s | %s\n", run.names[k].c_str(), show(run, k, run.records.back()[k], span).c_str(), theirs.c_str());
+	}
+	return 0;
+}
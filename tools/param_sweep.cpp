@@ -0,0 +1,311 @@
+/**
+ * @file /tools/param_sweep.cpp
+ *
+ * @brief Headless gain sweep of the GCS planners on a simulated fleet.
+ *
+ * Every configuration flies the antipodal swap: the uavs start evenly spaced
+ * on a circle and fly to the opposite point, so all paths cross in the
+ * middle. The planner runs at the GCS loop rate on the same templates as
+ * the GCS, the uavs track its setpoints as damped double integrators.
+ *
+ *   param_sweep --planner flock2 --c1 5:20:4 --c2 5:20:4 --rho 50 --out flock.csv
+ *   param_sweep --planner orca2 --random 500 --tau 1:8 --pref_v 1:4 --threads 8
+ *
+ * A value is either fixed (x), a grid (min:max:count) or a range for random
+ * sampling (min:max). One CSV row per configuration: the gains, convergence
+ * time (all uavs within 0.25 m of their goal, -1 if never), minimum
+ * separation and RMS command jerk.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/outdoor_gcs/planners.hpp"
+#include "../include/outdoor_gcs/thread_pool.hpp"
+
+/*****************************************************************************
+** Namespaces
+*****************************************************************************/
+
+using namespace outdoor_gcs;
+
+/*****************************************************************************
+** Helpers
+*****************************************************************************/
+
+namespace {
+
+	struct sweep_range
+	{
+		float min = 0;
+		float max = 0;
+		int count = 1;
+	};
+
+	struct sim_setup
+	{
+		std::string planner = "flock2";
+		int uavs = 9;
+		float radius = 6.0; // [m] start / goal circle
+		float height = 3.0;
+		float freq = 4.0; // [Hz] planner rate
+		float duration = 60.0; // [s] longest run
+		float kp = 4.0, kd = 3.0, a_max = 5.0; // setpoint tracking of the simulated uavs
+	};
+
+	struct sim_result
+	{
+		float converge = -1;
+		float min_sep = 1e9;
+		float jerk_rms = 0;
+	};
+
+	// Gains in the order of QNode flock_param / orca_param
+	const char *flock_names[6] = {"c1", "c2", "rho", "r_alpha", "max_acc", "max_vel"};
+	const char *orca_names[4] = {"tau", "pref_v", "r", "ndist"};
+	const float flock_default[6] = {10.0, 10.0, 50.0, 3.0, 10.0, 10.0};
+	const float orca_default[4] = {5.0, 10.0, 1.0, 3.0};
+
+	bool parse_range(const std::string &text, sweep_range &r){
+		std::vector<float> v;
+		std::stringstream ss(text);
+		std::string item;
+		while (std::getline(ss, item, ':')) {
+			char *end = nullptr;
+			v.push_back(std::strtof(item.c_str(), &end));
+			if (end == item.c_str()){ return false; }
+		}
+		if (v.empty() || v.size() > 3){ return false; }
+		r.min = v[0];
+		r.max = v.size() > 1 ? v[1] : v[0];
+		r.count = v.size() > 2 ? std::max(1, int(v[2])) : (v.size() > 1 ? 2 : 1);
+		return true;
+	}
+
+	template <class Planner>
+	sim_result simulate(const Planner &planner, int dim, const sim_setup &setup){
+		const int n = setup.uavs;
+		const float sim_dt = 0.01;
+		const float plan_dt = 1.0/setup.freq;
+		const int plan_every = std::max(1, int(std::round(plan_dt/sim_dt)));
+
+		FleetSnapshot snap;
+		snap.resize(n);
+		std::vector<int> fleet(n);
+		std::vector<std::array<float,3> > goal(n), sp(n);
+		std::vector<std::array<float,3> > sp_hist[4]; // setpoints of the last 4 plans, [3] newest
+		for (int k = 0; k < n; k++) {
+			fleet[k] = k;
+			float th = 2*M_PI*k/n;
+			// A small height spread so 3D planners have something to use
+			float z = setup.height + (dim == 3 ? 0.2f*((k % 3) - 1) : 0.0f);
+			snap.pos[k] = {{setup.radius*std::cos(th), setup.radius*std::sin(th), z}};
+			snap.vel[k] = {{0, 0, 0}};
+			goal[k] = {{-snap.pos[k][0], -snap.pos[k][1], z}};
+			sp[k] = snap.pos[k];
+		}
+
+		sim_result res;
+		double jerk_sum = 0;
+		int jerk_num = 0;
+		int steps = int(setup.duration/sim_dt);
+		for (int s = 0; s < steps; s++) {
+			if (s % plan_every == 0){
+				for (int k = 0; k < n; k++) {
+					float nxt[3] = {goal[k][0], goal[k][1], goal[k][2]};
+					planner.Plan(snap, fleet, k, goal[k].data(), nxt);
+					sp[k] = {{nxt[0], nxt[1], dim == 2 ? goal[k][2] : nxt[2]}};
+				}
+				// Third difference of the setpoints over the planner period
+				for (int h = 0; h < 3; h++) { sp_hist[h].swap(sp_hist[h+1]); }
+				sp_hist[3] = sp;
+				if (!sp_hist[0].empty()){
+					for (int k = 0; k < n; k++) {
+						for (int i = 0; i < 3; i++) {
+							float j = (sp_hist[3][k][i] - 3*sp_hist[2][k][i] + 3*sp_hist[1][k][i] - sp_hist[0][k][i])/
+									  (plan_dt*plan_dt*plan_dt);
+							jerk_sum += j*j;
+							jerk_num++;
+						}
+					}
+				}
+			}
+			bool arrived = true;
+			for (int k = 0; k < n; k++) {
+				float acc2 = 0, acc[3];
+				for (int i = 0; i < 3; i++) {
+					acc[i] = setup.kp*(sp[k][i] - snap.pos[k][i]) - setup.kd*snap.vel[k][i];
+					acc2 += acc[i]*acc[i];
+				}
+				float scale = (acc2 > setup.a_max*setup.a_max) ? setup.a_max/std::sqrt(acc2) : 1.0f;
+				float err = 0;
+				for (int i = 0; i < 3; i++) {
+					snap.vel[k][i] += scale*acc[i]*sim_dt;
+					snap.pos[k][i] += snap.vel[k][i]*sim_dt;
+					err += std::pow(goal[k][i] - snap.pos[k][i], 2);
+				}
+				if (err > 0.25*0.25){ arrived = false; }
+			}
+			for (int a = 0; a < n; a++) {
+				for (int b = a+1; b < n; b++) {
+					float d = std::sqrt(std::pow(snap.pos[a][0]-snap.pos[b][0], 2) + std::pow(snap.pos[a][1]-snap.pos[b][1], 2) +
+										std::pow(snap.pos[a][2]-snap.pos[b][2], 2));
+					res.min_sep = std::min(res.min_sep, d);
+				}
+			}
+			if (arrived){
+				res.converge = (s+1)*sim_dt;
+				break;
+			}
+		}
+		res.jerk_rms = jerk_num ? std::sqrt(jerk_sum/jerk_num) : 0.0;
+		return res;
+	}
+
+	sim_result run(const std::string &planner, const std::vector<float> &gains, const sim_setup &setup){
+		float dt = 1.0/setup.freq;
+		if (planner == "flock2"){ return simulate(FlockPlanner<2>(gains.data(), dt), 2, setup); }
+		if (planner == "flock3"){ return simulate(FlockPlanner<3>(gains.data(), dt), 3, setup); }
+		if (planner == "dw3"){ return simulate(DownwashFlockPlanner<3>(gains.data(), dt, gains[6]), 3, setup); }
+		if (planner == "orca2"){ return simulate(OrcaPlanner<2>(gains.data(), dt), 2, setup); }
+		return simulate(OrcaPlanner<3>(gains.data(), dt), 3, setup);
+	}
+
+	void usage(){
+		std::cerr << "usage: param_sweep [--planner flock2|flock3|dw3|orca2|orca3] [--random N] [--seed S]\n"
+					 "                   [--threads T] [--out file.csv] [--uavs N] [--radius m] [--freq Hz] [--duration s]\n"
+					 "                   [--<gain> x | min:max:count | min:max] ...\n"
+					 "  flock / dw gains: c1 c2 rho r_alpha max_acc max_vel (dw also: z_scale)\n"
+					 "  orca gains:       tau pref_v r ndist" << std::endl;
+	}
+
+}
+
+/*****************************************************************************
+** Main
+*****************************************************************************/
+
+int main(int argc, char **argv){
+	sim_setup setup;
+	int random = 0;
+	unsigned seed = 1;
+	int threads = std::max(1u, std::thread::hardware_concurrency());
+	std::string out_path;
+	std::map<std::string, sweep_range> ranges;
+
+	for (int a = 1; a < argc; a++) {
+		std::string key = argv[a];
+		if (key == "-h" || key == "--help"){ usage(); return 0; }
+		if (key.compare(0, 2, "--") != 0 || a+1 >= argc){ usage(); return 1; }
+		key = key.substr(2);
+		std::string val = argv[++a];
+		if (key == "planner"){ setup.planner = val; }
+		else if (key == "random"){ random = std::atoi(val.c_str()); }
+		else if (key == "seed"){ seed = std::atoi(val.c_str()); }
+		else if (key == "threads"){ threads = std::max(1, std::atoi(val.c_str())); }
+		else if (key == "out"){ out_path = val; }
+		else if (key == "uavs"){ setup.uavs = std::max(2, std::atoi(val.c_str())); }
+		else if (key == "radius"){ setup.radius = std::atof(val.c_str()); }
+		else if (key == "freq"){ setup.freq = std::atof(val.c_str()); }
+		else if (key == "duration"){ setup.duration = std::atof(val.c_str()); }
+		else{
+			sweep_range r;
+			if (!parse_range(val, r)){ std::cerr << "bad value for --" << key << ": " << val << std::endl; return 1; }
+			ranges[key] = r;
+		}
+	}
+
+	const char *planners[5] = {"flock2", "flock3", "dw3", "orca2", "orca3"};
+	if (std::find(planners, planners+5, setup.planner) == planners+5){
+		std::cerr << "unknown planner: " << setup.planner << std::endl;
+		usage();
+		return 1;
+	}
+	bool orca = setup.planner.compare(0, 4, "orca") == 0;
+	bool dw = setup.planner.compare(0, 2, "dw") == 0;
+	std::vector<std::string> names;
+	std::vector<float> defaults;
+	if (orca){
+		names.assign(orca_names, orca_names+4);
+		defaults.assign(orca_default, orca_default+4);
+	} else{
+		names.assign(flock_names, flock_names+6);
+		defaults.assign(flock_default, flock_default+6);
+		if (dw){
+			names.push_back("z_scale");
+			defaults.push_back(2.0);
+		}
+	}
+	for (const auto &r : ranges){
+		if (std::find(names.begin(), names.end(), r.first) == names.end()){
+			std::cerr << "unknown gain for " << setup.planner << ": " << r.first << std::endl;
+			return 1;
+		}
+	}
+
+	// Configurations: the full grid, or uniform samples within the ranges
+	std::vector<std::vector<float> > configs;
+	if (random > 0){
+		std::mt19937 rng(seed);
+		for (int c = 0; c < random; c++) {
+			std::vector<float> g = defaults;
+			for (size_t i = 0; i < names.size(); i++) {
+				auto it = ranges.find(names[i]);
+				if (it == ranges.end()){ continue; }
+				std::uniform_real_distribution<float> dist(it->second.min, it->second.max);
+				g[i] = dist(rng);
+			}
+			configs.push_back(g);
+		}
+	} else{
+		configs.push_back(defaults);
+		for (size_t i = 0; i < names.size(); i++) {
+			auto it = ranges.find(names[i]);
+			if (it == ranges.end()){ continue; }
+			const sweep_range &r = it->second;
+			std::vector<std::vector<float> > next;
+			for (const auto &g : configs){
+				for (int k = 0; k < r.count; k++) {
+					std::vector<float> h = g;
+					h[i] = (r.count > 1) ? r.min + (r.max - r.min)*k/(r.count - 1) : r.min;
+					next.push_back(h);
+				}
+			}
+			configs.swap(next);
+		}
+	}
+
+	std::vector<sim_result> results(configs.size());
+	ThreadPool pool(threads);
+	pool.Parallel_For(configs.size(), [&](int c){ results[c] = run(setup.planner, configs[c], setup); });
+
+	std::ofstream file;
+	if (!out_path.empty()){
+		file.open(out_path.c_str());
+		if (!file){ std::cerr << "cannot write " << out_path << std::endl; return 1; }
+	}
+	std::ostream &out = out_path.empty() ? std::cout : file;
+	for (const auto &name : names){ out << name << ","; }
+	out << "converge_s,min_separation_m,jerk_rms\n";
+	for (size_t c = 0; c < configs.size(); c++) {
+		for (const auto &g : configs[c]){ out << g << ","; }
+		out << results[c].converge << "," << results[c].min_sep << "," << results[c].jerk_rms << "\n";
+	}
+	std::cerr << configs.size() << " configurations of " << setup.planner << " on " << pool.Size() << " threads" << std::endl;
+	return 0;
+}
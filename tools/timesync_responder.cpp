@@ -0,0 +1,51 @@
+/**
+ * @file /tools/timesync_responder.cpp
+ *
+ * @brief Answers the clock sync requests of the GCS with the vehicle clock.
+ *
+ * Runs on the computer of each vehicle, in its namespace:
+ *
+ *   ROS_NAMESPACE=uav1 rosrun outdoor_gcs timesync_responder
+ *
+ * As a local stand-in for tests, ~offset [s] and ~drift [s/s] are added to
+ * the clock it reports, which the GCS should then estimate.
+ *
+ * @date October 2026
+ **/
+
+/*****************************************************************************
+** Includes
+*****************************************************************************/
+
+#include <ros/ros.h>
+#include <outdoor_gcs/TimeSync.h>
+
+/*****************************************************************************
+** Main
+*****************************************************************************/
+
+int main(int argc, char **argv){
+	ros::init(argc, argv, "timesync_responder");
+	ros::NodeHandle n;
+	ros::NodeHandle nh("~");
+	double offset, drift;
+	nh.param<double>("offset", offset, 0.0);
+	nh.param<double>("drift", drift, 0.0);
+
+	ros::Time start = ros::Time::now();
+	auto vehicle_now = [&](){
+		ros::Time t = ros::Time::now();
+		return t + ros::Duration(offset + drift*(t - start).toSec());
+	};
+	ros::Publisher response_pub = n.advertise<outdoor_gcs::TimeSync>("timesync/response", 10);
+	ros::Subscriber request_sub = n.subscribe<outdoor_gcs::TimeSync>("timesync/request", 10,
+			[&](const outdoor_gcs::TimeSync::ConstPtr &msg){
+		outdoor_gcs::TimeSync response = *msg;
+		response.vehicle_receive = vehicle_now();
+		response.vehicle_send = vehicle_now();
+		response_pub.publish(response);
+	});
+	ROS_INFO("Answering %s", request_sub.getTopic().c_str());
+	ros::spin();
+	return 0;
+}